@@ -33,7 +33,7 @@ using base_class = SimpleRequestHandler<ArithRequestHandler, ArithOp, 1>;
 class ArithRequestHandler : public base_class {
 public:
     explicit ArithRequestHandler() : base_class() {
-        add_operation(CALC, &ArithRequestHandler::calc);
+        add_operation<&ArithRequestHandler::calc>(CALC);
     }
 
     void calc(GateIStream &is) {
@@ -52,5 +52,9 @@ int main(int argc, char **argv) {
 
         cout << "Write time: " << (end - start) << " cycles\n";
     }
+
+    FileInfo info;
+    if(VFS::stat(argv[1], info) == Errors::NONE)
+        cout << "Extents: " << info.extents << "\n";
     return 0;
 }
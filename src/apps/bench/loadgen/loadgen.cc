@@ -73,11 +73,10 @@ public:
     explicit ReqHandler()
         : base_class_t(),
           _rgate(RecvGate::create(nextlog2<32 * MSG_SIZE>::val, nextlog2<MSG_SIZE>::val)) {
-        add_operation(LoadGen::START, &ReqHandler::start);
-        add_operation(LoadGen::RESPONSE, &ReqHandler::response);
+        add_operation<&ReqHandler::start>(LoadGen::START);
+        add_operation<&ReqHandler::response>(LoadGen::RESPONSE);
 
-        using std::placeholders::_1;
-        _rgate.start(std::bind(&ReqHandler::handle_message, this, _1));
+        _rgate.start<base_class_t, &base_class_t::handle_message>(this);
     }
 
     virtual Errors::Code open(LoadGenSession **sess, capsel_t srv_sel, word_t) override {
@@ -101,6 +101,8 @@ int main() {
     cout << "Duration: " << duration << "\n";
     cout << "Rate: " << static_cast<float>(received_bytes) / duration << " bytes / cycle\n";
     cout << "Rate: " << static_cast<float>(received_bytes) / (duration / 3e9f) << " bytes / s\n";
+    cout << "Rate: " << static_cast<float>(packet_received_count) / (duration / 1e6f)
+         << " packets / Mcycle\n";
 
     socket->close();
     delete socket;
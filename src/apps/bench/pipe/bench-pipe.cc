@@ -89,9 +89,11 @@ static void parent_to_child(const char *name, VPE &reader, PIPE &pipe) {
 
 int main(int argc, char **argv) {
     bool direct = true;
+    bool ring = true;
     bool indirect = true;
     if(argc > 1) {
         direct = strcmp(argv[1], "direct") == 0;
+        ring = strcmp(argv[1], "ring") == 0;
         indirect = strcmp(argv[1], "indirect") == 0;
     }
 
@@ -111,6 +113,20 @@ int main(int argc, char **argv) {
         }
     }
 
+    if(ring) {
+        {
+            VPE writer("writer");
+            DirectPipe pipe(VPE::self(), writer, mem, MEM_SIZE, DirectPipe::RING);
+            child_to_parent(" ring:c->p", writer, pipe);
+        }
+
+        {
+            VPE reader("reader");
+            DirectPipe pipe(reader, VPE::self(), mem, MEM_SIZE, DirectPipe::RING);
+            parent_to_child(" ring:p->c", reader, pipe);
+        }
+    }
+
     if(indirect) {
         {
             VPE writer("writer");
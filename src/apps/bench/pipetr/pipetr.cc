@@ -14,10 +14,13 @@
  * General Public License version 2 for more details.
  */
 
+#include <base/stream/IStringStream.h>
+#include <base/stream/OStringStream.h>
 #include <base/util/Time.h>
 
 #include <m3/stream/Standard.h>
 #include <m3/pipe/DirectPipe.h>
+#include <m3/pipe/IndirectPipe.h>
 #include <m3/vfs/FileRef.h>
 
 using namespace m3;
@@ -37,9 +40,92 @@ NOINLINE void replace(char *buffer, long res, char c1, char c2) {
     }
 }
 
+static int transform(File *in, const char *out, char c1, char c2) {
+    FileRef output(out, FILE_W | FILE_CREATE | FILE_TRUNC);
+    if(Errors::occurred())
+        exitmsg("open of " << out << " failed");
+
+    ssize_t res;
+    while((res = in->read(buffer, sizeof(buffer))) > 0) {
+        replace(buffer, res, c1, c2);
+        output->write(buffer, static_cast<size_t>(res));
+    }
+    return 0;
+}
+
+static void run_multi(char **argv, size_t writers, size_t readers) {
+    cycles_t start = Time::start(0);
+
+    MemGate mem = MemGate::create_global(MEM_SIZE, MemGate::RW);
+    IndirectPipe pipe(mem, MEM_SIZE);
+
+    // all writers produce into the same pipe
+    VPE **wvpes = new VPE*[writers];
+    for(size_t i = 0; i < writers; ++i) {
+        wvpes[i] = new VPE("writer");
+        wvpes[i]->mounts(*VPE::self().mounts());
+        wvpes[i]->obtain_mounts();
+        wvpes[i]->fds()->set(STDOUT_FD, VPE::self().fds()->get(pipe.writer_fd()));
+        wvpes[i]->obtain_fds();
+
+        wvpes[i]->run([argv] {
+            FileRef input(argv[1], FILE_R);
+            if(Errors::occurred())
+                exitmsg("open of " << argv[1] << " failed");
+
+            ssize_t res;
+            File *out = VPE::self().fds()->get(STDOUT_FD);
+            while((res = input->read(buffer, sizeof(buffer))) > 0)
+                out->write_all(buffer, static_cast<size_t>(res));
+            return 0;
+        });
+    }
+
+    // the readers share the work; each one writes its part to <out>-<i>
+    VPE **rvpes = new VPE*[readers];
+    for(size_t i = 0; i < readers; ++i) {
+        rvpes[i] = new VPE("reader");
+        rvpes[i]->mounts(*VPE::self().mounts());
+        rvpes[i]->obtain_mounts();
+        rvpes[i]->fds()->set(STDIN_FD, VPE::self().fds()->get(pipe.reader_fd()));
+        rvpes[i]->obtain_fds();
+
+        rvpes[i]->run([argv, i] {
+            OStringStream out;
+            out << argv[2] << "-" << i;
+            return transform(VPE::self().fds()->get(STDIN_FD), out.str(), argv[3][0], argv[4][0]);
+        });
+    }
+
+    pipe.close_writer();
+    pipe.close_reader();
+
+    for(size_t i = 0; i < writers; ++i) {
+        wvpes[i]->wait();
+        delete wvpes[i];
+    }
+    for(size_t i = 0; i < readers; ++i) {
+        rvpes[i]->wait();
+        delete rvpes[i];
+    }
+    delete[] wvpes;
+    delete[] rvpes;
+
+    cycles_t end = Time::stop(0);
+    cout << "Total time (" << writers << " writers, " << readers << " readers): ";
+    cout << (end - start) << " cycles\n";
+}
+
 int main(int argc, char **argv) {
     if(argc < 5)
-        exitmsg("Usage: " << argv[0] << " <in> <out> <s> <r>");
+        exitmsg("Usage: " << argv[0] << " <in> <out> <s> <r> [<writers> <readers>]");
+
+    if(argc > 6) {
+        size_t writers = IStringStream::read_from<size_t>(argv[5]);
+        size_t readers = IStringStream::read_from<size_t>(argv[6]);
+        run_multi(argv, writers, readers);
+        return 0;
+    }
 
     cycles_t apptime = 0;
     cycles_t start = Time::start(0);
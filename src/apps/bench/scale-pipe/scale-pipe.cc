@@ -21,6 +21,7 @@
 
 #include <m3/server/RemoteServer.h>
 #include <m3/stream/Standard.h>
+#include <m3/pipe/DirectPipe.h>
 #include <m3/pipe/IndirectPipe.h>
 #include <m3/vfs/Dir.h>
 #include <m3/vfs/VFS.h>
@@ -52,8 +53,8 @@ struct App {
 };
 
 int main(int argc, char **argv) {
-    if(argc != 7) {
-        cerr << "Usage: " << argv[0] << " <wrname> <rdname> <repeats> <data> <muxed> <instances>\n";
+    if(argc != 7 && argc != 8) {
+        cerr << "Usage: " << argv[0] << " <wrname> <rdname> <repeats> <data> <muxed> <instances> [<ring>]\n";
         return 1;
     }
 
@@ -68,6 +69,10 @@ int main(int argc, char **argv) {
     bool data = strcmp(argv[4], "1") == 0;
     bool muxed = strcmp(argv[5], "1") == 0;
     size_t instances = IStringStream::read_from<size_t>(argv[6]);
+    // the ring mode of DirectPipe always transfers the data, so it can't be combined with NODATA
+    bool ring = argc > 7 && strcmp(argv[7], "1") == 0;
+    if(ring && !data)
+        exitmsg("The ring mode requires <data> = 1");
 
     App *apps[instances * 2];
     RemoteServer *srvs[3];
@@ -128,6 +133,7 @@ int main(int argc, char **argv) {
         constexpr size_t PIPE_SHM_SIZE   = 512 * 1024;
         MemGate *mems[instances];
         IndirectPipe *pipes[instances];
+        DirectPipe *dpipes[instances];
 
         for(size_t i = 0; i < instances * 2; ++i) {
             OStringStream tmpdir(new char[16], 16);
@@ -156,11 +162,22 @@ int main(int argc, char **argv) {
 
             if(i % 2 == 0) {
                 mems[i / 2] = new MemGate(MemGate::create_global(PIPE_SHM_SIZE, MemGate::RW));
-                pipes[i / 2] = new IndirectPipe(*mems[i / 2], PIPE_SHM_SIZE, "mypipe", data ? 0 : FILE_NODATA);
-                apps[i]->vpe.fds()->set(STDOUT_FD, VPE::self().fds()->get(pipes[i / 2]->writer_fd()));
+                if(ring) {
+                    pipes[i / 2] = nullptr;
+                    dpipes[i / 2] = new DirectPipe(apps[i + 1]->vpe, apps[i]->vpe, *mems[i / 2],
+                                                   PIPE_SHM_SIZE, DirectPipe::RING);
+                }
+                else {
+                    pipes[i / 2] = new IndirectPipe(*mems[i / 2], PIPE_SHM_SIZE, "mypipe", data ? 0 : FILE_NODATA);
+                    dpipes[i / 2] = nullptr;
+                }
+                fd_t wrfd = ring ? dpipes[i / 2]->writer_fd() : pipes[i / 2]->writer_fd();
+                apps[i]->vpe.fds()->set(STDOUT_FD, VPE::self().fds()->get(wrfd));
+            }
+            else {
+                fd_t rdfd = ring ? dpipes[i / 2]->reader_fd() : pipes[i / 2]->reader_fd();
+                apps[i]->vpe.fds()->set(STDIN_FD, VPE::self().fds()->get(rdfd));
             }
-            else
-                apps[i]->vpe.fds()->set(STDIN_FD, VPE::self().fds()->get(pipes[i / 2]->reader_fd()));
             apps[i]->vpe.obtain_fds();
 
             Errors::Code res = apps[i]->vpe.exec(apps[i]->argc, apps[i]->argv);
@@ -168,8 +185,14 @@ int main(int argc, char **argv) {
                 PANIC("Cannot execute " << apps[i]->argv[0] << ": " << Errors::to_string(res));
 
             if(i % 2 == 1) {
-                pipes[i / 2]->close_writer();
-                pipes[i / 2]->close_reader();
+                if(ring) {
+                    dpipes[i / 2]->close_writer();
+                    dpipes[i / 2]->close_reader();
+                }
+                else {
+                    pipes[i / 2]->close_writer();
+                    pipes[i / 2]->close_reader();
+                }
             }
         }
 
@@ -199,6 +222,8 @@ int main(int argc, char **argv) {
         for(size_t i = 0; i < instances * 2; ++i) {
             delete pipes[i / 2];
             pipes[i / 2] = nullptr;
+            delete dpipes[i / 2];
+            dpipes[i / 2] = nullptr;
             delete mems[i / 2];
             mems[i / 2] = nullptr;
             delete apps[i];
@@ -14,19 +14,19 @@
  * General Public License version 2 for more details.
  */
 
+#include <base/stream/IStringStream.h>
 #include <base/util/Time.h>
 
 #include <m3/session/ClientSession.h>
 #include <m3/stream/Standard.h>
 #include <m3/Syscalls.h>
+#include <m3/VPE.h>
 
 using namespace m3;
 
 static const uint COUNT = 32;
 
-int main() {
-    Syscalls::get().noop();
-
+static cycles_t create_sessions() {
     cycles_t total = 0;
 
     for(uint i = 0; i < COUNT; ++i) {
@@ -35,7 +35,44 @@ int main() {
         cycles_t end = Time::stop(0x1234);
         total += end - begin;
     }
+    return total;
+}
+
+static void run_parallel(size_t clients) {
+    VPE *vpes[clients];
+    for(size_t i = 0; i < clients; ++i)
+        vpes[i] = new VPE("client");
+
+    // let all clients open their sessions at once to keep the kernel's requests to the service in
+    // flight concurrently
+    cycles_t begin = Time::start(0x1235);
+    for(size_t i = 0; i < clients; ++i) {
+        vpes[i]->run([] {
+            create_sessions();
+            return 0;
+        });
+    }
+
+    for(size_t i = 0; i < clients; ++i) {
+        vpes[i]->wait();
+        delete vpes[i];
+    }
+    cycles_t end = Time::stop(0x1235);
+
+    cout << "Per session creation with " << clients << " clients: "
+         << ((end - begin) / (COUNT * clients)) << " cycles\n";
+}
+
+int main(int argc, char **argv) {
+    Syscalls::get().noop();
+
+    size_t clients = argc > 1 ? IStringStream::read_from<size_t>(argv[1]) : 1;
+    if(clients > 1) {
+        run_parallel(clients);
+        return 0;
+    }
 
+    cycles_t total = create_sessions();
     cout << "Per session creation: " << (total / COUNT) << " cycles\n";
     return 0;
 }
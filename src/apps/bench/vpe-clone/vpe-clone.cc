@@ -23,6 +23,7 @@
 #include <m3/vfs/File.h>
 #include <m3/vfs/VFS.h>
 #include <m3/VPE.h>
+#include <m3/VPEPool.h>
 
 using namespace m3;
 
@@ -34,32 +35,45 @@ using namespace m3;
 
 USED static char dummy[DUMMY_BUF_SIZE] = {'a'};
 
-int main(int argc, char **) {
-    // for the exec benchmark
-    if(argc > 1) {
-        Time::stop(1);
-        return 0;
-    }
-
-    memset(dummy, 0, sizeof(dummy));
-
+static cycles_t clone(uint flags) {
     cycles_t exec_time = 0;
 
+    // create the VPEs in advance to measure only the clone. use a pager, because SHARE_TEXT maps
+    // the text via the pager
+    VPEPool pool("hello", 1, VPE::self().pe(), "pager", flags);
     for(int i = 0; i < COUNT; ++i) {
         cycles_t start2 = Time::start(1);
 
-        VPE vpe("hello");
-        Errors::Code res = vpe.run([start2]() {
+        VPE *vpe = pool.acquire();
+        if(!vpe)
+            exitmsg("Unable to create VPE");
+        Errors::Code res = vpe->run([start2]() {
             cycles_t end = Time::stop(1);
             return end - start2;
         });
         if(res != Errors::NONE)
             exitmsg("VPE::run failed");
 
-        int time = vpe.wait();
+        int time = vpe->wait();
         exec_time += static_cast<cycles_t>(time);
+
+        delete vpe;
+        pool.refill();
     }
 
-    cout << "Time for clone: " << (exec_time / COUNT) << " cycles\n";
+    return exec_time / COUNT;
+}
+
+int main(int argc, char **) {
+    // for the exec benchmark
+    if(argc > 1) {
+        Time::stop(1);
+        return 0;
+    }
+
+    memset(dummy, 0, sizeof(dummy));
+
+    cout << "Time for clone: " << clone(0) << " cycles\n";
+    cout << "Time for clone with shared text: " << clone(VPE::SHARE_TEXT) << " cycles\n";
     return 0;
 }
@@ -24,6 +24,7 @@
 #include <m3/vfs/File.h>
 #include <m3/vfs/VFS.h>
 #include <m3/VPE.h>
+#include <m3/VPEPool.h>
 
 using namespace m3;
 
@@ -36,18 +37,32 @@ int main(int argc, char **argv) {
     OStringStream os;
     os << "/bin/bench-vpe-clone-" << argv[1];
 
+    // create the VPEs in advance to measure only the exec
+    VPEPool pool("hello", 1);
+    cycles_t exec_time = 0;
     for(int i = 0; i < COUNT; ++i) {
-        Time::start(1);
+        cycles_t start = Time::start(1);
 
-        VPE vpe("hello");
+        VPE *vpe = pool.acquire();
+        if(!vpe)
+            exitmsg("Unable to create VPE");
         const char *args[] = {os.str(), "dummy"};
-        Errors::Code res = vpe.exec(ARRAY_SIZE(args), args);
+        Errors::Code res = vpe->exec(ARRAY_SIZE(args), args);
         if(res != Errors::NONE)
             exitmsg("VPE::exec failed");
 
-        vpe.wait();
+        vpe->wait();
+        cycles_t end = Time::stop(1);
+        exec_time += end - start;
+
+        delete vpe;
+        pool.refill();
     }
 
-    cout << "Time for exec: 0 cycles\n";
+    cout << "Time for exec: " << (exec_time / COUNT) << " cycles\n";
+#if defined(__host__)
+    const VPE::ExecCacheStats &stats = VPE::exec_cache_stats();
+    cout << "Exec cache: " << stats.hits << " hits, " << stats.misses << " misses\n";
+#endif
     return 0;
 }
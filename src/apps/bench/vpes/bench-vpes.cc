@@ -23,6 +23,7 @@
 #include <m3/vfs/File.h>
 #include <m3/vfs/VFS.h>
 #include <m3/VPE.h>
+#include <m3/VPEPool.h>
 
 using namespace m3;
 
@@ -103,6 +104,32 @@ int main() {
 
     exec_time = 0;
 
+    {
+        VPEPool pool("hello", 1);
+        for(int i = 0; i < COUNT; ++i) {
+            cycles_t start = Time::start(5);
+            VPE *vpe = pool.acquire();
+            if(!vpe)
+                exitmsg("Unable to create VPE");
+            Errors::Code res = vpe->run([]() {
+                return 0;
+            });
+            if(res != Errors::NONE)
+                exitmsg("VPE::run failed");
+
+            vpe->wait();
+            cycles_t end = Time::stop(5);
+            exec_time += end - start;
+
+            delete vpe;
+            pool.refill();
+        }
+    }
+
+    cout << "Time for pooled run+wait: " << (exec_time / COUNT) << " cycles\n";
+
+    exec_time = 0;
+
     {
         for(int i = 0; i < COUNT; ++i) {
             VPE vpe("hello");
@@ -32,7 +32,7 @@ static Server<TestRequestHandler> *srv;
 class TestRequestHandler : public base_class {
 public:
     explicit TestRequestHandler() : base_class() {
-        add_operation(TEST, &TestRequestHandler::test);
+        add_operation<&TestRequestHandler::test>(TEST);
     }
 
     void test(GateIStream &is) {
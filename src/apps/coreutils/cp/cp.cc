@@ -22,7 +22,30 @@ using namespace m3;
 
 alignas(64) static char buffer[4096];
 
+static bool copy_in_fs(const char *src, const char *dst) {
+    // the filesystem appends to <dst>, so create or truncate it first
+    {
+        FStream out(dst, FILE_W | FILE_CREATE | FILE_TRUNC);
+        if(out.error())
+            return false;
+    }
+
+    size_t off = 0;
+    while(true) {
+        size_t count = static_cast<size_t>(-1);
+        if(VFS::copy_range(src, dst, off, &count) != Errors::NONE)
+            return false;
+        if(count == 0)
+            return true;
+        off += count;
+    }
+}
+
 static void copy(const char *src, const char *dst) {
+    // let the filesystem copy the data, if possible
+    if(copy_in_fs(src, dst))
+        return;
+
     FStream out(dst, FILE_W | FILE_CREATE | FILE_TRUNC);
     if(out.error()) {
         errmsg("Opening/creating " << dst << " for writing failed");
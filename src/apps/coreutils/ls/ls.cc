@@ -65,7 +65,6 @@ static bool compareEntries(const LSFile &a,const LSFile &b) {
 }
 
 int main(int argc, char **argv) {
-    char path[256];
     if(argc < 2)
         exitmsg("Usage: " << argv[0] << " [-ila] <path>");
 
@@ -104,25 +103,24 @@ int main(int argc, char **argv) {
     if(Errors::occurred())
         exitmsg("open of " << dirname << " failed");
 
-    // count entries
+    // collect entries and file info at once
+    size_t total = 0, size = 16;
+    LSFile *files = new LSFile[size];
     Dir::Entry e;
-    size_t total;
-    for(total = 0; dir.readdir(e); ) {
-        if(showall || e.name[0] != '.')
-            total++;
-    }
-
-    // collect file info
-    LSFile *files = new LSFile[total];
-    dir.reset();
-    for(size_t i = 0; dir.readdir(e); ) {
+    FileInfo einfo;
+    while(dir.readdir(e, einfo)) {
         if(showall || e.name[0] != '.') {
-            OStringStream os(path, sizeof(path));
-            os << dirname << "/" << e.name;
-            VFS::stat(os.str(), files[i].info);
-            strncpy(files[i].name, e.name, sizeof(files[i].name));
-            files[i].name[sizeof(files[i].name) - 1] = '\0';
-            i++;
+            if(total == size) {
+                LSFile *nfiles = new LSFile[size * 2];
+                memcpy(nfiles, files, sizeof(LSFile) * size);
+                delete[] files;
+                files = nfiles;
+                size *= 2;
+            }
+            files[total].info = einfo;
+            strncpy(files[total].name, e.name, sizeof(files[total].name));
+            files[total].name[sizeof(files[total].name) - 1] = '\0';
+            total++;
         }
     }
 
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+#include <m3/stream/FStream.h>
+#include <m3/stream/Standard.h>
+#include <m3/vfs/VFS.h>
+
+using namespace m3;
+
+static const size_t BUF_SIZE = 8192;
+
+int main(int argc, char **argv) {
+    File **outs = new File*[argc];
+    FStream **files = new FStream*[argc]();
+    size_t count = 0;
+
+    outs[count++] = cout.file();
+    for(int i = 1; i < argc; ++i) {
+        files[i] = new FStream(argv[i], FILE_W | FILE_CREATE | FILE_TRUNC);
+        if(Errors::occurred()) {
+            delete files[i];
+            files[i] = nullptr;
+            errmsg("Open of " << argv[i] << " failed");
+            continue;
+        }
+
+        outs[count++] = files[i]->file();
+    }
+
+    // read every part of the input once and hand it to all outputs
+    while(cin.file()->tee(outs, count, BUF_SIZE) > 0)
+        ;
+
+    for(int i = 1; i < argc; ++i)
+        delete files[i];
+    delete[] files;
+    delete[] outs;
+    return 0;
+}
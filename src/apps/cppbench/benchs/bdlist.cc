@@ -51,7 +51,9 @@ NOINLINE static void append() {
 
     Profile pr(30);
     DListAppendRunner runner;
-    cout << "100-elements: " << pr.runner_with_id(runner, 0x20) << "\n";
+    Results res = pr.runner_with_id(runner, 0x20);
+    cout << "100-elements: " << res << "\n";
+    cout << res.json("dlist_append") << "\n";
 }
 
 NOINLINE static void clear() {
@@ -73,7 +75,9 @@ NOINLINE static void clear() {
 
     Profile pr(30);
     DListClearRunner runner;
-    cout << "100-elements: " << pr.runner_with_id(runner, 0x21) << "\n";
+    Results res = pr.runner_with_id(runner, 0x21);
+    cout << "100-elements: " << res << "\n";
+    cout << res.json("dlist_clear") << "\n";
 }
 
 void bdlist() {
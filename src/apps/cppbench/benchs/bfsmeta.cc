@@ -29,17 +29,21 @@ using namespace m3;
 NOINLINE static void stat() {
     Profile pr(32, 4);
 
-    cout << "Stat in root dir: " << pr.run_with_id([] {
+    Results res_root = pr.run_with_id([] {
         FileInfo info;
         if(VFS::stat("/large.txt", info) != Errors::NONE)
             PANIC("stat for /large.txt failed");
-    }, 0x80) << "\n";
+    }, 0x80);
+    cout << "Stat in root dir: " << res_root << "\n";
+    cout << res_root.json("fsmeta_stat_root") << "\n";
 
-    cout << "Stat in sub dir: " << pr.run_with_id([] {
+    Results res_sub = pr.run_with_id([] {
         FileInfo info;
         if(VFS::stat("/finddata/dir/dir-1/32.txt", info) != Errors::NONE)
             PANIC("stat for /finddata/dir/dir-1/32.txt failed");
-    }, 0x81) << "\n";
+    }, 0x81);
+    cout << "Stat in sub dir: " << res_sub << "\n";
+    cout << res_sub.json("fsmeta_stat_sub") << "\n";
 }
 
 void bfsmeta() {
@@ -33,8 +33,8 @@ alignas(64) static char buf[8192];
 NOINLINE static void read() {
     MemGate mgate = MemGate::create_global(8192, MemGate::R);
 
-    Profile pr(2, 1);;
-    cout << "2 MiB with 8K buf: " << pr.run_with_id([&mgate] {
+    Profile pr(2, 1);
+    Results res = pr.run_with_id([&mgate] {
         size_t total = 0;
         while(total < SIZE) {
             mgate.read(buf, sizeof(buf), 0);
@@ -42,14 +42,16 @@ NOINLINE static void read() {
                 PANIC("read failed");
             total += sizeof(buf);
         }
-    }, 0x40) << "\n";
+    }, 0x40);
+    cout << "2 MiB with 8K buf: " << res << "\n";
+    cout << res.json("memgate_read", sizeof(buf), SIZE) << "\n";
 }
 
 NOINLINE static void write() {
     MemGate mgate = MemGate::create_global(8192, MemGate::W);
 
     Profile pr(2, 1);
-    cout << "2 MiB with 8K buf: " << pr.run_with_id([&mgate] {
+    Results res = pr.run_with_id([&mgate] {
         size_t total = 0;
         while(total < SIZE) {
             mgate.write(buf, sizeof(buf), 0);
@@ -57,10 +59,25 @@ NOINLINE static void write() {
                 PANIC("write failed");
             total += sizeof(buf);
         }
-    }, 0x41) << "\n";
+    }, 0x41);
+    cout << "2 MiB with 8K buf: " << res << "\n";
+    cout << res.json("memgate_write", sizeof(buf), SIZE) << "\n";
+}
+
+NOINLINE static void read_sizes() {
+    MemGate mgate = MemGate::create_global(8192, MemGate::R);
+
+    const size_t sizes[] = {64, 256, 1024, 4096, 8192};
+    Profile pr(50, 5);
+    pr.sweep(cout, "memgate_read_size", sizes, ARRAY_SIZE(sizes), [&mgate](size_t size) {
+        mgate.read(buf, size, 0);
+        if(Errors::occurred())
+            PANIC("read failed");
+    }, 0x42, true);
 }
 
 void bmemgate() {
     RUN_BENCH(read);
     RUN_BENCH(write);
+    RUN_BENCH(read_sizes);
 }
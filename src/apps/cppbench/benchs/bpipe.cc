@@ -67,6 +67,7 @@ NOINLINE void child_to_parent() {
 
     cout << "c->p: " << (DATA_SIZE / 1024) << " KiB transfer with "
          << (BUF_SIZE / 1024) << " KiB buf: " << res << "\n";
+    cout << res.json("pipe_child_to_parent", BUF_SIZE, DATA_SIZE) << "\n";
 }
 
 NOINLINE void parent_to_child() {
@@ -103,6 +104,7 @@ NOINLINE void parent_to_child() {
 
     cout << "p->c: " << (DATA_SIZE / 1024) << " KiB transfer with "
          << (BUF_SIZE / 1024) << " KiB buf: " << res << "\n";
+    cout << res.json("pipe_parent_to_child", BUF_SIZE, DATA_SIZE) << "\n";
 }
 
 void bpipe() {
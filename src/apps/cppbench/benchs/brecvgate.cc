@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+#include <base/Common.h>
+#include <base/util/Profile.h>
+#include <base/Env.h>
+#include <base/Panic.h>
+
+#include <m3/com/GateStream.h>
+#include <m3/stream/Standard.h>
+
+#include "../cppbench.h"
+
+using namespace m3;
+
+struct DispatchRunner : public Runner {
+    explicit DispatchRunner()
+        : rgate(RecvGate::create(nextlog2<512>::val, nextlog2<64>::val)),
+          sgate(SendGate::create(&rgate)),
+          handled() {
+    }
+
+    void run() override {
+        uint old = handled;
+        if(send_vmsg(sgate, 1) != Errors::NONE)
+            PANIC("send failed");
+        while(handled == old)
+            env()->workloop()->tick();
+    }
+
+    void handle(GateIStream &) {
+        handled++;
+    }
+
+    RecvGate rgate;
+    SendGate sgate;
+    uint handled;
+};
+
+NOINLINE static void function() {
+    DispatchRunner runner;
+    using std::placeholders::_1;
+    runner.rgate.start(std::bind(&DispatchRunner::handle, &runner, _1));
+
+    Profile pr;
+    Results res = pr.runner_with_id(runner, 0x90);
+    cout << res << "\n";
+    cout << res.json("recvgate_function") << "\n";
+}
+
+NOINLINE static void member() {
+    DispatchRunner runner;
+    runner.rgate.start<DispatchRunner, &DispatchRunner::handle>(&runner);
+
+    Profile pr;
+    Results res = pr.runner_with_id(runner, 0x91);
+    cout << res << "\n";
+    cout << res.json("recvgate_member") << "\n";
+}
+
+void brecvgate() {
+    RUN_BENCH(function);
+    RUN_BENCH(member);
+}
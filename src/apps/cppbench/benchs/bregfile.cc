@@ -31,7 +31,7 @@ alignas(64) static char buf[8192];
 NOINLINE static void read() {
     Profile pr(2, 1);
 
-    cout << "2 MiB file with 8K buf: " << pr.run_with_id([] {
+    Results res = pr.run_with_id([] {
         FileRef file("/data/2048k.txt", FILE_R);
         if(Errors::occurred())
             PANIC("Unable to open file '/data/2048k.txt'");
@@ -39,14 +39,16 @@ NOINLINE static void read() {
         ssize_t amount;
         while((amount = file->read(buf, sizeof(buf))) > 0)
             ;
-    }, 0x30) << "\n";
+    }, 0x30);
+    cout << "2 MiB file with 8K buf: " << res << "\n";
+    cout << res.json("regfile_read", sizeof(buf), 2 * 1024 * 1024) << "\n";
 }
 
 NOINLINE static void write() {
     const size_t SIZE = 2 * 1024 * 1024;
     Profile pr(2, 1);
 
-    cout << "2 MiB file with 8K buf: " << pr.run_with_id([] {
+    Results res = pr.run_with_id([] {
         FileRef file("/newfile", FILE_W | FILE_TRUNC | FILE_CREATE);
         if(Errors::occurred())
             PANIC("Unable to open file '/newfile'");
@@ -58,7 +60,9 @@ NOINLINE static void write() {
                 PANIC("Unable to write to file");
             total += static_cast<size_t>(amount);
         }
-    }, 0x31) << "\n";
+    }, 0x31);
+    cout << "2 MiB file with 8K buf: " << res << "\n";
+    cout << res.json("regfile_write", sizeof(buf), SIZE) << "\n";
 }
 
 void bregfile() {
@@ -51,7 +51,9 @@ NOINLINE static void append() {
 
     Profile pr(30);
     SListAppendRunner runner;
-    cout << "100-elements: " << pr.runner_with_id(runner, 0x10) << "\n";
+    Results res = pr.runner_with_id(runner, 0x10);
+    cout << "100-elements: " << res << "\n";
+    cout << res.json("slist_append") << "\n";
 }
 
 NOINLINE static void clear() {
@@ -73,7 +75,9 @@ NOINLINE static void clear() {
 
     Profile pr(30);
     SListClearRunner runner;
-    cout << "100-elements: " << pr.runner_with_id(runner, 0x11) << "\n";
+    Results res = pr.runner_with_id(runner, 0x11);
+    cout << "100-elements: " << res << "\n";
+    cout << res.json("slist_clear") << "\n";
 }
 
 void bslist() {
@@ -32,11 +32,13 @@ static capsel_t selector = ObjCap::INVALID;
 
 NOINLINE static void noop() {
     Profile pr;
-    cout << pr.run_with_id([] {
+    Results res = pr.run_with_id([] {
         Syscalls::get().noop();
         if(Errors::occurred())
             PANIC("syscall failed");
-    }, 0x50) << "\n";
+    }, 0x50);
+    cout << res << "\n";
+    cout << res.json("syscall_noop") << "\n";
 }
 
 NOINLINE static void activate() {
@@ -44,11 +46,13 @@ NOINLINE static void activate() {
     mgate.read(buf, 8, 0);
 
     Profile pr;
-    cout << pr.run_with_id([&mgate] {
+    Results res = pr.run_with_id([&mgate] {
         Syscalls::get().activate(VPE::self().ep_to_sel(mgate.ep()), mgate.sel(), 0);
         if(Errors::occurred())
             PANIC("syscall failed");
-    }, 0x51) << "\n";
+    }, 0x51);
+    cout << res << "\n";
+    cout << res.json("syscall_activate") << "\n";
 }
 
 NOINLINE static void create_rgate() {
@@ -65,7 +69,9 @@ NOINLINE static void create_rgate() {
 
     Profile pr;
     SyscallRGateRunner runner;
-    cout << pr.runner_with_id(runner, 0x52) << "\n";
+    Results res = pr.runner_with_id(runner, 0x52);
+    cout << res << "\n";
+    cout << res.json("syscall_create_rgate") << "\n";
 }
 
 NOINLINE static void create_sgate() {
@@ -86,7 +92,9 @@ NOINLINE static void create_sgate() {
 
     Profile pr;
     SyscallSGateRunner runner;
-    cout << pr.runner_with_id(runner, 0x53) << "\n";
+    Results res = pr.runner_with_id(runner, 0x53);
+    cout << res << "\n";
+    cout << res.json("syscall_create_sgate") << "\n";
 }
 
 NOINLINE static void create_mgate() {
@@ -103,7 +111,9 @@ NOINLINE static void create_mgate() {
 
     Profile pr;
     SyscallMGateRunner runner;
-    cout << pr.runner_with_id(runner, 0x54) << "\n";
+    Results res = pr.runner_with_id(runner, 0x54);
+    cout << res << "\n";
+    cout << res.json("syscall_create_mgate") << "\n";
 }
 
 NOINLINE static void create_map() {
@@ -132,7 +142,9 @@ NOINLINE static void create_map() {
 
     Profile pr;
     SyscallMapRunner runner;
-    cout << pr.runner_with_id(runner, 0x55) << "\n";
+    Results res = pr.runner_with_id(runner, 0x55);
+    cout << res << "\n";
+    cout << res.json("syscall_create_map") << "\n";
 }
 
 NOINLINE static void create_srv() {
@@ -155,7 +167,9 @@ NOINLINE static void create_srv() {
 
     Profile pr;
     SyscallSrvRunner runner;
-    cout << pr.runner_with_id(runner, 0x56) << "\n";
+    Results res = pr.runner_with_id(runner, 0x56);
+    cout << res << "\n";
+    cout << res.json("syscall_create_srv") << "\n";
 }
 
 NOINLINE static void open_sess() {
@@ -175,7 +189,9 @@ NOINLINE static void open_sess() {
 
     Profile pr;
     SyscallSessRunner runner;
-    cout << pr.runner_with_id(runner, 0x57) << "\n";
+    Results res = pr.runner_with_id(runner, 0x57);
+    cout << res << "\n";
+    cout << res.json("syscall_open_sess") << "\n";
 }
 
 NOINLINE static void derive_mem() {
@@ -197,7 +213,9 @@ NOINLINE static void derive_mem() {
 
     Profile pr;
     SyscallDeriveRunner runner;
-    cout << pr.runner_with_id(runner, 0x58) << "\n";
+    Results res = pr.runner_with_id(runner, 0x58);
+    cout << res << "\n";
+    cout << res.json("syscall_derive_mem") << "\n";
 }
 
 NOINLINE static void exchange() {
@@ -220,7 +238,9 @@ NOINLINE static void exchange() {
 
     Profile pr;
     SyscallExchangeRunner runner;
-    cout << pr.runner_with_id(runner, 0x59) << "\n";
+    Results res = pr.runner_with_id(runner, 0x59);
+    cout << res << "\n";
+    cout << res.json("syscall_exchange") << "\n";
 }
 
 NOINLINE static void revoke() {
@@ -240,7 +260,9 @@ NOINLINE static void revoke() {
 
     Profile pr;
     SyscallRevokeRunner runner;
-    cout << pr.runner_with_id(runner, 0x5A) << "\n";
+    Results res = pr.runner_with_id(runner, 0x5A);
+    cout << res << "\n";
+    cout << res.json("syscall_revoke") << "\n";
 }
 
 void bsyscall() {
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+#include <base/Common.h>
+#include <base/col/SList.h>
+#include <base/col/TimerWheel.h>
+#include <base/util/Profile.h>
+#include <base/Panic.h>
+
+#include <m3/stream/Standard.h>
+
+#include "../cppbench.h"
+
+using namespace m3;
+
+static const size_t TIMERS  = 100;
+static const cycles_t NOW   = 1000000;
+
+// a mix of short timeouts (e.g., SendQueue deferrals) and time slices
+static cycles_t timeout_for(size_t i) {
+    return (i % 4) == 0 ? 6000000 + i * 1000 : (i * 7919) % 100000;
+}
+
+struct MyTimer : public TimerWheel::Timer {
+};
+
+struct MySortedTimer : public SListItem {
+    cycles_t when;
+};
+
+// the previous implementation: a sorted list
+struct SortedList {
+    void insert(MySortedTimer *t) {
+        MySortedTimer *prev = nullptr;
+        for(auto it = list.begin(); it != list.end(); ++it) {
+            if(it->when >= t->when)
+                break;
+            prev = &*it;
+        }
+        list.insert(prev, t);
+    }
+
+    SList<MySortedTimer> list;
+};
+
+NOINLINE static void churn_list() {
+    struct ListChurnRunner : public Runner {
+        void run() override {
+            for(size_t i = 0; i < TIMERS; ++i) {
+                timers[i].when = NOW + timeout_for(i);
+                list.insert(&timers[i]);
+            }
+            // cancel every second timer and expire the rest
+            for(size_t i = 0; i < TIMERS; i += 2)
+                list.list.remove(&timers[i]);
+            while(list.list.length() > 0)
+                list.list.remove_first();
+        }
+
+        SortedList list;
+        MySortedTimer timers[TIMERS];
+    };
+
+    Profile pr(30);
+    ListChurnRunner runner;
+    Results res = pr.runner_with_id(runner, 0xA0);
+    cout << "sorted list: " << res << "\n";
+    cout << res.json("timerwheel_churn_list") << "\n";
+}
+
+NOINLINE static void churn_wheel() {
+    struct WheelChurnRunner : public Runner {
+        void run() override {
+            for(size_t i = 0; i < TIMERS; ++i) {
+                timers[i].when = NOW + timeout_for(i);
+                wheel.insert(&timers[i], NOW);
+            }
+            // cancel every second timer and expire the rest
+            for(size_t i = 0; i < TIMERS; i += 2)
+                wheel.remove(&timers[i]);
+            size_t expired = 0;
+            while(wheel.expire(static_cast<cycles_t>(-1) >> 1))
+                expired++;
+            if(expired != TIMERS / 2)
+                PANIC("Test failed: " << expired << " != " << (TIMERS / 2));
+        }
+
+        TimerWheel wheel;
+        MyTimer timers[TIMERS];
+    };
+
+    Profile pr(30);
+    WheelChurnRunner runner;
+    Results res = pr.runner_with_id(runner, 0xA1);
+    cout << "timer wheel: " << res << "\n";
+    cout << res.json("timerwheel_churn_wheel") << "\n";
+}
+
+void btimerwheel() {
+    RUN_BENCH(churn_list);
+    RUN_BENCH(churn_wheel);
+}
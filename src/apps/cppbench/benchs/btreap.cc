@@ -53,7 +53,9 @@ NOINLINE static void insert() {
 
     Profile pr(30);
     TreapInsertRunner runner;
-    cout << "100-elements: " << pr.runner_with_id(runner, 0x03) << "\n";
+    Results res = pr.runner_with_id(runner, 0x03);
+    cout << "100-elements: " << res << "\n";
+    cout << res.json("treap_insert") << "\n";
 }
 
 NOINLINE static void find() {
@@ -82,7 +84,9 @@ NOINLINE static void find() {
 
     Profile pr(30);
     TreapSearchRunner runner;
-    cout << "100-elements: " << pr.runner_with_id(runner, 0x02) << "\n";
+    Results res = pr.runner_with_id(runner, 0x02);
+    cout << "100-elements: " << res << "\n";
+    cout << res.json("treap_find") << "\n";
 }
 
 NOINLINE static void clear() {
@@ -104,7 +108,9 @@ NOINLINE static void clear() {
 
     Profile pr(30);
     TreapClearRunner runner;
-    cout << "100-elements: " << pr.runner_with_id(runner, 0x01) << "\n";
+    Results res = pr.runner_with_id(runner, 0x01);
+    cout << "100-elements: " << res << "\n";
+    cout << res.json("treap_clear") << "\n";
 }
 
 void btreap() {
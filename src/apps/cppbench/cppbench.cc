@@ -27,6 +27,8 @@ int main() {
     RUN_SUITE(bsyscall);
     RUN_SUITE(bpipe);
     RUN_SUITE(bfsmeta);
+    RUN_SUITE(brecvgate);
+    RUN_SUITE(btimerwheel);
 
     m3::cout << "\033[1;32mAll tests successful!\033[0;m\n";
     return 0;
@@ -32,3 +32,5 @@ void bregfile();
 void bmemgate();
 void bsyscall();
 void bpipe();
+void brecvgate();
+void btimerwheel();
@@ -22,6 +22,7 @@
 #include "../../partition.h"
 
 #include <sys/types.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
@@ -30,6 +31,9 @@ using namespace m3;
 
 static int disk_fd      = -1;
 static off_t disk_size  = 0;
+static char *disk_map   = nullptr;
+// the DTU messages on host need to fit into a datagram
+static const size_t MAX_XFER_SIZE   = 64 * 1024;
 static sPartition parts[PARTITION_COUNT];
 
 void disk_init(bool, bool, const char *disk) {
@@ -45,10 +49,15 @@ void disk_init(bool, bool, const char *disk) {
 
     SLOG(IDE, "Found disk device (" << (disk_size / (1024 * 1024)) << " MiB)");
 
+    // map the image to transfer the data directly between it and the client's memory
+    void *map = mmap(nullptr, static_cast<size_t>(disk_size), PROT_READ | PROT_WRITE, MAP_SHARED,
+                     disk_fd, 0);
+    if(map == MAP_FAILED)
+        exitmsg("Unable to map disk image '" << disk << "': " << strerror(errno));
+    disk_map = static_cast<char*>(map);
+
     // read partition table
-    char partbuf[512];
-    pread(disk_fd, partbuf, sizeof(partbuf), 0);
-    part_fillPartitions(parts, partbuf);
+    part_fillPartitions(parts, disk_map);
 
     for(size_t p = 0; p < PARTITION_COUNT; p++) {
         if(parts[p].present)
@@ -59,6 +68,8 @@ void disk_init(bool, bool, const char *disk) {
 }
 
 void disk_deinit() {
+    munmap(disk_map, static_cast<size_t>(disk_size));
+    close(disk_fd);
 }
 
 bool disk_exists(size_t dev) {
@@ -75,13 +86,16 @@ void disk_read(size_t dev, MemGate &mem, size_t memoff, size_t offset, size_t co
     }
 
     offset += part->start * 512;
+    if(offset + count > static_cast<size_t>(disk_size)) {
+        SLOG(IDE, "Invalid read-request: offset=" << offset << ", count=" << count
+                                                  << ", diskSize=" << disk_size);
+        return;
+    }
 
-    char buffer[4096];
     SLOG(IDE_ALL, "Reading " << count << " bytes @ " << offset << " from device " << dev);
     while(count > 0) {
-        size_t amount = Math::min(static_cast<size_t>(count), sizeof(buffer));
-        pread(disk_fd, buffer, amount, static_cast<off_t>(offset));
-        mem.write(buffer, amount, memoff);
+        size_t amount = Math::min(count, MAX_XFER_SIZE);
+        mem.write(disk_map + offset, amount, memoff);
 
         offset += amount;
         memoff += amount;
@@ -99,13 +113,16 @@ void disk_write(size_t dev, MemGate &mem, size_t memoff, size_t offset, size_t c
     }
 
     offset += part->start * 512;
+    if(offset + count > static_cast<size_t>(disk_size)) {
+        SLOG(IDE, "Invalid write-request: offset=" << offset << ", count=" << count
+                                                   << ", diskSize=" << disk_size);
+        return;
+    }
 
-    char buffer[4096];
     SLOG(IDE_ALL, "Writing " << count << " bytes @ " << offset << " to device " << dev);
     while(count > 0) {
-        size_t amount = Math::min(static_cast<size_t>(count), sizeof(buffer));
-        mem.read(buffer, amount, memoff);
-        pwrite(disk_fd, buffer, amount, static_cast<off_t>(offset));
+        size_t amount = Math::min(count, MAX_XFER_SIZE);
+        mem.read(disk_map + offset, amount, memoff);
 
         offset += amount;
         memoff += amount;
@@ -68,11 +68,10 @@ public:
         : base_class(),
           _rgate(RecvGate::create(nextlog2<32 * Disk::MSG_SIZE>::val,
                                   nextlog2<Disk::MSG_SIZE>::val)) {
-        add_operation(Disk::READ, &DiskRequestHandler::read);
-        add_operation(Disk::WRITE, &DiskRequestHandler::write);
+        add_operation<&DiskRequestHandler::read>(Disk::READ);
+        add_operation<&DiskRequestHandler::write>(Disk::WRITE);
 
-        using std::placeholders::_1;
-        _rgate.start(std::bind(&DiskRequestHandler::handle_message, this, _1));
+        _rgate.start<base_class, &base_class::handle_message>(this);
     }
 
     virtual Errors::Code obtain(DiskSrvSession *sess, KIF::Service::ExchangeData &data) override {
@@ -276,13 +276,14 @@ public:
         if(_dirMap[args->fd] == nullptr)
             exitmsg("Using uninitialized dir @ " << args->fd);
         m3::Dir::Entry e;
+        m3::FileInfo info;
         int i;
         // we don't check the result here because strace is often unable to determine the number of
         // fetched entries.
-        if(args->count == 0 && _dirMap[args->fd]->readdir(e))
+        if(args->count == 0 && _dirMap[args->fd]->readdir(e, info))
             ; //THROW1(ReturnValueException, 1, args->count, lineNo);
         else {
-            for(i = 0; i < args->count && _dirMap[args->fd]->readdir(e); ++i)
+            for(i = 0; i < args->count && _dirMap[args->fd]->readdir(e, info); ++i)
                 ;
             //if(i != args->count)
             //    THROW1(ReturnValueException, i, args->count, lineNo);
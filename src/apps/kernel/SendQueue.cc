@@ -24,11 +24,20 @@
 
 namespace kernel {
 
+uint SendQueue::_total_inflight = 0;
 uint64_t SendQueue::_next_id = 0;
 
+static_assert(alignof(SendQueue) >= SendQueue::MAX_WINDOW, "SendQueue alignment too small");
+
 SendQueue::~SendQueue() {
     // ensure that there are no messages left for this SendQueue in the receive buffer
-    m3::DTU::get().drop_msgs(SyscallHandler::srvep(), reinterpret_cast<label_t>(this));
+    for(label_t slot = 0; slot < _window; ++slot)
+        m3::DTU::get().drop_msgs(SyscallHandler::srvep(), reinterpret_cast<label_t>(this) | slot);
+
+    for(uint slot = 0; slot < _window; ++slot) {
+        if(_slots & (1U << slot))
+            _total_inflight--;
+    }
 
     if(_timeout)
         Timeouts::get().cancel(_timeout);
@@ -44,12 +53,14 @@ event_t SendQueue::send(SendGate *sgate, const void *msg, size_t size, bool onhe
     if(_inflight == -1)
         return 0;
 
-    if(_vpe.state() == VPE::RUNNING && _inflight == 0)
+    // keep the order of messages, i.e., only send directly if nothing is queued
+    if(_vpe.state() == VPE::RUNNING && _queue.length() == 0 && can_send())
         return do_send(sgate, _next_id++, msg, size, onheap);
 
-    // call this again from the workloop to be sure that we can switch the thread
-    if(_vpe.state() != VPE::RUNNING && _inflight == 0)
-        _timeout = Timeouts::get().wait_for(0, std::bind(&SendQueue::send_pending, this));
+    // if no reply will trigger us, call this again from the workloop. this ensures that we can
+    // switch the thread to resume the VPE and that we retry if all slots were in use.
+    if(_inflight == 0 && !_timeout)
+        _timeout = Timeouts::get().wait_for<SendQueue, &SendQueue::send_pending>(0, this);
 
     // if it's not already on the heap, put it there
     if(!onheap) {
@@ -62,48 +73,59 @@ event_t SendQueue::send(SendGate *sgate, const void *msg, size_t size, bool onhe
 
     Entry *e = new Entry(_next_id++, sgate, msg, size);
     _queue.append(e);
+    _queued++;
+    _max_depth = m3::Math::max(_max_depth, _queue.length());
     return get_event(e->id);
 }
 
 void SendQueue::send_pending() {
     _timeout = nullptr;
 
-    if(_queue.length() == 0)
-        return;
-
-    Entry *e = _queue.remove_first();
-
-    KLOG(SQUEUE, "SendQueue[" << _vpe.id() << "]: found pending message");
+    while(_queue.length() > 0) {
+        KLOG(SQUEUE, "SendQueue[" << _vpe.id() << "]: found pending message");
+
+        // ensure that the VPE is running
+        while(_vpe.state() != VPE::RUNNING) {
+            // if it died, just drop the pending message
+            if(!_vpe.resume()) {
+                if(_queue.length() > 0)
+                    delete _queue.remove_first();
+                return;
+            }
+        }
 
-    // ensure that the VPE is running
-    while(_vpe.state() != VPE::RUNNING) {
-        // if it died, just drop the pending message
-        if(!_vpe.resume()) {
-            delete e;
+        // other threads might have sent the messages or filled the window in the meantime
+        if(_queue.length() == 0)
+            return;
+        if(!can_send()) {
+            // all kernel slots are in use by other queues; try again later
+            if(_inflight == 0 && !_timeout)
+                _timeout = Timeouts::get().wait_for<SendQueue, &SendQueue::send_pending>(0, this);
             return;
         }
-    }
 
-    // it might happen that there is another message in flight now
-    if(_inflight != 0) {
-        KLOG(SQUEUE, "SendQueue[" << _vpe.id() << "]: queuing message");
-        _queue.append(e);
-        return;
+        Entry *e = _queue.remove_first();
+        // pending messages have always been copied to the heap
+        do_send(e->sgate, e->id, e->msg, e->size, true);
+        delete e;
     }
-
-    // pending messages have always been copied to the heap
-    do_send(e->sgate, e->id, e->msg, e->size, true);
-    delete e;
 }
 
 void SendQueue::received_reply(epid_t ep, const m3::DTU::Message *msg) {
-    KLOG(SQUEUE, "SendQueue[" << _vpe.id() << "]: received reply");
+    uint slot = static_cast<uint>(msg->label & SLOT_MASK);
 
-    m3::ThreadManager::get().notify(_cur_event, msg, msg->length + sizeof(m3::DTU::Message::Header));
+    KLOG(SQUEUE, "SendQueue[" << _vpe.id() << "]: received reply for slot " << slot);
+
+    m3::ThreadManager::get().notify(_events[slot], msg, msg->length + sizeof(m3::DTU::Message::Header));
 
     // now that we've copied the message, we can mark it read
     m3::DTU::get().mark_read(ep, reinterpret_cast<size_t>(msg));
 
+    if(_slots & (1U << slot)) {
+        _slots &= ~(1U << slot);
+        _total_inflight--;
+    }
+
     if(_inflight != -1) {
         assert(_inflight > 0);
         _inflight--;
@@ -113,22 +135,35 @@ void SendQueue::received_reply(epid_t ep, const m3::DTU::Message *msg) {
 }
 
 event_t SendQueue::do_send(SendGate *sgate, uint64_t id, const void *msg, size_t size, bool onheap) {
-    KLOG(SQUEUE, "SendQueue[" << _vpe.id() << "]: sending message");
+    uint slot = 0;
+    while(_slots & (1U << slot))
+        slot++;
+    assert(slot < _window);
+
+    KLOG(SQUEUE, "SendQueue[" << _vpe.id() << "]: sending message in slot " << slot);
 
-    _cur_event = get_event(id);
+    _slots |= 1U << slot;
+    _events[slot] = get_event(id);
     _inflight++;
+    _total_inflight++;
+    _sent++;
+    _max_inflight = m3::Math::max(_max_inflight, _inflight);
 
-    sgate->send(msg, size, SyscallHandler::srvep(), reinterpret_cast<label_t>(this));
+    label_t label = reinterpret_cast<label_t>(this) | slot;
+    sgate->send(msg, size, SyscallHandler::srvep(), label);
     if(onheap)
         m3::Heap::free(const_cast<void*>(msg));
-    return _cur_event;
+    return _events[slot];
 }
 
 void SendQueue::abort() {
     KLOG(SQUEUE, "SendQueue[" << _vpe.id() << "]: aborting");
 
-    if(_inflight)
-        m3::ThreadManager::get().notify(_cur_event);
+    // wakeup all waiting threads; the slots stay occupied until the replies arrive
+    for(uint slot = 0; slot < _window; ++slot) {
+        if(_slots & (1U << slot))
+            m3::ThreadManager::get().notify(_events[slot]);
+    }
     _inflight = -1;
 
     while(_queue.length() > 0)
@@ -18,6 +18,7 @@
 
 #include <base/Common.h>
 #include <base/col/SList.h>
+#include <base/util/Math.h>
 #include <base/DTU.h>
 
 #include "Gate.h"
@@ -43,12 +44,45 @@ class SendQueue {
     };
 
 public:
-    explicit SendQueue(VPE &vpe)
+    /**
+     * The maximum number of messages that can be in flight per queue. The slot of a message is
+     * encoded in the lower bits of the reply label, which are always zero for the SendQueue address.
+     */
+    static const uint MAX_WINDOW        = 8;
+    static const label_t SLOT_MASK      = MAX_WINDOW - 1;
+
+    /**
+     * The maximum number of messages that can be in flight in total, which is limited by the
+     * number of slots in the kernel's receive buffer for the replies.
+     */
+    static const uint MAX_INFLIGHT      = 32;
+
+    /**
+     * @param label the label of a reply
+     * @return the SendQueue that sent the corresponding message
+     */
+    static SendQueue *from_label(label_t label) {
+        return reinterpret_cast<SendQueue*>(label & ~SLOT_MASK);
+    }
+
+    /**
+     * Creates a new SendQueue for given VPE
+     *
+     * @param vpe the VPE that receives the messages
+     * @param window the number of messages that can be in flight at once (at most MAX_WINDOW)
+     */
+    explicit SendQueue(VPE &vpe, uint window = 1)
         : _vpe(vpe),
           _queue(),
-          _cur_event(),
+          _window(m3::Math::min(m3::Math::max(window, 1U), MAX_WINDOW)),
+          _slots(),
+          _events(),
           _inflight(0),
-          _timeout() {
+          _timeout(),
+          _sent(),
+          _queued(),
+          _max_depth(),
+          _max_inflight() {
     }
     ~SendQueue();
 
@@ -61,21 +95,60 @@ public:
     int pending() const {
         return static_cast<int>(_queue.length());
     }
+    uint window() const {
+        return _window;
+    }
+
+    /**
+     * @return the total number of sent messages
+     */
+    uint64_t sent() const {
+        return _sent;
+    }
+    /**
+     * @return the number of messages that had to be queued
+     */
+    uint64_t queued() const {
+        return _queued;
+    }
+    /**
+     * @return the maximum number of messages that have been queued at once
+     */
+    size_t max_depth() const {
+        return _max_depth;
+    }
+    /**
+     * @return the maximum number of messages that have been in flight at once
+     */
+    int max_inflight() const {
+        return _max_inflight;
+    }
 
     event_t send(SendGate *sgate, const void *msg, size_t size, bool onheap);
     void received_reply(epid_t ep, const m3::DTU::Message *msg);
     void abort();
 
 private:
+    bool can_send() const {
+        return _inflight != -1 && _inflight < static_cast<int>(_window) &&
+               _total_inflight < MAX_INFLIGHT;
+    }
     void send_pending();
     event_t get_event(uint64_t id);
     event_t do_send(SendGate *sgate, uint64_t id, const void *msg, size_t size, bool onheap);
 
     VPE &_vpe;
     m3::SList<Entry> _queue;
-    event_t _cur_event;
+    uint _window;
+    uint _slots;
+    event_t _events[MAX_WINDOW];
     int _inflight;
     Timeout *_timeout;
+    uint64_t _sent;
+    uint64_t _queued;
+    size_t _max_depth;
+    int _max_inflight;
+    static uint _total_inflight;
     static uint64_t _next_id;
 };
 
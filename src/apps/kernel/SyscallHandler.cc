@@ -27,6 +27,7 @@
 #include "pes/VPEManager.h"
 #include "DTU.h"
 #include "Platform.h"
+#include "SendQueue.h"
 #include "SyscallHandler.h"
 #include "WorkLoop.h"
 
@@ -73,7 +74,8 @@ void SyscallHandler::init() {
             buford, VPE::SYSC_MSGSIZE_ORD);
     }
 
-    int buford = m3::nextlog2<1024>::val;
+    // one slot for every request that can be in flight to services
+    int buford = m3::nextlog2<SendQueue::MAX_INFLIGHT * 256>::val;
     size_t bufsize = static_cast<size_t>(1) << buford;
     DTU::get().recv_msgs(srvep(), reinterpret_cast<uintptr_t>(new uint8_t[bufsize]),
         buford, m3::nextlog2<256>::val);
@@ -225,10 +227,10 @@ void SyscallHandler::createsrv(VPE *vpe, const m3::DTU::Message *msg) {
         int_target = vpe->pid();
 #endif
 
-    // maybe there are VPEs that now have all requirements fullfilled
-    VPEManager::get().start_pending(ServiceList::get());
-
     reply_result(vpe, msg, m3::Errors::NONE);
+
+    // the service is completely set up now; start the ones that wait for it
+    ServiceList::get().notify(s);
 }
 
 void SyscallHandler::createsess(VPE *vpe, const m3::DTU::Message *msg) {
@@ -106,7 +106,7 @@ void WorkLoop::run() {
 
         msg = dtu.fetch_msg(srvep);
         if(msg) {
-            SendQueue *sq = reinterpret_cast<SendQueue*>(msg->label);
+            SendQueue *sq = SendQueue::from_label(msg->label);
             sq->received_reply(srvep, msg);
         }
 
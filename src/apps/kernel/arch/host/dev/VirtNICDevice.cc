@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+
+#include <base/log/Kernel.h>
+
+#include <csignal>
+#include <unistd.h>
+
+#include "VirtNICDevice.h"
+
+namespace kernel {
+
+VirtNICDevice::VirtNICDevice()
+    : Device(),
+      _mem(VNIC_SHM_NAME, sizeof(m3::VirtNICMem), m3::SharedMemory::CREATE),
+      _nic(reinterpret_cast<m3::VirtNICMem*>(_mem.addr())) {
+    start();
+}
+
+void VirtNICDevice::run() {
+    while(should_run()) {
+        usleep(10000);
+        check();
+    }
+}
+
+void VirtNICDevice::check() {
+    uint32_t up = 1;
+    for(size_t i = 0; i < m3::VirtNICMem::PORTS; ++i) {
+        m3::VirtNICMem::Port &port = _nic->ports[i];
+        int32_t pid = __atomic_load_n(&port.pid, __ATOMIC_ACQUIRE);
+        // release the port if its owner died without doing so
+        if(pid != 0 && kill(pid, 0) == -1) {
+            KLOG(VPES, "vnic: releasing port " << i << " of dead process " << pid);
+            // drop the frames that have not been received yet
+            port.rx.head = __atomic_load_n(&port.rx.tail, __ATOMIC_ACQUIRE);
+            __atomic_store_n(&port.pid, 0, __ATOMIC_RELEASE);
+            pid = 0;
+        }
+        if(pid == 0)
+            up = 0;
+    }
+
+    for(size_t i = 0; i < m3::VirtNICMem::PORTS; ++i)
+        __atomic_store_n(&_nic->ports[i].link_up, up, __ATOMIC_RELEASE);
+}
+
+}
@@ -16,6 +16,7 @@
 
 #include <base/col/SList.h>
 #include <base/log/Kernel.h>
+#include <base/tracing/Tracing.h>
 #include <base/Config.h>
 #include <base/DTU.h>
 #include <base/Panic.h>
@@ -35,6 +36,7 @@
 #include "pes/VPE.h"
 #include "dev/TimerDevice.h"
 #include "dev/VGAConsole.h"
+#include "dev/VirtNICDevice.h"
 #include "SyscallHandler.h"
 
 using namespace kernel;
@@ -107,6 +109,8 @@ int main(int argc, char *argv[]) {
             devices.append(new VGAConsoleDevice());
         else if(strcmp(argv[i], "-t") == 0)
             devices.append(new TimerDevice());
+        else if(strcmp(argv[i], "-n") == 0)
+            devices.append(new VirtNICDevice());
         else if(strncmp(argv[i], "fs=", 3) == 0)
             fsimg = argv[i] + 3;
     }
@@ -119,6 +123,8 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    EVENT_TRACE_INIT_KERNEL();
+
     KLOG(MEM, MainMemory::get());
 
     // create some worker threads
@@ -140,11 +146,18 @@ int main(int argc, char *argv[]) {
     if(fsimg)
         copytofs(MainMemory::get(), fsimg);
     VPEManager::destroy();
+    // collect the traces of the VPEs we had to kill
+    EVENT_TRACE_DUMP();
     for(auto it = devices.begin(); it != devices.end(); ) {
         auto old = it++;
         old->stop();
         delete &*old;
     }
     delete_dir("/tmp/m3");
+
+    // stop the DTU thread before we dump and remove our own trace
+    m3::DTU::get().stop();
+    pthread_join(m3::DTU::get().tid(), nullptr);
+    EVENT_TRACE_FINISH();
     return EXIT_SUCCESS;
 }
@@ -15,6 +15,7 @@
  */
 
 #include <base/Common.h>
+#include <base/log/Kernel.h>
 
 #include "com/Services.h"
 #include "pes/VPE.h"
@@ -23,10 +24,16 @@ namespace kernel {
 
 ServiceList ServiceList::_inst;
 
-Service::Service(VPE &vpe, capsel_t sel, const m3::String &name, const m3::Reference<RGateObject> &rgate)
+static uint window_size(const m3::Reference<RGateObject> &rgate) {
+    // we can't have more requests in flight than the service's receive buffer has slots
+    uint slots = 1U << (rgate->order - rgate->msgorder);
+    return m3::Math::min(slots, SendQueue::MAX_WINDOW);
+}
+
+Service::Service(VPE &vpe, capsel_t sel, ServiceName *name, const m3::Reference<RGateObject> &rgate)
     : m3::SListItem(),
       RefCounted(),
-      _squeue(vpe),
+      _squeue(vpe, window_size(rgate)),
       _sel(sel),
       _name(name),
       _sgate(vpe, rgate->ep, 0),
@@ -35,6 +42,10 @@ Service::Service(VPE &vpe, capsel_t sel, const m3::String &name, const m3::Refer
 }
 
 Service::~Service() {
+    KLOG(SERV, "Service[" << name() << "]: sent " << _squeue.sent() << " requests, queued "
+        << _squeue.queued() << ", window " << _squeue.window() << ", max inflight "
+        << _squeue.max_inflight() << ", max depth " << _squeue.max_depth());
+
     _sgate.vpe().rem_service();
     // we have allocated the selector and stored it in our cap-table on creation; undo that
     ServiceList::get().remove(this);
@@ -62,4 +73,86 @@ const m3::DTU::Message *Service::send_receive(const void *msg, size_t size, bool
     return reinterpret_cast<const m3::DTU::Message*>(m3::ThreadManager::get().get_current_msg());
 }
 
+uint32_t ServiceList::hash(const m3::String &name) {
+    // FNV-1a
+    uint32_t h = 2166136261U;
+    for(size_t i = 0; i < name.length(); ++i) {
+        h ^= static_cast<uint8_t>(name.c_str()[i]);
+        h *= 16777619U;
+    }
+    return h;
+}
+
+ServiceName *ServiceList::get_name(const m3::String &name, bool create) {
+    uint32_t h = hash(name);
+    m3::SList<ServiceName> &bucket = _buckets[h % BUCKETS];
+    for(auto &n : bucket) {
+        if(n.hash == h && n.name == name)
+            return &n;
+    }
+
+    if(!create)
+        return nullptr;
+    ServiceName *n = new ServiceName(name, h);
+    bucket.append(n);
+    return n;
+}
+
+void ServiceList::put_name(ServiceName *name) {
+    // the name is only kept as long as there is a service or a waiter for it
+    if(name->service == nullptr && name->waiters.length() == 0) {
+        _buckets[name->hash % BUCKETS].remove(name);
+        delete name;
+    }
+}
+
+Service *ServiceList::add(VPE &vpe, capsel_t sel, const m3::String &name,
+                          const m3::Reference<RGateObject> &rgate) {
+    ServiceName *n = get_name(name, true);
+    assert(n->service == nullptr);
+
+    Service *inst = new Service(vpe, sel, n, rgate);
+    n->service = inst;
+    // prepend to the list to shutdown services in the opposite order
+    _list.insert(nullptr, inst);
+    return inst;
+}
+
+void ServiceList::notify(Service *inst) {
+    // wake up exactly the ones that wait for this service
+    ServiceName *n = inst->_name;
+    while(n->waiters.length() > 0) {
+        ServiceWaiter *w = n->waiters.remove_first();
+        _wakeups++;
+        w->service_available(*inst);
+    }
+}
+
+Service *ServiceList::find(const m3::String &name) {
+    _lookups++;
+    ServiceName *n = get_name(name, false);
+    if(n == nullptr || n->service == nullptr) {
+        _misses++;
+        return nullptr;
+    }
+    return n->service;
+}
+
+void ServiceList::wait_for(const m3::String &name, ServiceWaiter *waiter) {
+    ServiceName *n = get_name(name, true);
+    if(n->service)
+        waiter->service_available(*n->service);
+    else {
+        KLOG(SERV, "Waiting for service '" << name << "'");
+        _waits++;
+        n->waiters.append(waiter);
+    }
+}
+
+void ServiceList::remove(Service *inst) {
+    _list.remove(inst);
+    inst->_name->service = nullptr;
+    put_name(inst->_name);
+}
+
 }
@@ -29,10 +29,47 @@ namespace kernel {
 
 class VPE;
 class RGateObject;
+class Service;
+
+/**
+ * An object that waits for a service with a specific name to be registered
+ */
+class ServiceWaiter : public m3::SListItem {
+public:
+    virtual ~ServiceWaiter() {
+    }
+
+    /**
+     * Is called as soon as the service has been registered. The waiter is no longer in the list
+     * of the name at this point and might be deleted by this method.
+     *
+     * @param srv the service
+     */
+    virtual void service_available(Service &srv) = 0;
+};
+
+/**
+ * The interned name of a service. All services and waiters with the same name refer to the same
+ * object, which also caches the hash of the name.
+ */
+struct ServiceName : public SlabObject<ServiceName>, public m3::SListItem {
+    explicit ServiceName(const m3::String &_name, uint32_t _hash)
+        : m3::SListItem(),
+          name(_name),
+          hash(_hash),
+          service(),
+          waiters() {
+    }
+
+    m3::String name;
+    uint32_t hash;
+    Service *service;
+    m3::SList<ServiceWaiter> waiters;
+};
 
 class Service : public SlabObject<Service>, public m3::SListItem, public m3::RefCounted {
 public:
-    explicit Service(VPE &vpe, capsel_t sel, const m3::String &name, const m3::Reference<RGateObject> &rgate);
+    explicit Service(VPE &vpe, capsel_t sel, ServiceName *name, const m3::Reference<RGateObject> &rgate);
     ~Service();
 
     VPE &vpe() const {
@@ -42,7 +79,7 @@ public:
         return _sel;
     }
     const m3::String &name() const {
-        return _name;
+        return _name->name;
     }
     const m3::Reference<RGateObject> &rgate() const {
         return _rgate;
@@ -57,15 +94,23 @@ public:
     }
 
 private:
+    friend class ServiceList;
+
     SendQueue _squeue;
     capsel_t _sel;
-    m3::String _name;
+    ServiceName *_name;
     SendGate _sgate;
     m3::Reference<RGateObject> _rgate;
 };
 
+/**
+ * The registry of all services. Besides the list of services, which determines the shutdown
+ * order, it maintains a hash table of the interned names for the lookups and the waiters.
+ */
 class ServiceList {
-    explicit ServiceList() : _list() {
+    static const size_t BUCKETS = 64;
+
+    explicit ServiceList() : _list(), _buckets(), _lookups(), _misses(), _waits(), _wakeups() {
     }
 
 public:
@@ -84,33 +129,67 @@ public:
         return _list.end();
     }
 
-    Service *add(VPE &vpe, capsel_t sel, const m3::String &name, const m3::Reference<RGateObject> &rgate) {
-        Service *inst = new Service(vpe, sel, name, rgate);
-        // prepend to the list to shutdown services in the opposite order
-        _list.insert(nullptr, inst);
-        return inst;
-    }
+    /**
+     * Registers a new service with given name. The name has to be unused. The waiters for it are
+     * not woken up until notify() is called.
+     */
+    Service *add(VPE &vpe, capsel_t sel, const m3::String &name, const m3::Reference<RGateObject> &rgate);
+
+    /**
+     * Wakes up all waiters for the given service. Should be called as soon as the service is
+     * fully set up, i.e., its capability has been installed.
+     *
+     * @param inst the service
+     */
+    void notify(Service *inst);
+
     bool contains(const m3::String &name) const {
         return const_cast<ServiceList*>(this)->find(name) != nullptr;
     }
-    Service *find(const m3::String &name) {
-        for(auto &s : _list) {
-            if(s.name() == name)
-                return &s;
-        }
-        return nullptr;
-    }
+    Service *find(const m3::String &name);
+
+    /**
+     * Lets <waiter> wait until the service with given name is registered. If it exists already,
+     * the waiter is called immediately.
+     *
+     * @param name the service name
+     * @param waiter the waiter
+     */
+    void wait_for(const m3::String &name, ServiceWaiter *waiter);
 
     void send(m3::Reference<Service> serv, const void *msg, size_t size, bool free) {
         serv->send(msg, size, free);
     }
 
-private:
-    void remove(Service *inst) {
-        _list.remove(inst);
+    /**
+     * @return the number of lookups, failed lookups, waits and wakeups so far
+     */
+    ulong lookups() const {
+        return _lookups;
     }
+    ulong misses() const {
+        return _misses;
+    }
+    ulong waits() const {
+        return _waits;
+    }
+    ulong wakeups() const {
+        return _wakeups;
+    }
+
+private:
+    static uint32_t hash(const m3::String &name);
+
+    ServiceName *get_name(const m3::String &name, bool create);
+    void put_name(ServiceName *name);
+    void remove(Service *inst);
 
     m3::SList<Service> _list;
+    m3::SList<ServiceName> _buckets[BUCKETS];
+    ulong _lookups;
+    ulong _misses;
+    ulong _waits;
+    ulong _wakeups;
     static ServiceList _inst;
 };
 
@@ -336,8 +336,8 @@ bool ContextSwitcher::unblock_vpe(VPE *vpe, bool force) {
         uint64_t exectime = now - _cur->_lastsched;
         // if there is some time left in the timeslice, program a timeout
         if(exectime < VPE::TIME_SLICE) {
-            auto &&callback = std::bind(&ContextSwitcher::start_switch, this, true);
-            _timeout = Timeouts::get().wait_for(VPE::TIME_SLICE - exectime, m3::Util::move(callback));
+            _timeout = Timeouts::get().wait_for<ContextSwitcher, &ContextSwitcher::timeslice_expired>(
+                VPE::TIME_SLICE - exectime, this);
         }
         // otherwise, switch now
         else
@@ -404,7 +404,7 @@ void ContextSwitcher::continue_switch() {
         assert(_wait_time > 0);
         if(_wait_time < MAX_WAIT_TIME)
             _wait_time *= 2;
-        Timeouts::get().wait_for(_wait_time, std::bind(&ContextSwitcher::continue_switch, this));
+        Timeouts::get().wait_for<ContextSwitcher, &ContextSwitcher::continue_switch>(_wait_time, this);
     }
     else {
         if(next_state(flags))
@@ -534,8 +534,8 @@ retry:
 
             // if we are starting a VPE, we might already have a timeout for it
             if(_ready.length() > 0 && !_timeout) {
-                auto &&callback = std::bind(&ContextSwitcher::start_switch, this, true);
-                _timeout = Timeouts::get().wait_for(VPE::TIME_SLICE, m3::Util::move(callback));
+                _timeout = Timeouts::get().wait_for<ContextSwitcher, &ContextSwitcher::timeslice_expired>(
+                    VPE::TIME_SLICE, this);
             }
             break;
         }
@@ -557,7 +557,7 @@ retry:
                 goto retry;
         }
 
-        Timeouts::get().wait_for(_wait_time, std::bind(&ContextSwitcher::continue_switch, this));
+        Timeouts::get().wait_for<ContextSwitcher, &ContextSwitcher::continue_switch>(_wait_time, this);
     }
 
     return _state == S_IDLE;
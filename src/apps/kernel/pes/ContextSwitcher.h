@@ -102,6 +102,9 @@ private:
     bool current_is_idling() const;
 
     bool start_switch(bool timedout = false);
+    void timeslice_expired() {
+        start_switch(true);
+    }
     void continue_switch();
 
     bool next_state(uint64_t flags);
@@ -26,60 +26,51 @@ Timeouts Timeouts::_inst;
 
 cycles_t Timeouts::sleep_time() const {
     // sleep until waked up by a message if there is no pending timeout
-    if(_timeouts.length() == 0)
+    if(_wheel.length() == 0)
         return 0;
 
     cycles_t now = DTU::get().get_time();
     // do not sleep if there are timeouts to trigger
-    if(_timeouts.begin()->when <= now)
+    if(_wheel.next() <= now)
         return static_cast<cycles_t>(-1);
 
     // sleep until the next timeout or until we receive a message
-    return _timeouts.begin()->when - now;
+    return _wheel.next() - now;
 }
 
 void Timeouts::trigger() {
     // exit early if nothing to do
-    if(_timeouts.length() == 0)
+    if(_wheel.length() == 0)
         return;
 
-    EVENT_TRACER_Kernel_Timeouts();
     cycles_t now = DTU::get().get_time();
-    do {
-        auto &to = *_timeouts.begin();
-        // timeouts are sorted, so stop if we hit a future timeout
-        if(to.when > now)
-            break;
+    if(_wheel.next() > now)
+        return;
 
-        KLOG(TIMEOUTS, "Triggering timeout " << &to << " (now=" << now << ", due=" << to.when << ")");
-        // remove it first to get into a consistent state; the callback might do a thread switch
-        _timeouts.remove_first();
-        to.callback();
-        delete &to;
+    EVENT_TRACER_Kernel_Timeouts();
+    m3::TimerWheel::Timer *t;
+    // the timeout has been removed from the wheel; the callback might do a thread switch
+    while((t = _wheel.expire(now)) != nullptr) {
+        Timeout *to = static_cast<Timeout*>(t);
+        KLOG(TIMEOUTS, "Triggering timeout " << to << " (now=" << now << ", due=" << to->when << ")");
+        to->func(to->arg);
+        delete to;
     }
-    while(_timeouts.length() > 0);
 }
 
-Timeout *Timeouts::wait_for(cycles_t cycles, std::function<void()> &&callback) {
-    cycles_t when = DTU::get().get_time() + cycles;
-
-    // insert timeouts in ascending order
-    Timeout *prev = nullptr;
-    for(auto it = _timeouts.begin(); it != _timeouts.end(); ++it) {
-        if(it->when >= when)
-            break;
-        prev = &*it;
-    }
+Timeout *Timeouts::wait_for(cycles_t cycles, Timeout::callback_t func, void *arg) {
+    cycles_t now = DTU::get().get_time();
 
-    Timeout *to = new Timeout(when, m3::Util::move(callback));
+    Timeout *to = new Timeout(func, arg);
+    to->when = now + cycles;
     KLOG(TIMEOUTS, "Inserting timeout " << to << " (due=" << to->when << ")");
-    _timeouts.insert(prev, to);
+    _wheel.insert(to, now);
     return to;
 }
 
 void Timeouts::cancel(Timeout *to) {
     KLOG(TIMEOUTS, "Canceling timeout " << to << " (due=" << to->when << ")");
-    _timeouts.remove(to);
+    _wheel.remove(to);
     delete to;
 }
 
@@ -16,27 +16,27 @@
 
 #pragma once
 
-#include <base/col/SList.h>
-
-#include <functional>
+#include <base/col/TimerWheel.h>
 
 #include "mem/SlabCache.h"
 
 namespace kernel {
 
-struct Timeout : public m3::SListItem, public SlabObject<Timeout> {
-    explicit Timeout(cycles_t when, std::function<void()> &&callback)
-        : m3::SListItem(),
-          when(when),
-          callback(callback) {
+struct Timeout : public m3::TimerWheel::Timer, public SlabObject<Timeout> {
+    using callback_t = void (*)(void *arg);
+
+    explicit Timeout(callback_t func, void *arg)
+        : m3::TimerWheel::Timer(),
+          func(func),
+          arg(arg) {
     }
 
-    cycles_t when;
-    std::function<void ()> callback;
+    callback_t func;
+    void *arg;
 };
 
 class Timeouts {
-    explicit Timeouts() : _timeouts() {
+    explicit Timeouts() : _wheel() {
     }
 
 public:
@@ -48,12 +48,29 @@ public:
 
     void trigger();
 
-    Timeout *wait_for(cycles_t cycles, std::function<void()> &&callback);
+    /**
+     * Calls <F> on <obj> in <cycles> cycles.
+     *
+     * @param cycles the number of cycles to wait
+     * @param obj the object
+     * @return the timeout, which can be canceled
+     */
+    template<class T, void (T::*F)()>
+    Timeout *wait_for(cycles_t cycles, T *obj) {
+        return wait_for(cycles, &call_member<T, F>, obj);
+    }
+
+    Timeout *wait_for(cycles_t cycles, Timeout::callback_t func, void *arg);
 
     void cancel(Timeout *to);
 
 private:
-    m3::SList<Timeout> _timeouts;
+    template<class T, void (T::*F)()>
+    static void call_member(void *obj) {
+        (static_cast<T*>(obj)->*F)();
+    }
+
+    m3::TimerWheel _wheel;
     static Timeouts _inst;
 };
 
@@ -31,8 +31,7 @@ VPEManager::VPEManager()
     : _next_id(0),
       _vpes(new VPE*[MAX_VPES]()),
       _count(),
-      _daemons(),
-      _pending() {
+      _daemons() {
 }
 
 void VPEManager::init(int argc, char **argv) {
@@ -93,9 +92,9 @@ void VPEManager::init(int argc, char **argv) {
         // remember arguments
         _vpes[id]->set_args(static_cast<size_t>(end - i), argv + i);
 
-        // register pending item if necessary
+        // wait for the required services if necessary
         if(strcmp(argv[i], "idle") != 0 && _vpes[id]->requirements().length() > 0)
-            _pending.append(new Pending(_vpes[id]));
+            start_when_ready(_vpes[id]);
         else
             _vpes[id]->start_app(_vpes[id]->pid());
 
@@ -103,27 +102,27 @@ void VPEManager::init(int argc, char **argv) {
     }
 }
 
-void VPEManager::start_pending(const ServiceList &serv) {
-    for(auto it = _pending.begin(); it != _pending.end(); ) {
-        bool fullfilled = true;
-        for(auto &r : it->vpe->requirements()) {
-            if(!serv.contains(r.name)) {
-                fullfilled = false;
-                break;
-            }
-        }
-
-        if(fullfilled) {
-            auto old = it++;
-            old->vpe->start_app(old->vpe->pid());
-            _pending.remove(&*old);
-            delete &*old;
-        }
-        else
-            it++;
+void VPEManager::Pending::fulfilled() {
+    if(--missing == 0) {
+        vpe->start_app(vpe->pid());
+        delete this;
     }
 }
 
+void VPEManager::Requirement::service_available(Service &) {
+    Pending *p = pending;
+    delete this;
+    p->fulfilled();
+}
+
+void VPEManager::start_when_ready(VPE *vpe) {
+    // hold one reference ourself to not start the VPE before all waiters are registered
+    Pending *p = new Pending(vpe, vpe->requirements().length() + 1);
+    for(auto &r : vpe->requirements())
+        ServiceList::get().wait_for(r.name, new Requirement(p));
+    p->fulfilled();
+}
+
 void VPEManager::shutdown() {
     if(_shutdown)
         return;
@@ -138,6 +137,9 @@ void VPEManager::shutdown() {
         msg.opcode = m3::KIF::Service::SHUTDOWN;
         ref->send_receive(&msg, sizeof(msg), false);
     }
+
+    KLOG(SERV, "Service lookups: " << serv.lookups() << " (" << serv.misses() << " failed), waits: "
+        << serv.waits() << ", wakeups: " << serv.wakeups());
 }
 
 vpeid_t VPEManager::get_id() {
@@ -18,6 +18,7 @@
 
 #include <base/PEDesc.h>
 
+#include "com/Services.h"
 #include "pes/VPE.h"
 #include "Platform.h"
 
@@ -27,11 +28,24 @@ class VPEManager {
     friend class VPE;
     friend class ContextSwitcher;
 
-    struct Pending : public m3::SListItem {
-        explicit Pending(VPE *_vpe) : vpe(_vpe) {
+    // a VPE that is started as soon as all services it requires are available
+    struct Pending {
+        explicit Pending(VPE *_vpe, size_t _missing) : vpe(_vpe), missing(_missing) {
         }
 
+        void fulfilled();
+
         VPE *vpe;
+        size_t missing;
+    };
+
+    struct Requirement : public ServiceWaiter {
+        explicit Requirement(Pending *_pending) : ServiceWaiter(), pending(_pending) {
+        }
+
+        virtual void service_available(Service &srv) override;
+
+        Pending *pending;
     };
 
 public:
@@ -61,8 +75,6 @@ public:
     VPE *create(m3::String &&name, const m3::PEDesc &pe, epid_t sep, epid_t rep,
                 capsel_t sgate, uint flags = 0, VPEGroup *group = nullptr);
 
-    void start_pending(const ServiceList &serv);
-
     size_t used() const {
         return _count;
     }
@@ -91,13 +103,13 @@ private:
     vpeid_t get_id();
 
     void add(VPE *vpe);
+    void start_when_ready(VPE *vpe);
     void remove(VPE *vpe);
 
     vpeid_t _next_id;
     VPE **_vpes;
     size_t _count;
     size_t _daemons;
-    m3::SList<Pending> _pending;
     static bool _shutdown;
     static VPEManager *_inst;
 };
@@ -40,16 +40,20 @@ bool FSHandle::load_superblock(Backend *backend, SuperBlock *sb, bool clear) {
     return clear;
 }
 
-FSHandle::FSHandle(Backend *backend, size_t extend, bool clear, bool revoke_first, size_t max_load)
+FSHandle::FSHandle(Backend *backend, size_t extend, bool clear, bool revoke_first, bool inline_files,
+                   size_t max_load, size_t dentries)
     : _backend(backend),
       _clear(load_superblock(backend, &_sb, clear)),
       _revoke_first(revoke_first),
+      _inline(inline_files),
       _extend(extend),
+      _modtime(),
       _filebuffer(_sb.blocksize, backend, max_load),
       _metabuffer(_sb.blocksize, backend),
       _blocks("Blocks", _sb.first_blockbm_block(), &_sb.first_free_block, &_sb.free_blocks,
               _sb.total_blocks, _sb.blockbm_blocks()),
       _inodes("INodes", _sb.first_inodebm_block(), &_sb.first_free_inode, &_sb.free_inodes,
               _sb.total_inodes, _sb.inodebm_blocks()),
-      _files(*this) {
+      _files(*this),
+      _dentries(dentries) {
 }
@@ -24,11 +24,13 @@
 #include "MetaBuffer.h"
 #include "backend/Backend.h"
 #include "data/Allocator.h"
+#include "data/DentryCache.h"
 #include "sess/OpenFiles.h"
 
 class FSHandle {
 public:
-    explicit FSHandle(Backend *backend, size_t extend, bool clear, bool revoke_first, size_t max_load);
+    explicit FSHandle(Backend *backend, size_t extend, bool clear, bool revoke_first, bool inline_files,
+                      size_t max_load, size_t dentries);
 
     m3::SuperBlock &sb() {
         return _sb;
@@ -51,16 +53,32 @@ public:
     OpenFiles &files() {
         return _files;
     }
+    DentryCache &dentries() {
+        return _dentries;
+    }
     bool revoke_first() const {
         return _revoke_first;
     }
     bool clear_blocks() const {
         return _clear;
     }
+    bool inline_files() const {
+        return _inline;
+    }
     size_t extend() const {
         return _extend;
     }
 
+    /**
+     * We have no clock. Thus, the modification time is a logical timestamp that increases with
+     * every modification of a file in this file system instance.
+     *
+     * @return the modification time for the next modified file
+     */
+    m3::time_t next_modtime() {
+        return ++_modtime;
+    }
+
     void flush_buffer() {
         _metabuffer.flush();
         _filebuffer.flush();
@@ -68,6 +86,7 @@ public:
     }
 
     void shutdown() {
+        _dentries.print_stats();
         _backend->shutdown();
     }
 
@@ -77,12 +96,15 @@ private:
     Backend *_backend;
     bool _clear;
     bool _revoke_first;
+    bool _inline;
     size_t _extend;
+    m3::time_t _modtime;
     m3::SuperBlock _sb;
     FileBuffer _filebuffer;
     MetaBuffer _metabuffer;
     Allocator _blocks;
     Allocator _inodes;
     OpenFiles _files;
+    DentryCache _dentries;
     void *_parent_sess;
 };
@@ -81,7 +81,6 @@ public:
     }
 
     void clear_extent(Request &r, m3::Extent *ext, size_t accessed) override {
-        alignas(64) static char zeros[m3::MAX_BLOCK_SIZE];
         capsel_t sel = m3::VPE::self().alloc_sel();
         size_t i = 0;
         while(i < ext->length) {
@@ -90,7 +89,7 @@ public:
                                                            sel, m3::MemGate::RW, accessed,
                                                            false, true);
             m3::MemGate mem = m3::MemGate::bind(sel);
-            mem.write(zeros, bytes, 0);
+            mem.zero(bytes, 0);
             i += bytes / _blocksize;
         }
     }
@@ -60,9 +60,7 @@ public:
     }
 
     void clear_extent(Request &, m3::Extent *ext, size_t) override {
-        alignas(64) static char zeros[m3::MAX_BLOCK_SIZE];
-        for(uint32_t i = 0; i < ext->length; ++i)
-            _mem.write(zeros, _blocksize, (ext->start + i) * _blocksize);
+        _mem.zero(ext->length * _blocksize, ext->start * _blocksize);
     }
 
     void load_sb(m3::SuperBlock &sb) override {
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+#include <base/log/Services.h>
+
+#include "DentryCache.h"
+
+using namespace m3;
+
+DentryCache::DentryCache(size_t capacity)
+    : _capacity(capacity),
+      _entries(capacity ? new Entry[capacity] : nullptr),
+      _tree(),
+      _lru(),
+      _free(),
+      _stats() {
+    for(size_t i = 0; i < _capacity; ++i)
+        _free.append(_entries + i);
+}
+
+DentryCache::~DentryCache() {
+    delete[] _entries;
+}
+
+uint64_t DentryCache::key(inodeno_t dir, const char *name, size_t namelen) {
+    // FNV-1a for the name; the directory goes into the upper half
+    uint32_t hash = 2166136261u;
+    for(size_t i = 0; i < namelen; ++i) {
+        hash ^= static_cast<uint8_t>(name[i]);
+        hash *= 16777619u;
+    }
+    return (static_cast<uint64_t>(dir) << 32) | hash;
+}
+
+bool DentryCache::lookup(inodeno_t dir, const char *name, size_t namelen, inodeno_t *ino) {
+    Entry *e = _tree.find(key(dir, name, namelen));
+    // different names can have the same key
+    if(!e || e->dir != dir || e->namelen != namelen || strncmp(e->name, name, namelen) != 0) {
+        _stats.misses++;
+        return false;
+    }
+
+    _lru.moveToEnd(e);
+    *ino = e->ino;
+    if(e->ino == INVALID_INO)
+        _stats.neg_hits++;
+    else
+        _stats.hits++;
+    return true;
+}
+
+void DentryCache::insert(inodeno_t dir, const char *name, size_t namelen, inodeno_t ino) {
+    if(_capacity == 0 || namelen > MAX_NAME_LEN)
+        return;
+
+    uint64_t k = key(dir, name, namelen);
+    Entry *e = _tree.find(k);
+    if(e) {
+        // on collisions, the new entry replaces the old one
+        _tree.remove(e);
+        _lru.moveToEnd(e);
+    }
+    else {
+        e = _free.removeFirst();
+        if(!e) {
+            e = _lru.removeFirst();
+            _tree.remove(e);
+            _stats.evictions++;
+        }
+        _lru.append(e);
+    }
+
+    e->key(k);
+    e->dir = dir;
+    e->ino = ino;
+    e->namelen = namelen;
+    memcpy(e->name, name, namelen);
+    _tree.insert(e);
+    _stats.inserts++;
+}
+
+void DentryCache::remove(Entry *e) {
+    _tree.remove(e);
+    _lru.remove(e);
+    _free.append(e);
+}
+
+void DentryCache::remove_dir(inodeno_t dir) {
+    for(auto it = _lru.begin(); it != _lru.end(); ) {
+        auto e = &*it++;
+        if(e->dir == dir)
+            remove(e);
+    }
+}
+
+void DentryCache::print_stats() const {
+    size_t lookups = _stats.hits + _stats.neg_hits + _stats.misses;
+    SLOG(FS, "DentryCache: " << lookups << " lookups, " << _stats.hits << " hits, "
+        << _stats.neg_hits << " negative hits, " << _stats.misses << " misses, "
+        << _stats.inserts << " inserts, " << _stats.evictions << " evictions");
+}
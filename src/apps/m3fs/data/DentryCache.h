@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+#pragma once
+
+#include <base/col/DList.h>
+#include <base/col/Treap.h>
+
+#include <fs/internal.h>
+
+/**
+ * A bounded cache for the path lookup that maps a directory inode and a name to the inode of the
+ * entry. Negative entries (INVALID_INO) remember that the name does not exist in the directory.
+ * The least recently used entry is replaced if the cache is full.
+ */
+class DentryCache {
+    static constexpr size_t MAX_NAME_LEN    = 56;
+
+    struct Entry : public m3::TreapNode<Entry, uint64_t>, public m3::DListItem {
+        explicit Entry()
+            : m3::TreapNode<Entry, uint64_t>(0),
+              m3::DListItem(),
+              dir(),
+              ino(),
+              namelen(),
+              name() {
+        }
+
+        m3::inodeno_t dir;
+        m3::inodeno_t ino;
+        size_t namelen;
+        char name[MAX_NAME_LEN];
+    };
+
+public:
+    struct Stats {
+        size_t hits;
+        size_t neg_hits;
+        size_t misses;
+        size_t inserts;
+        size_t evictions;
+    };
+
+    explicit DentryCache(size_t capacity);
+    ~DentryCache();
+
+    /**
+     * Looks up <name> in directory <dir>.
+     *
+     * @param dir the inode number of the directory
+     * @param name the name (not null-terminated)
+     * @param namelen the length of <name>
+     * @param ino will be set to the inode number (INVALID_INO for a negative entry)
+     * @return true if the cache contained an entry
+     */
+    bool lookup(m3::inodeno_t dir, const char *name, size_t namelen, m3::inodeno_t *ino);
+
+    /**
+     * Inserts or updates the entry for <name> in directory <dir>.
+     *
+     * @param dir the inode number of the directory
+     * @param name the name (not null-terminated)
+     * @param namelen the length of <name>
+     * @param ino the inode number or INVALID_INO for a negative entry
+     */
+    void insert(m3::inodeno_t dir, const char *name, size_t namelen, m3::inodeno_t ino);
+
+    /**
+     * Removes all entries within directory <dir>, because it has been removed.
+     *
+     * @param dir the inode number of the directory
+     */
+    void remove_dir(m3::inodeno_t dir);
+
+    const Stats &stats() const {
+        return _stats;
+    }
+
+    void print_stats() const;
+
+private:
+    static uint64_t key(m3::inodeno_t dir, const char *name, size_t namelen);
+    void remove(Entry *e);
+
+    size_t _capacity;
+    Entry *_entries;
+    m3::Treap<Entry> _tree;
+    m3::DList<Entry> _lru;
+    m3::DList<Entry> _free;
+    Stats _stats;
+};
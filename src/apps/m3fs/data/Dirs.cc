@@ -46,39 +46,39 @@ inodeno_t Dirs::search(Request &r, const char *path, bool create) {
     if(*path == '\0')
         return 0;
 
-    INode *inode;
     const char *end;
     size_t namelen;
     inodeno_t ino = 0;
     size_t org_used = r.used_meta();
     while(1) {
-        inode = INodes::get(r, ino);
         // find path component end
         end = path;
         while(*end && *end != '/')
             end++;
 
         namelen = static_cast<size_t>(end - path);
-        DirEntry *e = find_entry(r, inode, path, namelen);
+        inodeno_t next;
+        if(!r.hdl().dentries().lookup(ino, path, namelen, &next)) {
+            INode *inode = INodes::get(r, ino);
+            DirEntry *e = find_entry(r, inode, path, namelen);
+            next = e ? e->nodeno : INVALID_INO;
+            r.hdl().dentries().insert(ino, path, namelen, next);
+            r.pop_meta(r.used_meta() - org_used);
+        }
+
         // in any case, skip trailing slashes (see if(create) ...)
         while(*end == '/')
             end++;
         // stop if the file doesn't exist
-        if(!e) {
-            r.pop_meta();
+        if(next == INVALID_INO)
             break;
-        }
         // if the path is empty, we're done
-        if(!*end) {
-            r.pop_meta(r.used_meta() - org_used);
-            return e->nodeno;
-        }
+        if(!*end)
+            return next;
 
         // to next layer
-        ino = e->nodeno;
+        ino = next;
         path = end;
-
-        r.pop_meta(r.used_meta() - org_used);
     }
 
     if(create) {
@@ -89,6 +89,7 @@ inodeno_t Dirs::search(Request &r, const char *path, bool create) {
         }
 
         // create inode and put a link into the directory
+        INode *inode = INodes::get(r, ino);
         INode *ninode = INodes::create(r, M3FS_IFREG | 0644);
         if(!ninode) {
             return INVALID_INO;
@@ -185,7 +186,11 @@ Errors::Code Dirs::remove(Request &r, const char *path) {
     assert(inode->links == 2);
     // ensure that the inode is removed
     inode->links--;
-    return unlink(r, path, true);
+    Errors::Code res = unlink(r, path, true);
+    // the inode number might be reused; forget about the entries within the directory
+    if(res == Errors::NONE)
+        r.hdl().dentries().remove_dir(ino);
+    return res;
 }
 
 Errors::Code Dirs::link(Request &r, const char *oldpath, const char *newpath) {
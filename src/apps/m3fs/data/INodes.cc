@@ -24,6 +24,10 @@
 
 using namespace m3;
 
+static void revoke_mem(capsel_t sel) {
+    VPE::self().revoke(KIF::CapRngDesc(KIF::CapRngDesc::OBJ, sel, 1));
+}
+
 INode *INodes::create(Request &r, mode_t mode) {
     inodeno_t ino = r.hdl().inodes().alloc(r);
     if(ino == 0) {
@@ -35,7 +39,9 @@ INode *INodes::create(Request &r, mode_t mode) {
     inode->inode = ino;
     inode->devno = 0; /* TODO */
     inode->mode = mode;
-    mark_dirty(r, ino);
+    if(M3FS_ISREG(mode) && r.hdl().inline_files())
+        inode->flags = INODE_INLINE;
+    mark_modified(r, inode);
     return inode;
 }
 
@@ -64,7 +70,7 @@ void INodes::stat(Request &, const m3::INode *inode, FileInfo &info) {
     info.lastaccess = inode->lastaccess;
     info.lastmod = inode->lastmod;
     info.extents = inode->extents;
-    info.firstblock = inode->direct[0].start;
+    info.firstblock = (inode->flags & INODE_INLINE) ? 0 : inode->direct[0].start;
 }
 
 void INodes::mark_dirty(Request &r, inodeno_t ino) {
@@ -72,6 +78,11 @@ void INodes::mark_dirty(Request &r, inodeno_t ino) {
     r.hdl().metabuffer().mark_dirty(r.hdl().sb().first_inode_block() + ino / inos_per_blk);
 }
 
+void INodes::mark_modified(Request &r, INode *inode) {
+    inode->lastmod = r.hdl().next_modtime();
+    mark_dirty(r, inode->inode);
+}
+
 void INodes::sync_metadata(Request &r, INode *inode) {
     size_t org_used = r.used_meta();
     foreach_extent(r, inode, ext) {
@@ -85,6 +96,10 @@ void INodes::sync_metadata(Request &r, INode *inode) {
 
 size_t INodes::get_extent_mem(Request &r, INode *inode, size_t extent, size_t extoff, size_t *extlen,
                               int perms, capsel_t sel, bool dirty, size_t accessed) {
+    // note that this also prevents us from interpreting inline data as extents
+    if(extent >= inode->extents)
+        return 0;
+
     Extent *indir = nullptr;
     Extent *ext = get_extent(r, inode, extent, &indir, false);
     if(ext == nullptr || ext->length == 0)
@@ -109,7 +124,7 @@ size_t INodes::get_extent_mem(Request &r, INode *inode, size_t extent, size_t ex
 }
 
 size_t INodes::req_append(Request &r, INode *inode, size_t i, size_t extoff, size_t *extlen,
-                          capsel_t sel, int perm, Extent *ext, size_t accessed) {
+                          capsel_t sel, int perm, Extent *ext, uint32_t blocks, size_t accessed) {
     bool load = true;
     if(i < inode->extents) {
         Extent *indir = nullptr;
@@ -117,12 +132,15 @@ size_t INodes::req_append(Request &r, INode *inode, size_t i, size_t extoff, siz
         assert(ext != nullptr);
     }
     else {
-        fill_extent(r, nullptr, ext, r.hdl().extend(), accessed);
+        // <ext> might contain blocks that have been reserved before
+        if(ext->length == 0) {
+            fill_extent(r, nullptr, ext, blocks, accessed);
+            if(Errors::occurred())
+                return 0;
+        }
         // this is a new extent we dont have to load it
         if(!r.hdl().clear_blocks())
             load = false;
-        if(Errors::occurred())
-            return 0;
         extoff = 0;
     }
 
@@ -309,6 +327,13 @@ size_t INodes::seek(Request &r, INode *inode, size_t &off, int whence, size_t &e
     if(whence == M3FS_SEEK_END) {
         // TODO support off != 0
         assert(off == 0);
+        // inline data is put into the first extent on conversion, so that we can pretend it's there
+        if(inode->flags & INODE_INLINE) {
+            extent = 0;
+            extoff = inode->size;
+            return inode->size;
+        }
+
         extent = inode->extents;
         extoff = 0;
         // determine extent offset
@@ -354,6 +379,15 @@ size_t INodes::seek(Request &r, INode *inode, size_t &off, int whence, size_t &e
 void INodes::truncate(Request &r, INode *inode, size_t extent, size_t extoff) {
     uint32_t blocksize = r.hdl().sb().blocksize;
 
+    if(inode->flags & INODE_INLINE) {
+        assert(extent == 0);
+        if(extoff < inode->size) {
+            inode->size = extoff;
+            mark_modified(r, inode);
+        }
+        return;
+    }
+
     Extent *indir = nullptr;
     if(inode->extents > 0) {
         // erase everything up to <extent>
@@ -390,6 +424,186 @@ void INodes::truncate(Request &r, INode *inode, size_t extent, size_t extoff) {
                 }
             }
         }
-        mark_dirty(r, inode->inode);
+
+        // empty files start over with inline data
+        if(inode->extents == 0 && M3FS_ISREG(inode->mode) && r.hdl().inline_files()) {
+            memset(inode->inline_data(), 0, INODE_INLINE_SIZE);
+            inode->flags |= INODE_INLINE;
+        }
+        mark_modified(r, inode);
+    }
+}
+
+Errors::Code INodes::convert_inline(Request &r, INode *inode, Extent *prealloc, size_t accessed) {
+    assert(inode->flags & INODE_INLINE);
+
+    Extent e = {0, 0};
+    size_t size = inode->size;
+    if(size > 0) {
+        // take the first reserved block, if there is any
+        if(prealloc && prealloc->length > 0) {
+            e.start = prealloc->start++;
+            e.length = 1;
+            prealloc->length--;
+        }
+        else {
+            fill_extent(r, nullptr, &e, 1, accessed);
+            if(Errors::occurred())
+                return Errors::last;
+        }
+
+        // we overwrite the data anyway, so don't load the block
+        capsel_t sel = VPE::self().alloc_sel();
+        size_t bytes = r.hdl().backend()->get_filedata(r, &e, 0, MemGate::W, sel, true, false, accessed);
+        Errors::Code res = Errors::NO_SPACE;
+        if(bytes > 0)
+            res = MemGate::bind(sel).write(inode->inline_data(), size, 0);
+        revoke_mem(sel);
+        if(res != Errors::NONE) {
+            r.hdl().blocks().free(r, e.start, e.length);
+            return res;
+        }
+    }
+
+    // the data area contains the extents from now on
+    memset(inode->inline_data(), 0, INODE_INLINE_SIZE);
+    inode->flags &= static_cast<uint8_t>(~INODE_INLINE);
+    if(e.length > 0) {
+        size_t prev_ext_len;
+        // the first extent is always a direct one
+        UNUSED Errors::Code res = append_extent(r, inode, &e, &prev_ext_len);
+        assert(res == Errors::NONE);
+    }
+    mark_dirty(r, inode->inode);
+    return Errors::NONE;
+}
+
+size_t INodes::copy_range(Request &r, INode *src, INode *dst, size_t off, size_t count) {
+    alignas(64) static char buffer[MAX_BLOCK_SIZE];
+    uint32_t blocksize = r.hdl().sb().blocksize;
+
+    if(off >= src->size)
+        return 0;
+    count = Math::min(count, static_cast<size_t>(src->size - off));
+
+    if(dst->flags & INODE_INLINE) {
+        // small files can be copied within the inodes
+        if((src->flags & INODE_INLINE) && dst->size + count <= INODE_INLINE_SIZE) {
+            memcpy(dst->inline_data() + dst->size, src->inline_data() + off, count);
+            dst->size += count;
+            mark_modified(r, dst);
+            return count;
+        }
+
+        if(dst->size == 0) {
+            Errors::Code res = convert_inline(r, dst, nullptr, 1);
+            if(res != Errors::NONE) {
+                Errors::last = res;
+                return 0;
+            }
+        }
+    }
+
+    // new extents are appended to <dst>, so that it has to end at a block boundary
+    if(dst->size % blocksize != 0) {
+        Errors::last = Errors::INV_ARGS;
+        return 0;
+    }
+
+    capsel_t ssel = ObjCap::INVALID;
+    capsel_t dsel = ObjCap::INVALID;
+    // the file range that is currently accessible via <ssel>
+    size_t sbegin = 0, send = 0;
+    size_t copied = 0;
+    while(copied < count) {
+        size_t blocks = (count - copied + blocksize - 1) / blocksize;
+        Extent e = {0, 0};
+        fill_extent(r, nullptr, &e, Math::min(blocks, r.hdl().extend()), 1);
+        if(Errors::occurred())
+            break;
+
+        size_t elen = Math::min(static_cast<size_t>(e.length * blocksize), count - copied);
+        size_t eoff = 0;
+        while(eoff < elen) {
+            // get memory for the next part of the new extent; as we override it, don't load it
+            if(dsel != ObjCap::INVALID)
+                revoke_mem(dsel);
+            dsel = VPE::self().alloc_sel();
+            size_t dbytes = r.hdl().backend()->get_filedata(r, &e, eoff, MemGate::W, dsel,
+                                                            true, false, 1);
+            if(dbytes == 0) {
+                Errors::last = Errors::NO_SPACE;
+                break;
+            }
+
+            MemGate dmem = MemGate::bind(dsel);
+            size_t dbase = eoff;
+            size_t dend = eoff + Math::min(dbytes, elen - eoff);
+            while(eoff < dend) {
+                size_t pos = off + copied;
+                if(src->flags & INODE_INLINE) {
+                    size_t amount = dend - eoff;
+                    if(dmem.write(src->inline_data() + pos, amount, eoff - dbase) != Errors::NONE)
+                        break;
+                    eoff += amount;
+                    copied += amount;
+                    continue;
+                }
+
+                if(pos >= send) {
+                    size_t extent, extoff, extlen, tmp = pos;
+                    size_t extpos = seek(r, src, tmp, M3FS_SEEK_SET, extent, extoff);
+                    if(ssel != ObjCap::INVALID)
+                        revoke_mem(ssel);
+                    ssel = VPE::self().alloc_sel();
+                    size_t sbytes = get_extent_mem(r, src, extent, extoff, &extlen, MemGate::R,
+                                                   ssel, false, 1);
+                    if(sbytes == 0) {
+                        Errors::last = Errors::END_OF_FILE;
+                        break;
+                    }
+                    // the memory capability starts at the block containing <extoff>
+                    sbegin = extpos + extoff - extoff % blocksize;
+                    send = sbegin + sbytes;
+                }
+
+                MemGate smem = MemGate::bind(ssel);
+                size_t amount = Math::min(Math::min(send - pos, dend - eoff), sizeof(buffer));
+                if(smem.read(buffer, amount, pos - sbegin) != Errors::NONE ||
+                   dmem.write(buffer, amount, eoff - dbase) != Errors::NONE)
+                    break;
+                eoff += amount;
+                copied += amount;
+            }
+            if(Errors::occurred())
+                break;
+        }
+
+        // append the used part of the extent to the file and free the rest
+        size_t used = (eoff + blocksize - 1) / blocksize;
+        if(used < e.length)
+            r.hdl().blocks().free(r, e.start + used, e.length - used);
+        if(used > 0) {
+            size_t prev_ext_len;
+            e.length = used;
+            Errors::Code res = append_extent(r, dst, &e, &prev_ext_len);
+            if(res != Errors::NONE) {
+                r.hdl().blocks().free(r, e.start, e.length);
+                copied -= eoff;
+                Errors::last = res;
+            }
+            else {
+                dst->size += eoff;
+                mark_modified(r, dst);
+            }
+        }
+        if(Errors::occurred())
+            break;
     }
+
+    if(ssel != ObjCap::INVALID)
+        revoke_mem(ssel);
+    if(dsel != ObjCap::INVALID)
+        revoke_mem(dsel);
+    return copied;
 }
@@ -56,7 +56,8 @@ public:
     static size_t get_extent_mem(Request &r, m3::INode *inode, size_t extent, size_t extoff,
                                  size_t *extlen, int perms, capsel_t sel, bool dirty, size_t accessed);
     static size_t req_append(Request &r, m3::INode *inode, size_t i, size_t extoff, size_t *extlen,
-                             capsel_t sel, int perm, m3::Extent *ext, size_t accessed);
+                             capsel_t sel, int perm, m3::Extent *ext, uint32_t blocks,
+                             size_t accessed);
     static m3::Errors::Code append_extent(Request &r, m3::INode *inode, m3::Extent *next,
                                           size_t *prev_ext_len);
 
@@ -65,7 +66,11 @@ public:
     static void fill_extent(Request &r, m3::INode *inode, m3::Extent *ext, uint32_t blocks, size_t accessed);
 
     static void truncate(Request &r, m3::INode *inode, size_t extent, size_t extoff);
+    static m3::Errors::Code convert_inline(Request &r, m3::INode *inode, m3::Extent *prealloc,
+                                           size_t accessed);
+    static size_t copy_range(Request &r, m3::INode *src, m3::INode *dst, size_t off, size_t count);
 
     static void mark_dirty(Request &r, m3::inodeno_t ino);
+    static void mark_modified(Request &r, m3::INode *inode);
     static void sync_metadata(Request &r, m3::INode *inode);
 };
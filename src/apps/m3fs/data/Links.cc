@@ -70,6 +70,7 @@ found:
 
     inode->links++;
     INodes::mark_dirty(r, inode->inode);
+    r.hdl().dentries().insert(dir->inode, name, namelen, inode->inode);
     return Errors::NONE;
 }
 
@@ -101,6 +102,7 @@ Errors::Code Links::remove(Request &r, INode *dir, const char *name, size_t name
                         }
                     }
                     r.hdl().metabuffer().mark_dirty(bno);
+                    r.hdl().dentries().insert(dir->inode, name, namelen, INVALID_INO);
 
                     // reduce links and free, if necessary
                     if(--inode->links == 0)
@@ -51,27 +51,32 @@ static Server<M3FSRequestHandler> *srv;
 
 class M3FSRequestHandler : public base_class {
 public:
+    // the number of requests to handle per WorkLoop tick
+    static constexpr uint MSG_BATCH = 8;
+
     explicit M3FSRequestHandler(Backend *backend, size_t extend, bool clear,
-                                bool revoke_first, size_t max_load)
+                                bool revoke_first, bool inline_files, size_t max_load,
+                                size_t dentries)
         : base_class(),
           _rgate(RecvGate::create(nextlog2<32 * M3FSSession::MSG_SIZE>::val,
                                   nextlog2<M3FSSession::MSG_SIZE>::val)),
-          _handle(backend, extend, clear, revoke_first, max_load) {
-        add_operation(M3FS::OPEN_PRIV, &M3FSRequestHandler::open_private_file);
-        add_operation(M3FS::CLOSE_PRIV, &M3FSRequestHandler::close_private_file);
-        add_operation(M3FS::NEXT_IN, &M3FSRequestHandler::next_in);
-        add_operation(M3FS::NEXT_OUT, &M3FSRequestHandler::next_out);
-        add_operation(M3FS::COMMIT, &M3FSRequestHandler::commit);
-        add_operation(M3FS::FSTAT, &M3FSRequestHandler::fstat);
-        add_operation(M3FS::SEEK, &M3FSRequestHandler::seek);
-        add_operation(M3FS::STAT, &M3FSRequestHandler::stat);
-        add_operation(M3FS::MKDIR, &M3FSRequestHandler::mkdir);
-        add_operation(M3FS::RMDIR, &M3FSRequestHandler::rmdir);
-        add_operation(M3FS::LINK, &M3FSRequestHandler::link);
-        add_operation(M3FS::UNLINK, &M3FSRequestHandler::unlink);
-
-        using std::placeholders::_1;
-        _rgate.start(std::bind(&M3FSRequestHandler::handle_message, this, _1));
+          _handle(backend, extend, clear, revoke_first, inline_files, max_load, dentries) {
+        add_operation<&M3FSRequestHandler::open_private_file>(M3FS::OPEN_PRIV);
+        add_operation<&M3FSRequestHandler::close_private_file>(M3FS::CLOSE_PRIV);
+        add_operation<&M3FSRequestHandler::next_in>(M3FS::NEXT_IN);
+        add_operation<&M3FSRequestHandler::next_out>(M3FS::NEXT_OUT);
+        add_operation<&M3FSRequestHandler::commit>(M3FS::COMMIT);
+        add_operation<&M3FSRequestHandler::fstat>(M3FS::FSTAT);
+        add_operation<&M3FSRequestHandler::seek>(M3FS::SEEK);
+        add_operation<&M3FSRequestHandler::stat>(M3FS::STAT);
+        add_operation<&M3FSRequestHandler::mkdir>(M3FS::MKDIR);
+        add_operation<&M3FSRequestHandler::rmdir>(M3FS::RMDIR);
+        add_operation<&M3FSRequestHandler::link>(M3FS::LINK);
+        add_operation<&M3FSRequestHandler::unlink>(M3FS::UNLINK);
+        add_operation<&M3FSRequestHandler::copy_range>(M3FS::COPY_RANGE);
+        add_operation<&M3FSRequestHandler::readdir_plus>(M3FS::READDIR_PLUS);
+
+        _rgate.start<base_class, &base_class::handle_message>(this, MSG_BATCH);
     }
 
     virtual Errors::Code open(M3FSSession **sess, capsel_t srv_sel, word_t) override {
@@ -95,6 +100,17 @@ public:
     }
 
     virtual Errors::Code delegate(M3FSSession *sess, KIF::Service::ExchangeData &data) override {
+        // a memory capability for READDIR_PLUS, marked by the operation and followed by its size
+        if(sess->type() == M3FSSession::FILE && data.args.count > 0) {
+            if(data.caps != 1 || data.args.count != 2 || data.args.vals[0] != M3FS::READDIR_PLUS)
+                return Errors::NOT_SUP;
+            capsel_t sel = VPE::self().alloc_sel();
+            static_cast<M3FSFileSession *>(sess)->set_dirbuf(sel, data.args.vals[1]);
+            data.caps = KIF::CapRngDesc(KIF::CapRngDesc::OBJ, sel, data.caps).value();
+            data.args.count = 0;
+            return Errors::NONE;
+        }
+
         if(data.args.count != 0)
             return Errors::NOT_SUP;
 
@@ -186,6 +202,16 @@ public:
         sess->unlink(is);
     }
 
+    void copy_range(GateIStream &is) {
+        M3FSSession *sess = is.label<M3FSSession *>();
+        sess->copy_range(is);
+    }
+
+    void readdir_plus(GateIStream &is) {
+        M3FSSession *sess = is.label<M3FSSession *>();
+        sess->readdir_plus(is);
+    }
+
 private:
     RecvGate _rgate;
     //MemGate _mem;
@@ -194,15 +220,17 @@ private:
 
 NORETURN static void usage(const char *name) {
     cerr << "Usage: " << name
-         << " [-n <name>] [-s <sel>] [-e <blocks>] [-c] [-r] [-b <blocks>]\n"
-         << " [-o <offset>] (disk <dev>|mem <fssize>)\n";
+         << " [-n <name>] [-s <sel>] [-e <blocks>] [-c] [-r] [-i] [-b <blocks>]\n"
+         << " [-o <offset>] [-d <entries>] (disk <dev>|mem <fssize>)\n";
     cerr << "  -n: the name of the service (m3fs by default)\n";
     cerr << "  -s: don't create service, use selectors <sel>..<sel+1>\n";
     cerr << "  -e: the number of blocks to extend files when appending\n";
     cerr << "  -c: clear allocated blocks\n";
     cerr << "  -r: revoke first, reply afterwards\n";
+    cerr << "  -i: don't store the content of new small files in their inode\n";
     cerr << "  -b: the maximum number of blocks loaded from the disk\n";
     cerr << "  -o: the file system offset in DRAM\n";
+    cerr << "  -d: the number of entries in the path lookup cache (0 = disabled)\n";
     exit(1);
 }
 
@@ -210,14 +238,16 @@ int main(int argc, char *argv[]) {
     const char *name  = "m3fs";
     size_t extend     = 128;
     size_t max_load   = 128;
+    size_t dentries   = 512;
     bool clear        = false;
     bool revoke_first = false;
+    bool inline_files = true;
     capsel_t sels     = ObjCap::INVALID;
     epid_t ep         = EP_COUNT;
     goff_t fs_offset  = FS_IMG_OFFSET;
 
     int opt;
-    while((opt = CmdArgs::get(argc, argv, "n:s:e:crb:o:")) != -1) {
+    while((opt = CmdArgs::get(argc, argv, "n:s:e:crib:o:d:")) != -1) {
         switch(opt) {
             case 'n': name = CmdArgs::arg; break;
             case 's': {
@@ -229,8 +259,10 @@ int main(int argc, char *argv[]) {
             case 'e': extend = IStringStream::read_from<size_t>(CmdArgs::arg); break;
             case 'c': clear = true; break;
             case 'r': revoke_first = true; break;
+            case 'i': inline_files = false; break;
             case 'b': max_load = IStringStream::read_from<size_t>(CmdArgs::arg); break;
             case 'o': fs_offset = IStringStream::read_from<goff_t>(CmdArgs::arg); break;
+            case 'd': dentries = IStringStream::read_from<size_t>(CmdArgs::arg); break;
             default: usage(argv[0]);
         }
     }
@@ -251,7 +283,8 @@ int main(int argc, char *argv[]) {
     else
         usage(argv[0]);
 
-    auto hdl    = new M3FSRequestHandler(backend, extend, clear, revoke_first, max_load);
+    auto hdl    = new M3FSRequestHandler(backend, extend, clear, revoke_first, inline_files,
+                                         max_load, dentries);
     if(sels != ObjCap::INVALID)
         srv = new Server<M3FSRequestHandler>(sels, ep, hdl);
     else
@@ -23,6 +23,7 @@
 #include <m3/session/M3FS.h>
 
 #include "../FSHandle.h"
+#include "../data/Dirs.h"
 #include "../data/INodes.h"
 #include "MetaSession.h"
 
@@ -42,12 +43,18 @@ M3FSFileSession::M3FSFileSession(FSHandle &handle, capsel_t srv_sel, M3FSMetaSes
       _moved_forward(false),
       _appending(),
       _append_ext(),
+      _overwriting(),
+      _inline_win(),
+      _inline_writing(),
       _last(ObjCap::INVALID),
       _epcap(ObjCap::INVALID),
       _sgate(srv_sel == ObjCap::INVALID
         ? nullptr
         : new m3::SendGate(m3::SendGate::create(&meta->rgate(), reinterpret_cast<label_t>(this),
                                                 MSG_SIZE, nullptr, sel() + 1))),
+      _dirbuf(),
+      _dirbuf_size(),
+      _dirbuf_checked(),
       _oflags(flags),
       _filename(filename),
       _ino(ino),
@@ -62,11 +69,16 @@ M3FSFileSession::~M3FSFileSession() {
     Request r(hdl());
 
     delete _sgate;
+    delete _dirbuf;
 
     if(_append_ext) {
         hdl().blocks().free(r, _append_ext->start, _append_ext->length);
         delete _append_ext;
     }
+    if(_inline_writing)
+        hdl().files().get_file(_ino)->appending = false;
+    if(_overwriting)
+        commit_overwrite(r, INodes::get(r, _ino));
 
     hdl().files().rem_sess(this);
     _meta->remove_file(this);
@@ -100,6 +112,15 @@ Errors::Code M3FSFileSession::get_mem(KIF::Service::ExchangeData &data) {
     INode *inode = INodes::get(r, _ino);
     assert(inode != nullptr);
 
+    // memory can only be handed out for extents
+    if(inode->flags & INODE_INLINE) {
+        if(hdl().files().get_file(_ino)->appending)
+            return Errors::EXISTS;
+        Errors::Code res = INodes::convert_inline(r, inode, nullptr, _accessed);
+        if(res != Errors::NONE)
+            return res;
+    }
+
     // determine extent from byte offset
     size_t firstOff = offset;
     size_t ext_off;
@@ -154,10 +175,42 @@ void M3FSFileSession::next_in_out(GateIStream &is, bool out) {
             return;
         }
     }
+    if(_inline_writing)
+        commit_inline(r, inode, _lastbytes, nullptr);
+    if(_overwriting)
+        commit_overwrite(r, inode);
 
     if(_accessed < 31)
         _accessed++;
 
+    if(inode->flags & INODE_INLINE) {
+        // stay inline as long as the data fits into the inode
+        if(!out || _fileoff < INODE_INLINE_SIZE) {
+            next_inline(is, inode, out);
+            return;
+        }
+
+        OpenFiles::OpenFile *of = hdl().files().get_file(_ino);
+        if(of->appending) {
+            PRINT(this, "append already in progress");
+            reply_error(is, Errors::EXISTS);
+            return;
+        }
+
+        // reserve the blocks for the following appends as well to keep the file contiguous
+        if(of->prealloc.length == 0)
+            INodes::fill_extent(r, nullptr, &of->prealloc, of->window, _accessed);
+
+        // the inline data becomes the first extent, which <_extent> and <_extoff> point to already
+        Errors::Code res = INodes::convert_inline(r, inode, &of->prealloc, _accessed);
+        if(res != Errors::NONE) {
+            PRINT(this, "converting inline data failed: " << Errors::to_string(res));
+            reply_error(is, res);
+            return;
+        }
+    }
+    _inline_win = false;
+
     Errors::last = Errors::NONE;
     capsel_t sel = VPE::self().alloc_sel();
     size_t len;
@@ -179,11 +232,18 @@ void M3FSFileSession::next_in_out(GateIStream &is, bool out) {
             _fileoff = INodes::seek(r, inode, off, M3FS_SEEK_END, _extent, _extoff);
         }
 
+        // if we need a new extent, continue with the blocks reserved by the last append
         Extent e = {0, 0};
+        if(_extent >= inode->extents) {
+            e = of->prealloc;
+            of->prealloc = Extent{0, 0};
+        }
         len = INodes::req_append(r, inode, _extent, _extoff, &extlen, sel,
-                                 _oflags & MemGate::RWX, &e, _accessed);
+                                 _oflags & MemGate::RWX, &e, of->window, _accessed);
         if(Errors::occurred()) {
             PRINT(this, "append failed: " << Errors::to_string(Errors::last));
+            if(e.length > 0)
+                of->prealloc = e;
             reply_error(is, Errors::last);
             return;
         }
@@ -201,6 +261,7 @@ void M3FSFileSession::next_in_out(GateIStream &is, bool out) {
             reply_error(is, Errors::last);
             return;
         }
+        _overwriting = out && len > 0;
     }
 
     _lastoff = _extoff;
@@ -237,16 +298,64 @@ void M3FSFileSession::next_in_out(GateIStream &is, bool out) {
     PRINT(this, "file::next_" << (out ? "out" : "in")
                               << "() -> (" << _lastoff << ", " << _lastbytes << ")");
 
+    reply_next(is, sel, capoff);
+}
+
+void M3FSFileSession::next_inline(GateIStream &is, INode *inode, bool out) {
+    // writes may use the whole inline area, reads stop at the end of the file
+    size_t end = out ? static_cast<size_t>(INODE_INLINE_SIZE) : inode->size;
+    size_t len = _fileoff < end ? end - _fileoff : 0;
+
+    if(out && len > 0) {
+        OpenFiles::OpenFile *of = hdl().files().get_file(_ino);
+        assert(of != nullptr);
+        if(of->appending) {
+            PRINT(this, "append already in progress");
+            reply_error(is, Errors::EXISTS);
+            return;
+        }
+
+        // prevent concurrent writes and the conversion until we got the data back
+        of->appending = true;
+    }
+
+    _inline_win = true;
+    _inline_writing = out && len > 0;
+    _lastoff = _fileoff;
+    _lastbytes = len;
+    _fileoff += len;
+    // on conversion, the inline data becomes the first extent
+    _extent = 0;
+    _extoff = _fileoff;
+
+    PRINT(this, "file::next_" << (out ? "out" : "in")
+                              << "() -> inline (" << _lastoff << ", " << _lastbytes << ")");
+
+    // inline windows need no memory capability
+    if(_last != ObjCap::INVALID) {
+        VPE::self().revoke(KIF::CapRngDesc(KIF::CapRngDesc::OBJ, _last, 1));
+        _last = ObjCap::INVALID;
+    }
+
+    // the data is part of the reply, which also tells the client that the window is inline.
+    // written data is sent back with the commit.
+    StaticGateOStream<ostreamsize<Errors::Code, size_t, size_t, bool, size_t>() + INODE_INLINE_SIZE> os;
+    os << Errors::NONE << static_cast<size_t>(0) << _lastbytes << true;
+    os << String(inode->inline_data() + _lastoff, out ? 0 : len);
+    is.reply(os);
+}
+
+void M3FSFileSession::reply_next(GateIStream &is, capsel_t sel, size_t capoff) {
     if(hdl().revoke_first()) {
         // revoke last mem cap and remember new one
         if(_last != ObjCap::INVALID)
             VPE::self().revoke(KIF::CapRngDesc(KIF::CapRngDesc::OBJ, _last, 1));
         _last = sel;
 
-        reply_vmsg(is, Errors::NONE, capoff, _lastbytes);
+        reply_vmsg(is, Errors::NONE, capoff, _lastbytes, false);
     }
     else {
-        reply_vmsg(is, Errors::NONE, capoff, _lastbytes);
+        reply_vmsg(is, Errors::NONE, capoff, _lastbytes, false);
 
         if(_last != ObjCap::INVALID)
             VPE::self().revoke(KIF::CapRngDesc(KIF::CapRngDesc::OBJ, _last, 1));
@@ -264,7 +373,11 @@ void M3FSFileSession::next_out(GateIStream &is) {
 
 void M3FSFileSession::commit(GateIStream &is) {
     size_t nbytes;
+    String data;
     is >> nbytes;
+    // the data of inline windows is transferred within the message
+    if(_inline_writing && is.remaining() > 0)
+        is >> data;
 
     Request r(hdl());
 
@@ -272,7 +385,7 @@ void M3FSFileSession::commit(GateIStream &is) {
                                        << "file[path=" << _filename << ", fileoff=" << _fileoff
                                        << ", ext=" << _extent << ", extoff=" << _extoff << "]");
 
-    if(nbytes == 0 || nbytes > _lastbytes) {
+    if(nbytes == 0 || nbytes > _lastbytes || (_inline_writing && data.length() != nbytes)) {
         reply_error(is, Errors::INV_ARGS);
         return;
     }
@@ -281,10 +394,16 @@ void M3FSFileSession::commit(GateIStream &is) {
     assert(inode != nullptr);
 
     Errors::Code res;
-    if(_appending)
+    if(_inline_win) {
+        commit_inline(r, inode, nbytes, data.c_str());
+        res = Errors::NONE;
+    }
+    else if(_appending)
         res = commit(r, inode, nbytes);
     else {
         res = Errors::NONE;
+        if(_overwriting)
+            commit_overwrite(r, inode);
         if(_moved_forward && _lastoff + nbytes < _extlen)
             _extent--;
         if(nbytes < _lastbytes)
@@ -332,6 +451,107 @@ void M3FSFileSession::fstat(GateIStream &is) {
     reply_vmsg(is, Errors::NONE, info);
 }
 
+void M3FSFileSession::readdir_plus(GateIStream &is) {
+    size_t pos;
+    is >> pos;
+
+    Request r(hdl());
+
+    PRINT(this, "file::readdir_plus(path=" << _filename << ", pos=" << pos << ")");
+
+    if(!_dirbuf) {
+        reply_error(is, Errors::INV_STATE);
+        return;
+    }
+
+    // the size is given by the client; let the kernel check whether the capability covers it
+    if(!_dirbuf_checked) {
+        capsel_t sel = VPE::self().alloc_sel();
+        if(Syscalls::get().derivemem(sel, _dirbuf->sel(), 0, _dirbuf_size, MemGate::W) != Errors::NONE) {
+            PRINT(this, "readdir_plus: buffer is smaller than " << _dirbuf_size << " bytes");
+            reply_error(is, Errors::INV_ARGS);
+            return;
+        }
+        VPE::self().revoke(KIF::CapRngDesc(KIF::CapRngDesc::OBJ, sel, 1));
+        _dirbuf_checked = true;
+    }
+
+    INode *inode = INodes::get(r, _ino);
+    assert(inode != nullptr);
+    if(!M3FS_ISDIR(inode->mode)) {
+        reply_error(is, Errors::IS_NO_DIR);
+        return;
+    }
+
+    // collect the entries in small chunks and write each chunk into the client's buffer
+    DirEntryInfo entries[8];
+    uint32_t blocksize = hdl().sb().blocksize;
+    size_t max = _dirbuf_size / sizeof(DirEntryInfo);
+    size_t first_blk = pos / blocksize;
+    size_t first_off = pos % blocksize;
+    size_t count = 0, buffered = 0;
+    size_t blk = 0;
+    size_t org_used = r.used_meta();
+    Errors::Code res = Errors::NONE;
+    foreach_extent(r, inode, ext) {
+        foreach_block(ext, bno) {
+            if(blk < first_blk) {
+                blk++;
+                continue;
+            }
+
+            size_t off = 0;
+            foreach_direntry(r, bno, e) {
+                size_t eoff = off;
+                off += e->next;
+                if(blk == first_blk && eoff < first_off)
+                    continue;
+
+                // no space left? continue at this entry next time
+                if(count == max) {
+                    pos = blk * blocksize + eoff;
+                    r.pop_meta(r.used_meta() - org_used);
+                    goto done;
+                }
+
+                DirEntryInfo &info = entries[buffered++];
+                size_t namelen = Math::min(static_cast<size_t>(e->namelen), sizeof(info.name) - 1);
+                memcpy(info.name, e->name, namelen);
+                info.name[namelen] = '\0';
+                INodes::stat(r, INodes::get(r, e->nodeno), info.info);
+                r.pop_meta();
+                count++;
+
+                if(buffered == ARRAY_SIZE(entries)) {
+                    res = _dirbuf->write(entries, buffered * sizeof(*entries),
+                                         (count - buffered) * sizeof(*entries));
+                    buffered = 0;
+                    if(res != Errors::NONE) {
+                        r.pop_meta(r.used_meta() - org_used);
+                        goto done;
+                    }
+                }
+            }
+            blk++;
+            r.pop_meta();
+        }
+        r.pop_meta(r.used_meta() - org_used);
+    }
+    pos = blk * blocksize;
+
+done:
+    if(res == Errors::NONE && buffered > 0)
+        res = _dirbuf->write(entries, buffered * sizeof(*entries), (count - buffered) * sizeof(*entries));
+    if(res != Errors::NONE) {
+        PRINT(this, "readdir_plus: writing entries failed: " << Errors::to_string(res));
+        reply_error(is, res);
+        return;
+    }
+
+    PRINT(this, "file::readdir_plus -> (" << count << ", " << pos << ")");
+    reply_vmsg(is, Errors::NONE, count, pos);
+}
+
 Errors::Code M3FSFileSession::commit(Request &r, INode *inode, size_t submit) {
     assert(submit > 0);
 
@@ -342,6 +562,9 @@ Errors::Code M3FSFileSession::commit(Request &r, INode *inode, size_t submit) {
     // adjust file position.
     _fileoff -= _lastbytes - submit;
 
+    OpenFiles::OpenFile *ofile = r.hdl().files().get_file(_ino);
+    assert(ofile != nullptr);
+
     // add new extent?
     size_t lastoff = _lastoff;
     bool truncated = submit < _lastbytes;
@@ -357,9 +580,15 @@ Errors::Code M3FSFileSession::commit(Request &r, INode *inode, size_t submit) {
         if(res != Errors::NONE)
             return res;
 
-        // free superfluous blocks
-        if(old_len > blocks)
-            r.hdl().blocks().free(r, _append_ext->start + blocks, old_len - blocks);
+        // keep superfluous blocks for the next append, so that it can continue contiguously.
+        // if the writer used all blocks, allocate more next time.
+        if(old_len > blocks) {
+            assert(ofile->prealloc.length == 0);
+            ofile->prealloc.start = static_cast<blockno_t>(_append_ext->start + blocks);
+            ofile->prealloc.length = static_cast<uint32_t>(old_len - blocks);
+        }
+        else if(ofile->window < r.hdl().extend() * OpenFiles::MAX_WINDOW_FACTOR)
+            ofile->window *= 2;
 
         _extlen = blocks * blocksize;
         // have we appended the new extent to the previous extent?
@@ -382,11 +611,9 @@ Errors::Code M3FSFileSession::commit(Request &r, INode *inode, size_t submit) {
 
     // change size
     inode->size += submit;
-    INodes::mark_dirty(r, inode->inode);
+    INodes::mark_modified(r, inode);
 
     // stop appending
-    OpenFiles::OpenFile *ofile = r.hdl().files().get_file(_ino);
-    assert(ofile != nullptr);
     assert(ofile->appending);
     ofile->appending = false;
 
@@ -394,3 +621,34 @@ Errors::Code M3FSFileSession::commit(Request &r, INode *inode, size_t submit) {
     _appending = false;
     return Errors::NONE;
 }
+
+void M3FSFileSession::commit_inline(Request &r, INode *inode, size_t submit, const char *data) {
+    if(_inline_writing) {
+        // nobody else could convert the inode in the meantime
+        assert(inode->flags & INODE_INLINE);
+
+        OpenFiles::OpenFile *ofile = r.hdl().files().get_file(_ino);
+        assert(ofile != nullptr);
+        ofile->appending = false;
+        _inline_writing = false;
+
+        // if the window is committed implicitly, we didn't receive any data
+        if(!data)
+            submit = 0;
+        else {
+            memcpy(inode->inline_data() + _lastoff, data, submit);
+            if(_lastoff + submit > inode->size)
+                inode->size = _lastoff + submit;
+            INodes::mark_modified(r, inode);
+        }
+    }
+
+    _fileoff = _lastoff + submit;
+    _extoff = _fileoff;
+}
+
+void M3FSFileSession::commit_overwrite(Request &r, INode *inode) {
+    // we don't know whether the client actually changed the data, so assume it did
+    INodes::mark_modified(r, inode);
+    _overwriting = false;
+}
@@ -71,6 +71,7 @@ public:
     virtual void commit(m3::GateIStream &is) override;
     virtual void seek(m3::GateIStream &is) override;
     virtual void fstat(m3::GateIStream &is) override;
+    virtual void readdir_plus(m3::GateIStream &is) override;
 
     m3::inodeno_t ino() const {
         return _ino;
@@ -85,13 +86,23 @@ public:
     void set_ep(capsel_t ep) {
         _epcap = ep;
     }
+    void set_dirbuf(capsel_t sel, size_t size) {
+        delete _dirbuf;
+        _dirbuf = new m3::MemGate(m3::MemGate::bind(sel, 0));
+        _dirbuf_size = size;
+        _dirbuf_checked = false;
+    }
 
     m3::Errors::Code clone(capsel_t srv, m3::KIF::Service::ExchangeData &data);
     m3::Errors::Code get_mem(m3::KIF::Service::ExchangeData &data);
 
 private:
     void next_in_out(m3::GateIStream &is, bool out);
+    void next_inline(m3::GateIStream &is, m3::INode *inode, bool out);
+    void reply_next(m3::GateIStream &is, capsel_t sel, size_t capoff);
     m3::Errors::Code commit(Request &r, m3::INode *inode, size_t submit);
+    void commit_inline(Request &r, m3::INode *inode, size_t submit, const char *data);
+    void commit_overwrite(Request &r, m3::INode *inode);
 
     size_t _extent;
     size_t _extoff;
@@ -104,10 +115,20 @@ private:
 
     bool _appending;
     m3::Extent *_append_ext;
+    // whether the client got write access to existing data with the last out request
+    bool _overwriting;
+
+    // whether the last in/out request has been served from the inline data of the inode
+    bool _inline_win;
+    bool _inline_writing;
 
     capsel_t _last;
     capsel_t _epcap;
     m3::SendGate *_sgate;
+    m3::MemGate *_dirbuf;
+    size_t _dirbuf_size;
+    // whether we know that the capability covers <_dirbuf_size> bytes
+    bool _dirbuf_checked;
 
     int _oflags;
     m3::String _filename;
@@ -266,6 +266,59 @@ void M3FSMetaSession::unlink(GateIStream &is) {
     reply_error(is, res);
 }
 
+void M3FSMetaSession::copy_range(GateIStream &is) {
+    String srcpath, dstpath;
+    size_t off, count;
+    is >> srcpath >> dstpath >> off >> count;
+
+    Request r(hdl());
+
+    PRINT(this, "fs::copy_range(srcpath=" << srcpath << ", dstpath=" << dstpath
+        << ", off=" << off << ", count=" << count << ")");
+
+    inodeno_t srcino = Dirs::search(r, srcpath.c_str(), false);
+    inodeno_t dstino = Dirs::search(r, dstpath.c_str(), false);
+    if(srcino == INVALID_INO || dstino == INVALID_INO) {
+        PRINT(this, "copy_range failed: " << Errors::to_string(Errors::NO_SUCH_FILE));
+        reply_error(is, Errors::NO_SUCH_FILE);
+        return;
+    }
+    if(srcino == dstino) {
+        reply_error(is, Errors::INV_ARGS);
+        return;
+    }
+
+    INode *src = INodes::get(r, srcino);
+    INode *dst = INodes::get(r, dstino);
+    if(M3FS_ISDIR(src->mode) || M3FS_ISDIR(dst->mode)) {
+        reply_error(is, Errors::IS_DIR);
+        return;
+    }
+    if((~src->mode & M3FS_IRUSR) || (~dst->mode & M3FS_IWUSR)) {
+        reply_error(is, Errors::NO_PERM);
+        return;
+    }
+
+    // we append to <dst> and therefore can't do that while a client is appending
+    OpenFiles::OpenFile *of = hdl().files().get_file(dstino);
+    if(of && of->appending) {
+        PRINT(this, "append already in progress");
+        reply_error(is, Errors::EXISTS);
+        return;
+    }
+
+    Errors::last = Errors::NONE;
+    size_t copied = INodes::copy_range(r, src, dst, off, count);
+    if(copied == 0 && Errors::occurred()) {
+        PRINT(this, "copy_range failed: " << Errors::to_string(Errors::last));
+        reply_error(is, Errors::last);
+        return;
+    }
+
+    PRINT(this, "fs::copy_range -> " << copied);
+    reply_vmsg(is, Errors::NONE, copied);
+}
+
 void M3FSMetaSession::remove_file(M3FSFileSession *file) {
     for(size_t i = 0; i < MAX_FILES; ++i) {
         if(_files[i] == file) {
@@ -70,6 +70,7 @@ public:
     virtual void rmdir(m3::GateIStream &is) override;
     virtual void link(m3::GateIStream &is) override;
     virtual void unlink(m3::GateIStream &is) override;
+    virtual void copy_range(m3::GateIStream &is) override;
 
     m3::RecvGate &rgate() {
         return _rgate;
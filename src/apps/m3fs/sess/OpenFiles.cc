@@ -16,6 +16,7 @@
 
 #include "OpenFiles.h"
 
+#include "../FSHandle.h"
 #include "../data/INodes.h"
 
 void OpenFiles::delete_file(m3::inodeno_t ino) {
@@ -30,7 +31,7 @@ void OpenFiles::delete_file(m3::inodeno_t ino) {
 void OpenFiles::add_sess(M3FSFileSession *sess) {
     OpenFile *file = get_file(sess->ino());
     if(!file) {
-        file = new OpenFile(sess->ino());
+        file = new OpenFile(sess->ino(), static_cast<uint32_t>(_hdl.extend()));
         _files.insert(file);
     }
 
@@ -45,10 +46,12 @@ void OpenFiles::rem_sess(M3FSFileSession *sess) {
 
     if(file->sessions.length() == 0) {
         _files.remove(file);
-        if(file->deleted) {
-            Request r(_hdl);
+        Request r(_hdl);
+        // release the blocks that nobody will append to anymore
+        if(file->prealloc.length > 0)
+            _hdl.blocks().free(r, file->prealloc.start, file->prealloc.length);
+        if(file->deleted)
             INodes::free(r, sess->ino());
-        }
         delete file;
     }
 }
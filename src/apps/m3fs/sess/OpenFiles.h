@@ -27,15 +27,24 @@ class FSHandle;
 
 class OpenFiles {
 public:
+    // the maximum preallocation window in multiples of FSHandle::extend()
+    static const uint32_t MAX_WINDOW_FACTOR = 8;
+
     struct OpenFile : public m3::TreapNode<OpenFile, m3::inodeno_t> {
-        explicit OpenFile(m3::inodeno_t ino)
+        explicit OpenFile(m3::inodeno_t ino, uint32_t initial_window)
             : m3::TreapNode<OpenFile, m3::inodeno_t>(ino),
               appending(false),
-              deleted(false) {
+              deleted(false),
+              window(initial_window),
+              prealloc() {
         }
 
         bool appending;
         bool deleted;
+        // the number of blocks to allocate for the next new extent
+        uint32_t window;
+        // the blocks that have been left over by the last append and are used for the next one
+        m3::Extent prealloc;
         m3::SList<M3FSFileSession> sessions;
     };
 
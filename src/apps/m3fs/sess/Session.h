@@ -28,7 +28,8 @@ class FSHandle;
 
 class M3FSSession : public m3::ServerSession {
 public:
-    static constexpr size_t MSG_SIZE = 128;
+    // commits of inline windows carry up to INODE_INLINE_SIZE bytes of data
+    static constexpr size_t MSG_SIZE = 256;
 
     enum Type {
         META,
@@ -86,6 +87,12 @@ public:
     virtual void unlink(m3::GateIStream &is) {
         m3::reply_error(is, m3::Errors::NOT_SUP);
     }
+    virtual void copy_range(m3::GateIStream &is) {
+        m3::reply_error(is, m3::Errors::NOT_SUP);
+    }
+    virtual void readdir_plus(m3::GateIStream &is) {
+        m3::reply_error(is, m3::Errors::NOT_SUP);
+    }
 
 private:
     FSHandle &_handle;
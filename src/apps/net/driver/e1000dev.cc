@@ -19,6 +19,7 @@
 #include <assert.h>
 #include <base/DTU.h>
 #include <base/log/Services.h>
+#include <base/util/Math.h>
 
 #include <cstddef>
 #include <cstdlib>
@@ -36,6 +37,13 @@ E1000::E1000(pci::ProxiedPciDevice & nic)
       _eeprom(*this),
       _curRxBuf(),
       _curTxBuf(),
+      _txTail(),
+      _txHead(),
+      _txPending(),
+      _txPendingCount(),
+      _tidv(),
+      _polling(),
+      _idlePolls(),
       _bufs(MemGate::create_global(sizeof(Buffers), MemGate::RW)),
       _linkStateChanged(true) {
 
@@ -51,7 +59,7 @@ E1000::E1000(pci::ProxiedPciDevice & nic)
 
     // clear descriptors
     for(size_t i = 0; i < sizeof(Buffers); i += sizeof(ZEROS))
-        _bufs.write(&ZEROS, std::min(sizeof(Buffers) - i, sizeof(ZEROS)), i);
+        _bufs.write(&ZEROS, Math::min(sizeof(Buffers) - i, sizeof(ZEROS)), i);
 
     // reset card
     reset();
@@ -105,8 +113,7 @@ void E1000::reset() {
     writeReg(REG_RDLEN, RX_BUF_COUNT * sizeof(RxDesc));
     writeReg(REG_RDH, 0);
     writeReg(REG_RDT, RX_BUF_COUNT - 1);
-    writeReg(REG_RDTR, 0);
-    writeReg(REG_RADV, 0);
+    _curRxBuf = 0;
 
     // init transmit ring
     writeReg(REG_TDBAH, 0);
@@ -114,8 +121,11 @@ void E1000::reset() {
     writeReg(REG_TDLEN, TX_BUF_COUNT * sizeof(TxDesc));
     writeReg(REG_TDH, 0);
     writeReg(REG_TDT, 0);
-    writeReg(REG_TIDV, 0);
     writeReg(REG_TADV, 0);
+    _curTxBuf = _txTail = _txHead = 0;
+    _txPendingCount = 0;
+
+    setInterruptDelays(DEF_RDTR, DEF_RADV, DEF_TIDV);
 
     // enable rings
     // Always enabled for this model? legacy stuff?
@@ -143,6 +153,14 @@ void E1000::reset() {
     _linkStateChanged = true;
 }
 
+void E1000::setInterruptDelays(uint32_t rdtr, uint32_t radv, uint32_t tidv) {
+    // let the device collect multiple frames before raising an interrupt
+    writeReg(REG_RDTR, rdtr);
+    writeReg(REG_RADV, radv);
+    writeReg(REG_TIDV, tidv);
+    _tidv = tidv;
+}
+
 void E1000::writeReg(uint16_t reg,uint32_t value) {
     SLOG(NIC, "REG[" << fmt(reg, "#0x", 4) << "] <- " << fmt(value, "#0x", 8));
     _nic.writeReg(reg, value);
@@ -176,96 +194,132 @@ void E1000::sleep(cycles_t usec) {
     } while ((DTU::get().tsc() - t) < cycles_to_seep);
 }
 
-bool E1000::send(const void* packet, size_t size) {
+bool E1000::sendv(const IOVec *iov, size_t count) {
+    size_t size = 0;
+    for(size_t i = 0; i < count; ++i)
+        size += iov[i].len;
     assert(size <= mtu());
 
-    // to next tx descriptor
-    uint32_t cur = _curTxBuf;
-    _curTxBuf = (_curTxBuf + 1) % TX_BUF_COUNT;
-
-    // is there enough space?
-    uint32_t head = readReg(REG_TDH);
-    if(_curTxBuf == head) {
-        // TODO handle that case
-        SLOG(NIC, "No free buffers");
-        return false;
+    // is there enough space? only ask the device if the last known head says no
+    uint32_t next = (_curTxBuf + 1) % TX_BUF_COUNT;
+    if(next == _txHead) {
+        _txHead = readReg(REG_TDH);
+        if(next == _txHead) {
+            flushTx();
+            SLOG(NIC, "No free buffers");
+            return false;
+        }
     }
 
-    // copy to buffer
+    // copy the fragments directly to the buffer
+    uint32_t cur = _curTxBuf;
     auto offset = offsetof(Buffers, txBuf) + cur * TX_BUF_SIZE;
-    _bufs.write(packet, size, offset);
-    SLOG(NIC, "TX " << cur << ": " << offset << ".." << (offset + size));
-
-    // setup descriptor
-    TxDesc desc = {};
-    desc.cmd = TX_CMD_EOP | TX_CMD_IFCS;
+    _bufs.writev(iov, count, offset);
+    SLOG(NIC, "TX " << cur << ": " << offset << ".." << (offset + size)
+        << " (" << count << " fragments)");
+
+    // setup descriptor, but hand it to the device together with the following ones
+    TxDesc &desc = _txPending[_txPendingCount++];
+    desc = TxDesc();
+    desc.cmd = TX_CMD_EOP | TX_CMD_IFCS | (_tidv ? TX_CMD_IDE : 0);
     desc.length = size;
     desc.buffer = offset;
     desc.status = 0;
-    _bufs.write(&desc, sizeof(TxDesc), offsetof(Buffers, txDescs) + cur * sizeof(TxDesc));
-
-    writeReg(REG_TDT, _curTxBuf);
-
-    SLOG(NIC, "Status" << fmt(readReg(REG_STATUS), "x", 4));
+    _curTxBuf = next;
 
+    if(_txPendingCount == TX_BATCH_SIZE)
+        flushTx();
     return true;
 }
 
-void E1000::receive(size_t maxReceiveCount) {
-    // TODO: Improve, do it without reading registers, like quoted in the manual and how the linux e1000 driver does it.
-    // " Software can determine if a receive buffer is valid by reading descriptors in memory
-    //   rather than by I/O reads. Any descriptor with a non-zero status byte has been processed by the
-    //   hardware, and is ready to be handled by the software."
-
-    uint32_t tail = incTail(readReg(REG_RDT), RX_BUF_COUNT);
-    RxDesc desc;
-    _bufs.read(&desc, sizeof(RxDesc), offsetof(Buffers, rxDescs) + tail * sizeof(RxDesc));
-    // TODO: Ensure that packets that are not processed because the maxReceiveCount has been exceeded,
-    // to be processed later, independently of an interrupt.
-    while((desc.status & RDS_DONE) && maxReceiveCount-- > 0) {
-        SLOG(NIC, "RX " << tail
-                << ": " << fmt(desc.buffer, "#0x", 8)
-                << ".." << fmt(desc.buffer + desc.length, "#0x", 8)
-                << " st=" << fmt(desc.status, "#0x", 2)
-                << " er=" << fmt(desc.error, "#0x", 2));
-
-        // read data into packet
-        size_t size = desc.length;
-        uint8_t *pkt = (uint8_t *)malloc(size);
-        if(!pkt) {
-            SLOG(NIC, "Not enough memory to read packet");
-            break;
-        }
-        _bufs.read(pkt, size, desc.buffer);
+void E1000::flushTx() {
+    if(_txPendingCount == 0)
+        return;
+
+    // write all pending descriptors at once; the run wraps around at most once
+    size_t first = Math::min(_txPendingCount, TX_BUF_COUNT - _txTail);
+    _bufs.write(_txPending, first * sizeof(TxDesc),
+                offsetof(Buffers, txDescs) + _txTail * sizeof(TxDesc));
+    if(first < _txPendingCount) {
+        _bufs.write(_txPending + first, (_txPendingCount - first) * sizeof(TxDesc),
+                    offsetof(Buffers, txDescs));
+    }
 
-        // Call receive callback
-        if(_recvCallback)
-            _recvCallback(pkt, size);
+    SLOG(NIC, "TX flush " << _txTail << ".." << _curTxBuf << " (" << _txPendingCount << " frames)");
+    writeReg(REG_TDT, _curTxBuf);
+    _txTail = _curTxBuf;
+    _txPendingCount = 0;
+}
 
-        free(pkt);
+size_t E1000::receive(size_t maxReceiveCount) {
+    // instead of reading the head register, we read the descriptors in memory: "Any descriptor with
+    // a non-zero status byte has been processed by the hardware, and is ready to be handled by the
+    // software." We fetch and write back a whole run of descriptors with one transfer each.
+    RxDesc descs[RX_BATCH_SIZE];
+    size_t total = 0;
+    while(total < maxReceiveCount) {
+        size_t count = Math::min(Math::min(RX_BATCH_SIZE, maxReceiveCount - total),
+                                RX_BUF_COUNT - _curRxBuf);
+        goff_t off = offsetof(Buffers, rxDescs) + _curRxBuf * sizeof(RxDesc);
+        _bufs.read(descs, count * sizeof(RxDesc), off);
+
+        size_t i;
+        for(i = 0; i < count && (descs[i].status & RDS_DONE); ++i) {
+            RxDesc &desc = descs[i];
+            SLOG(NIC, "RX " << (_curRxBuf + i)
+                    << ": " << fmt(desc.buffer, "#0x", 8)
+                    << ".." << fmt(desc.buffer + desc.length, "#0x", 8)
+                    << " st=" << fmt(desc.status, "#0x", 2)
+                    << " er=" << fmt(desc.error, "#0x", 2));
+
+            // let the callback read the data directly from the buffer
+            if(_recvCallback) {
+                RxFrame frame(_bufs, desc.buffer, desc.length);
+                _recvCallback(frame);
+            }
+
+            desc.length = 0;
+            desc.checksum = 0;
+            desc.status = 0;
+            desc.error = 0;
+        }
+        if(i == 0)
+            break;
 
-        desc.length = 0;
-        desc.checksum = 0;
-        desc.status = 0;
-        desc.error = 0;
-        _bufs.write(&desc, sizeof(RxDesc), offsetof(Buffers, rxDescs) + tail * sizeof(RxDesc));
+        _bufs.write(descs, i * sizeof(RxDesc), off);
+        _curRxBuf = (_curRxBuf + i) % RX_BUF_COUNT;
+        total += i;
+        if(i < count)
+            break;
+    }
 
-        //pkt->length = size;
-        //memcpy(pkt->data,_bufs->rxBuf + _curRxBuf * RX_BUF_SIZE,size);
+    // give the processed descriptors back to the device
+    if(total > 0)
+        writeReg(REG_RDT, (_curRxBuf + RX_BUF_COUNT - 1) % RX_BUF_COUNT);
+    return total;
+}
 
-        // insert into list
-        //insert(pkt);
-        //(*_handler)();
+void E1000::setPolling(bool polling) {
+    SLOG(NIC, "Switching to " << (polling ? "polling" : "interrupt") << " mode");
+    // if frames arrive while the receive interrupts are masked, the cause stays set and the
+    // interrupt is raised as soon as we unmask it again
+    writeReg(polling ? REG_IMC : REG_IMS, ICR_RXO | ICR_RXT0);
+    _polling = polling;
+    _idlePolls = 0;
+}
 
-        // to next packet
-        writeReg(REG_RDT, tail);
-        tail = incTail(tail, RX_BUF_COUNT);
-        _bufs.read(&desc, sizeof(RxDesc), offsetof(Buffers, rxDescs) + tail * sizeof(RxDesc));
+void E1000::poll() {
+    if(_polling) {
+        if(receive(MAX_RECEIVE_COUNT_PER_INTERRUPT) > 0)
+            _idlePolls = 0;
+        else if(++_idlePolls >= POLL_IDLE_LIMIT)
+            setPolling(false);
     }
+
+    flushTx();
 }
 
 void E1000::receiveInterrupt() {
-    // TODO: Check Interrupt cause register...
     uint32_t icr = readReg(REG_ICR);
     SLOG(NIC, "Received interrupt: " << fmt(icr, "#0x", 8));
 
@@ -273,10 +327,13 @@ void E1000::receiveInterrupt() {
         _linkStateChanged = true;
     }
 
-    receive(MAX_RECEIVE_COUNT_PER_INTERRUPT);
+    // if there are more frames than we handle at once, we are under load. thus, stop the
+    // interrupts and fetch the remaining and following frames in poll().
+    if(receive(MAX_RECEIVE_COUNT_PER_INTERRUPT) == MAX_RECEIVE_COUNT_PER_INTERRUPT && !_polling)
+        setPolling(true);
 }
 
-void E1000::setReceiveCallback(std::function<void(uint8_t* pkt, size_t size)> callback) {
+void E1000::setReceiveCallback(recv_callback_t callback) {
     _recvCallback = callback;
 }
 
@@ -20,6 +20,8 @@
 #include <m3/net/Net.h>
 #include <pci/Device.h>
 
+#include "netdriver.h"
+
 #define DEBUG_E1000  0
 #if DEBUG_E1000
 #   include <base/stream/Serial.h>
@@ -50,7 +52,7 @@ private:
     uint32_t _doneBit;
 };
 
-class E1000 {
+class E1000 : public NetDriver {
     friend class EEPROM;
 
     enum {
@@ -160,6 +162,7 @@ class E1000 {
     enum {
         TX_CMD_EOP          = 0x01,          /* end of packet */
         TX_CMD_IFCS         = 0x02,          /* insert FCS/CRC */
+        TX_CMD_IDE          = 0x80,          /* interrupt delay enable */
     };
 
     enum {
@@ -169,13 +172,24 @@ class E1000 {
 
     static const cycles_t RESET_SLEEP_TIME              = 20 * 1000;
 
-    static const size_t MAX_RECEIVE_COUNT_PER_INTERRUPT = 5;
-
     static const size_t RX_BUF_COUNT                    = 256;
     static const size_t TX_BUF_COUNT                    = 256;
     static const size_t RX_BUF_SIZE                     = 2048;
     static const size_t TX_BUF_SIZE                     = 2048;
 
+    // the number of descriptors that are transferred at once
+    static const size_t RX_BATCH_SIZE                   = 32;
+    static const size_t TX_BATCH_SIZE                   = 32;
+
+    static const size_t MAX_RECEIVE_COUNT_PER_INTERRUPT = RX_BATCH_SIZE;
+    // the number of polls without received frames until we switch back to interrupts
+    static const uint POLL_IDLE_LIMIT                   = 64;
+
+    // default interrupt delays in units of 1.024 us
+    static const uint32_t DEF_RDTR                      = 4;
+    static const uint32_t DEF_RADV                      = 16;
+    static const uint32_t DEF_TIDV                      = 16;
+
     struct TxDesc {
         uint64_t buffer;
         uint16_t length;
@@ -195,6 +209,27 @@ class E1000 {
         uint16_t : 16;
     } PACKED ALIGNED(4);
 
+    class RxFrame : public Frame {
+    public:
+        explicit RxFrame(m3::MemGate &bufs, goff_t offset, size_t size)
+            : _bufs(bufs),
+              _offset(offset),
+              _size(size) {
+        }
+
+        virtual size_t size() const override {
+            return _size;
+        }
+        virtual bool read(const IOVec *iov, size_t count) override {
+            return _bufs.readv(iov, count, _offset) == m3::Errors::NONE;
+        }
+
+    private:
+        m3::MemGate &_bufs;
+        goff_t _offset;
+        size_t _size;
+    };
+
     struct Buffers {
         RxDesc rxDescs[RX_BUF_COUNT] ALIGNED(16); // 0
         TxDesc txDescs[TX_BUF_COUNT] ALIGNED(16); // 128
@@ -205,20 +240,37 @@ class E1000 {
 public:
     explicit E1000(pci::ProxiedPciDevice & nic);
 
-    ulong mtu() const {
+    virtual ulong mtu() const override {
         return TX_BUF_SIZE;
     }
 
     void reset();
-    bool send(const void *packet, size_t size);
-    void receive(size_t maxReceiveCount);
+    virtual bool sendv(const IOVec *iov, size_t count) override;
+    virtual void poll() override;
+
+    /**
+     * Receives up to <maxReceiveCount> frames and passes them to the receive callback
+     *
+     * @param maxReceiveCount the maximum number of frames
+     * @return the number of received frames
+     */
+    size_t receive(size_t maxReceiveCount);
+
+    /**
+     * Programs the interrupt coalescing timers in units of 1.024 us; 0 disables the timer.
+     *
+     * @param rdtr the receive delay, restarted on every received frame
+     * @param radv the absolute receive delay since the first frame
+     * @param tidv the transmit delay
+     */
+    void setInterruptDelays(uint32_t rdtr, uint32_t radv, uint32_t tidv);
 
     void receiveInterrupt();
-    void setReceiveCallback(std::function<void(uint8_t *pkt, size_t size)> callback);
-    m3::net::MAC readMAC();
+    virtual void setReceiveCallback(recv_callback_t callback) override;
+    virtual m3::net::MAC readMAC() override;
 
-    bool linkStateChanged();
-    bool linkIsUp();
+    virtual bool linkStateChanged() override;
+    virtual bool linkIsUp() override;
 
 private:
     void sleep(cycles_t usec);
@@ -228,14 +280,25 @@ private:
     void readEEPROM(uintptr_t address, uint8_t *dest, size_t len);
 
     uint32_t incTail(uint32_t tail, uint32_t descriptorCount);
+    void flushTx();
+    void setPolling(bool polling);
 
     pci::ProxiedPciDevice & _nic;
     EEPROM _eeprom;
     m3::net::MAC _mac;
     uint32_t _curRxBuf;
     uint32_t _curTxBuf;
+    // the last value written to TDT and the last value read from TDH
+    uint32_t _txTail;
+    uint32_t _txHead;
+    // the descriptors from _txTail to _curTxBuf that are not handed to the device yet
+    TxDesc _txPending[TX_BATCH_SIZE];
+    size_t _txPendingCount;
+    uint32_t _tidv;
+    bool _polling;
+    uint _idlePolls;
     m3::MemGate _bufs;
-    std::function<void(uint8_t *pkt, size_t size)> _recvCallback;
+    recv_callback_t _recvCallback;
     bool _linkStateChanged;
 };
 
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+
+#pragma once
+
+#include <base/Common.h>
+#include <m3/com/MemGate.h>
+#include <m3/net/Net.h>
+
+#include <functional>
+
+namespace net {
+
+/**
+ * The interface between the network stack and the driver of the network interface
+ */
+class NetDriver {
+public:
+    using IOVec = m3::MemGate::IOVec;
+
+    /**
+     * A received frame that is still in the buffers of the driver. This allows the network stack
+     * to let the driver copy the frame directly into its own buffers.
+     */
+    class Frame {
+    public:
+        virtual ~Frame() {
+        }
+
+        /**
+         * @return the size of the frame
+         */
+        virtual size_t size() const = 0;
+
+        /**
+         * Copies the frame into the <count> buffers in <iov>, one after another
+         *
+         * @param iov the buffers
+         * @param count the number of buffers
+         * @return true on success
+         */
+        virtual bool read(const IOVec *iov, size_t count) = 0;
+    };
+
+    using recv_callback_t = std::function<void(Frame &frame)>;
+
+    virtual ~NetDriver() {
+    }
+
+    /**
+     * @return the maximum frame size
+     */
+    virtual ulong mtu() const = 0;
+
+    /**
+     * Sends the ethernet frame that consists of the <count> buffers in <iov>. The buffers are
+     * copied directly into the transmit buffers of the driver. The driver might queue the frame
+     * until the next call of poll().
+     *
+     * @param iov the buffers
+     * @param count the number of buffers
+     * @return true if the frame has been sent
+     */
+    virtual bool sendv(const IOVec *iov, size_t count) = 0;
+
+    /**
+     * Sends the given ethernet frame
+     *
+     * @param packet the frame
+     * @param size the size of the frame
+     * @return true if the frame has been sent
+     */
+    bool send(const void *packet, size_t size) {
+        IOVec iov = {const_cast<void*>(packet), size};
+        return sendv(&iov, 1);
+    }
+
+    /**
+     * Is called once per iteration of the main loop. Lets the driver transmit queued frames and
+     * check for received frames, if it does not wait for interrupts.
+     */
+    virtual void poll() {
+    }
+
+    /**
+     * Sets the function that is called for every received frame
+     *
+     * @param callback the callback
+     */
+    virtual void setReceiveCallback(recv_callback_t callback) = 0;
+
+    /**
+     * @return the MAC address of the interface
+     */
+    virtual m3::net::MAC readMAC() = 0;
+
+    /**
+     * @return true if the link state changed since the last call
+     */
+    virtual bool linkStateChanged() = 0;
+
+    /**
+     * @return true if the link is up
+     */
+    virtual bool linkIsUp() = 0;
+};
+
+}
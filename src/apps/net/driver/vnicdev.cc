@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+
+#include <base/log/Services.h>
+#include <base/util/Math.h>
+#include <base/Env.h>
+#include <base/Panic.h>
+
+#include <cstring>
+#include <unistd.h>
+
+#include "vnicdev.h"
+
+using namespace m3;
+
+namespace net {
+
+VirtNIC::VirtNIC()
+    : _mem(VNIC_SHM_NAME, sizeof(VirtNICMem), SharedMemory::JOIN),
+      _nic(reinterpret_cast<VirtNICMem*>(_mem.addr())),
+      _port(VirtNICMem::PORTS),
+      _linkUp(false),
+      _recvCallback(),
+      _workItem(this) {
+    int32_t pid = getpid();
+    for(size_t i = 0; i < VirtNICMem::PORTS; ++i) {
+        int32_t free = 0;
+        if(__atomic_compare_exchange_n(&_nic->ports[i].pid, &free, pid, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            _port = i;
+            break;
+        }
+    }
+    if(_port == VirtNICMem::PORTS)
+        PANIC("vnic: all ports are in use");
+
+    // drop the frames a previous owner did not receive
+    port().rx.head = __atomic_load_n(&port().rx.tail, __ATOMIC_ACQUIRE);
+    SLOG(NIC, "vnic: using port " << _port);
+
+    env()->workloop()->add(&_workItem, false);
+}
+
+VirtNIC::~VirtNIC() {
+    env()->workloop()->remove(&_workItem);
+    __atomic_store_n(&port().pid, 0, __ATOMIC_RELEASE);
+}
+
+bool VirtNIC::SlotFrame::read(const IOVec *iov, size_t count) {
+    size_t pos = 0;
+    for(size_t i = 0; i < count && pos < _slot.size; ++i) {
+        size_t amount = Math::min(iov[i].len, _slot.size - pos);
+        memcpy(iov[i].data, _slot.data + pos, amount);
+        pos += amount;
+    }
+    return pos == _slot.size;
+}
+
+bool VirtNIC::sendv(const IOVec *iov, size_t count) {
+    VirtNICMem::Ring &ring = peer().rx;
+
+    size_t size = 0;
+    for(size_t i = 0; i < count; ++i)
+        size += iov[i].len;
+    if(size > mtu()) {
+        SLOG(NIC, "vnic: frame of " << size << " bytes exceeds MTU");
+        return false;
+    }
+
+    uint32_t tail = ring.tail;
+    if(tail - __atomic_load_n(&ring.head, __ATOMIC_ACQUIRE) >= VirtNICMem::SLOTS) {
+        SLOG(NIC, "vnic: no free slot, dropping frame");
+        return false;
+    }
+
+    // copy the fragments directly into the slot of the peer
+    VirtNICMem::Slot &slot = ring.slots[tail % VirtNICMem::SLOTS];
+    size_t pos = 0;
+    for(size_t i = 0; i < count; ++i) {
+        memcpy(slot.data + pos, iov[i].data, iov[i].len);
+        pos += iov[i].len;
+    }
+    slot.size = static_cast<uint32_t>(size);
+    __atomic_store_n(&ring.tail, tail + 1, __ATOMIC_RELEASE);
+
+    SLOG(NIC, "vnic: TX " << tail << ": " << size << " bytes (" << count << " fragments)");
+    return true;
+}
+
+void VirtNIC::receive(size_t maxReceiveCount) {
+    VirtNICMem::Ring &ring = port().rx;
+    uint32_t head = ring.head;
+    uint32_t tail = __atomic_load_n(&ring.tail, __ATOMIC_ACQUIRE);
+    while(head != tail && maxReceiveCount-- > 0) {
+        VirtNICMem::Slot &slot = ring.slots[head % VirtNICMem::SLOTS];
+        SLOG(NIC, "vnic: RX " << head << ": " << slot.size << " bytes");
+
+        if(_recvCallback) {
+            SlotFrame frame(slot);
+            _recvCallback(frame);
+        }
+
+        // hand the slot back to the sender
+        __atomic_store_n(&ring.head, ++head, __ATOMIC_RELEASE);
+    }
+}
+
+void VirtNIC::setReceiveCallback(recv_callback_t callback) {
+    _recvCallback = callback;
+}
+
+m3::net::MAC VirtNIC::readMAC() {
+    // locally administered address, unique per port
+    return m3::net::MAC(0x02, 0x00, 0x00, 0x00, 0x00, static_cast<uint8_t>(_port + 1));
+}
+
+bool VirtNIC::linkStateChanged() {
+    bool up = linkIsUp();
+    bool changed = up != _linkUp;
+    _linkUp = up;
+    return changed;
+}
+
+bool VirtNIC::linkIsUp() {
+    return __atomic_load_n(&port().link_up, __ATOMIC_ACQUIRE) != 0;
+}
+
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+
+#pragma once
+
+#include <base/arch/host/SharedMemory.h>
+#include <base/arch/host/VirtNIC.h>
+#include <base/Common.h>
+#include <base/WorkLoop.h>
+
+#include "netdriver.h"
+
+namespace net {
+
+/**
+ * The driver for the virtual NIC on host, which is provided by the kernel via shared memory and
+ * connects two net instances (see base/arch/host/VirtNIC.h).
+ */
+class VirtNIC : public NetDriver {
+    static const size_t MAX_RECEIVE_COUNT_PER_POLL  = 5;
+
+    class ReceiveWorkItem : public m3::WorkItem {
+    public:
+        explicit ReceiveWorkItem(VirtNIC *nic)
+            : _nic(nic) {
+        }
+
+        virtual void work() override {
+            _nic->receive(MAX_RECEIVE_COUNT_PER_POLL);
+        }
+
+    private:
+        VirtNIC *_nic;
+    };
+
+    class SlotFrame : public Frame {
+    public:
+        explicit SlotFrame(const m3::VirtNICMem::Slot &slot)
+            : _slot(slot) {
+        }
+
+        virtual size_t size() const override {
+            return _slot.size;
+        }
+        virtual bool read(const IOVec *iov, size_t count) override;
+
+    private:
+        const m3::VirtNICMem::Slot &_slot;
+    };
+
+public:
+    explicit VirtNIC();
+    ~VirtNIC();
+
+    virtual ulong mtu() const override {
+        return sizeof(m3::VirtNICMem::Slot::data);
+    }
+
+    virtual bool sendv(const IOVec *iov, size_t count) override;
+    void receive(size_t maxReceiveCount);
+
+    virtual void setReceiveCallback(recv_callback_t callback) override;
+    virtual m3::net::MAC readMAC() override;
+
+    virtual bool linkStateChanged() override;
+    virtual bool linkIsUp() override;
+
+private:
+    m3::VirtNICMem::Port &port() {
+        return _nic->ports[_port];
+    }
+    m3::VirtNICMem::Port &peer() {
+        return _nic->ports[m3::VirtNICMem::peer(_port)];
+    }
+
+    m3::SharedMemory _mem;
+    m3::VirtNICMem *_nic;
+    size_t _port;
+    bool _linkUp;
+    recv_callback_t _recvCallback;
+    ReceiveWorkItem _workItem;
+};
+
+}
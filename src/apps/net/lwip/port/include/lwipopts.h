@@ -22,6 +22,9 @@
 #define LWIP_PROVIDE_ERRNO 1
 
 #define PBUF_POOL_SIZE 128
+// Let every pool pbuf hold a complete ethernet frame, so that drivers can copy received frames into
+// a single buffer and we can forward received datagrams without copying them.
+#define PBUF_POOL_BUFSIZE 1536
 
 // There is no preemption in m3, so we can disable preemption protection.
 #define SYS_LIGHTWEIGHT_PROT 0
@@ -35,6 +38,16 @@
 #define LWIP_RAW 1
 
 #define TCP_LISTEN_BACKLOG 1
+#define TCP_MSS 1460
+// Keep enough data in flight to saturate the link; the window only reopens once the client's
+// receive pipe took the data, so the pipe provides the actual buffering.
+#define TCP_WND (8 * TCP_MSS)
+#define TCP_SND_BUF (8 * TCP_MSS)
+#define MEMP_NUM_TCP_SEG 64
+#define MEMP_NUM_TCP_PCB 32
+#define MEMP_NUM_UDP_PCB 16
+// tcp_write copies the data into the heap
+#define MEM_SIZE (256 * 1024)
 #define LWIP_NETIF_STATUS_CALLBACK 1
 
 // HACK: DirectPipe needs a DTU_PKG_SIZE aligned read buffer...
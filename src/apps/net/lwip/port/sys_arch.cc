@@ -18,10 +18,20 @@
 #include <base/DTU.h>
 #include <thread/ThreadManager.h>
 
+#if defined(__host__)
+#   include <time.h>
+#endif
+
 #include "lwip/def.h"
 #include "arch/sys_arch.h"
 #include "lwip/sys.h"
 
 u32_t sys_now(void) {
+#if defined(__host__)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+#else
     return (u32_t)(m3::DTU::get().tsc() * 1000 / m3::DTU::get().clock());
+#endif
 }
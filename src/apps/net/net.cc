@@ -23,10 +23,13 @@
 #include <m3/server/Server.h>
 #include <m3/stream/Standard.h>
 #include <m3/vfs/VFS.h>
-#include <pci/Device.h>
 #include <thread/ThreadManager.h>
 
-#include "driver/e1000dev.h"
+#if defined(__gem5__)
+#   include "driver/e1000dev.h"
+#else
+#   include "driver/vnicdev.h"
+#endif
 
 #include "lwipopts.h"
 #include "lwip/sys.h"
@@ -39,6 +42,7 @@
 #include "lwip/timeouts.h"
 #include "lwip/udp.h"
 #include "lwip/tcp.h"
+#include "lwip/priv/tcp_priv.h"
 #include "lwip/raw.h"
 
 #include <assert.h>
@@ -47,16 +51,26 @@
 #include <queue>
 #include <cstring>
 #include <memory>
+#include <vector>
 
 using namespace net;
 using namespace m3;
 
-static constexpr size_t MAX_SEND_RECEIVE_BATCH_SIZE = 5;
+// the maximum number of frames/datagrams that are handled per socket or device at once. this
+// matches the descriptor batches of the E1000 driver.
+static constexpr size_t MAX_SEND_RECEIVE_BATCH_SIZE = 32;
+// the maximum number of buffers per frame that are passed to the driver
+static constexpr size_t MAX_FRAGMENTS = 8;
+
+template<typename... Args>
+static void reply_vmsg_late(RecvGate &rgate, const DTU::Message *msg, const Args &... args) {
+    auto reply = create_vmsg(args...);
+    size_t idx = DTU::get().get_msgoff(rgate.ep(), msg);
+    rgate.reply(reply.bytes(), reply.total(), idx);
+}
 
 class NMSession : public ServerSession {
 public:
-    static constexpr size_t MAX_SOCKETS = 16;
-
     struct Socket {
         class SocketWorkItem: public WorkItem {
         public:
@@ -64,60 +78,45 @@ public:
                 : _socket(socket) {
             }
 
-            virtual void work() override {
-                size_t maxSendCount = MAX_SEND_RECEIVE_BATCH_SIZE;
-                while(maxSendCount--) {
-                    uint8_t buf[MessageHeader::serialize_length()];
-                    MessageHeader hdr;
-                    if(_socket->send_pipe->reader()->read(buf, sizeof(buf), false) == -1)
-                        return;
+            virtual epid_t ep() const override {
+                // as long as received data or an EOF waits for space in the recv pipe, we have to
+                // retry on every tick; otherwise only if the client has written into the send pipe
+                if(_socket->recv_blocked())
+                    return EP_COUNT;
+                return _socket->send_pipe->reader()->ep();
+            }
 
-                    Unmarshaller um(buf, sizeof(buf));
-                    hdr.unserialize(um);
-                    ip_addr_t addr =  IPADDR4_INIT(lwip_htonl(hdr.addr.addr()));
-
-                    SLOG(NET, "SocketWorkItem:work(): port " << hdr.port);
-                    SLOG(NET, "SocketWorkItem:work(): size " << hdr.size);
-
-                    struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, hdr.size, PBUF_RAM);
-                    if(p) {
-                       ssize_t read_size = _socket->send_pipe->reader()->read(p->payload, hdr.size, false);
-                       if(read_size != -1) {
-                           assert(static_cast<ssize_t>(hdr.size) == read_size);
-                           err_t err;
-                           if(ip_addr_cmp(&addr, IP_ADDR_ANY))
-                               err = udp_send(_socket->pcb.udp, p);
-                           else
-                               err = udp_sendto(_socket->pcb.udp, p, &addr, hdr.port);
-                           if(err != ERR_OK)
-                               SLOG(NET, "SocketWorkItem:work(): udp_send failed: " << err);
-                       }
-                       else
-                           SLOG(NET, "SocketWorkItem:work(): failed to read message data");
-                       pbuf_free(p);
-                   }
-                   else {
-                       SLOG(NET, "SocketWorkItem:work(): failed to allocate pbuf, dropping udp packet");
-                       _socket->send_pipe->reader()->read(nullptr, hdr.size, false);
-                   }
-                }
+            virtual void work() override {
+                _socket->retry_recv();
+                if(_socket->type == NetworkManager::SOCK_STREAM)
+                    _socket->send_stream();
+                else
+                    _socket->send_dgrams();
             }
 
         protected:
             Socket *_socket;
         };
 
-        explicit Socket(NetworkManager::SocketType _type, struct ip_pcb *_pcb, int _sd)
+        explicit Socket(NetworkManager::SocketType _type, struct ip_pcb *_pcb, int _sd,
+                        NMSession *_session)
             : type(_type),
               sd(_sd),
+              session(_session),
               pipe_caps(ObjCap::INVALID),
               recv_pipe(nullptr),
               send_pipe(nullptr),
-              work_item(nullptr) {
+              work_item(nullptr),
+              pending(nullptr),
+              accept_queue(),
+              send_rem(0),
+              eof_pending(false) {
             pcb.ip = _pcb;
         }
 
         ~Socket() {
+            reply_pending(Errors::INV_STATE);
+            release_pcb();
             if(work_item) {
                 env()->workloop()->remove(work_item);
                 delete work_item;
@@ -129,6 +128,194 @@ public:
             send_pipe = nullptr;
         }
 
+        template<typename... Args>
+        void reply_pending(Errors::Code err, const Args &... args) {
+            if(pending) {
+                reply_vmsg_late(*session->rgate, pending, err, args...);
+                pending = nullptr;
+            }
+        }
+
+        void release_pcb() {
+            if(!pcb.ip)
+                return;
+
+            switch(type) {
+                case NetworkManager::SOCK_STREAM:
+                    // we don't want to hear from lwIP anymore, which might keep the pcb for a while
+                    tcp_arg(pcb.tcp, nullptr);
+                    if(pcb.tcp->state != LISTEN) {
+                        tcp_recv(pcb.tcp, nullptr);
+                        tcp_sent(pcb.tcp, nullptr);
+                        tcp_err(pcb.tcp, nullptr);
+                    }
+                    if(tcp_close(pcb.tcp) != ERR_OK)
+                        tcp_abort(pcb.tcp);
+                    break;
+                case NetworkManager::SOCK_DGRAM:
+                    udp_remove(pcb.udp);
+                    break;
+                case NetworkManager::SOCK_RAW:
+                    raw_remove(pcb.raw);
+                    break;
+            }
+            pcb.ip = nullptr;
+        }
+
+        void send_dgrams() {
+            size_t maxSendCount = MAX_SEND_RECEIVE_BATCH_SIZE;
+            while(maxSendCount--) {
+                uint8_t buf[MessageHeader::serialize_length()];
+                MessageHeader hdr;
+                if(send_pipe->reader()->read(buf, sizeof(buf), false) == -1)
+                    return;
+
+                Unmarshaller um(buf, sizeof(buf));
+                hdr.unserialize(um);
+                ip_addr_t addr =  IPADDR4_INIT(lwip_htonl(hdr.addr.addr()));
+
+                SLOG(NET, "Socket::send_dgrams(): port " << hdr.port);
+                SLOG(NET, "Socket::send_dgrams(): size " << hdr.size);
+
+                struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, hdr.size, PBUF_RAM);
+                if(p) {
+                    ssize_t read_size = send_pipe->reader()->read(p->payload, hdr.size, false);
+                    if(read_size != -1) {
+                        assert(static_cast<ssize_t>(hdr.size) == read_size);
+                        err_t err;
+                        if(ip_addr_cmp(&addr, IP_ADDR_ANY))
+                            err = udp_send(pcb.udp, p);
+                        else
+                            err = udp_sendto(pcb.udp, p, &addr, hdr.port);
+                        if(err != ERR_OK)
+                            SLOG(NET, "Socket::send_dgrams(): udp_send failed: " << err);
+                    }
+                    else
+                        SLOG(NET, "Socket::send_dgrams(): failed to read message data");
+                    pbuf_free(p);
+                }
+                else {
+                    SLOG(NET, "Socket::send_dgrams(): failed to allocate pbuf, dropping udp packet");
+                    send_pipe->reader()->read(nullptr, hdr.size, false);
+                }
+            }
+        }
+
+        void send_stream() {
+            static uint8_t buf[TCP_MSS];
+
+            DirectPipeReader *reader = send_pipe->reader();
+            bool sent = false;
+            while(true) {
+                if(send_rem == 0) {
+                    uint8_t hdr_buf[MessageHeader::serialize_length()];
+                    if(reader->read(hdr_buf, sizeof(hdr_buf), false) == -1)
+                        break;
+
+                    MessageHeader hdr;
+                    Unmarshaller um(hdr_buf, sizeof(hdr_buf));
+                    hdr.unserialize(um);
+                    send_rem = hdr.size;
+                    SLOG(NET, "Socket::send_stream(): sd " << sd << ", size " << hdr.size);
+                    continue;
+                }
+
+                size_t amount = Math::min(send_rem, sizeof(buf));
+                if(pcb.tcp) {
+                    // only take data out of the pipe if lwIP can take it. thus, the pipe fills up
+                    // and blocks the client otherwise. we continue as soon as data has been acked.
+                    if(tcp_sndqueuelen(pcb.tcp) >= TCP_SND_QUEUELEN)
+                        break;
+                    amount = Math::min(amount, static_cast<size_t>(tcp_sndbuf(pcb.tcp)));
+                    if(amount == 0)
+                        break;
+                }
+
+                // if the connection is gone, just discard the data
+                ssize_t res = reader->read(pcb.tcp ? buf : nullptr, amount, false);
+                if(res <= 0)
+                    break;
+                send_rem -= static_cast<size_t>(res);
+
+                if(pcb.tcp) {
+                    err_t err = tcp_write(pcb.tcp, buf, static_cast<u16_t>(res), TCP_WRITE_FLAG_COPY);
+                    if(err != ERR_OK) {
+                        SLOG(NET, "Socket::send_stream(): tcp_write failed: " << err);
+                        break;
+                    }
+                    sent = true;
+                }
+            }
+
+            if(sent)
+                tcp_output(pcb.tcp);
+        }
+
+        bool forward(struct pbuf *p, const ip_addr_t *addr, u16_t port) {
+            size_t hdr_size = MessageHeader::serialize_length();
+            size_t size = p->tot_len + hdr_size;
+            SLOG(NET, "Socket::forward(): size " << size);
+            u8_t hdr_buf[MessageHeader::serialize_length()];
+            Marshaller m(hdr_buf, hdr_size);
+            MessageHeader hdr(IpAddr(lwip_ntohl(addr->addr)), port, p->tot_len);
+            hdr.serialize(m);
+
+            ssize_t res;
+            // if the data is contiguous, put our header in front of it, into the space of the
+            // protocol headers, and write both to the pipe without copying the data
+            if(p->len == p->tot_len && pbuf_header(p, static_cast<s16_t>(hdr_size)) == 0) {
+                memcpy(p->payload, hdr_buf, hdr_size);
+                res = recv_pipe->writer()->write(p->payload, size, false);
+                pbuf_header(p, -static_cast<s16_t>(hdr_size));
+            }
+            else {
+                u8_t *buf = static_cast<u8_t*>(Heap::alloc(size));
+                memcpy(buf, hdr_buf, hdr_size);
+                pbuf_copy_partial(p, buf + hdr_size, p->tot_len, 0);
+                res = recv_pipe->writer()->write(buf, size, false);
+                Heap::free(buf);
+            }
+            return res != -1;
+        }
+
+        bool recv_blocked() const {
+            if(eof_pending)
+                return true;
+            return type == NetworkManager::SOCK_STREAM && pcb.tcp && pcb.tcp->refused_data;
+        }
+
+        void retry_recv() {
+            if(!recv_pipe)
+                return;
+
+            // lwIP retries refused data only in its slow timer; do it as soon as we can
+            if(type == NetworkManager::SOCK_STREAM && pcb.tcp && pcb.tcp->refused_data)
+                tcp_process_refused_data(pcb.tcp);
+
+            // the EOF has to come after all data
+            bool refused = type == NetworkManager::SOCK_STREAM && pcb.tcp && pcb.tcp->refused_data;
+            if(eof_pending && !refused)
+                forward_eof();
+        }
+
+        void forward_eof() {
+            // remember the EOF until the client can receive it
+            eof_pending = true;
+            if(!recv_pipe)
+                return;
+
+            // an empty message tells the client that the connection has been closed
+            u8_t hdr_buf[MessageHeader::serialize_length()];
+            Marshaller m(hdr_buf, sizeof(hdr_buf));
+            MessageHeader hdr;
+            hdr.serialize(m);
+            if(recv_pipe->writer()->write(hdr_buf, sizeof(hdr_buf), false) == -1) {
+                SLOG(NET, "Socket::forward_eof(): recv_pipe is full, delaying EOF");
+                return;
+            }
+            eof_pending = false;
+        }
+
         NetworkManager::SocketType type;
         union {
             struct ip_pcb *ip;
@@ -137,50 +324,69 @@ public:
             struct raw_pcb *raw;
         } pcb;
         int sd;
+        NMSession *session;
         capsel_t pipe_caps;
         NetDirectPipe *recv_pipe;
         NetDirectPipe *send_pipe;
         SocketWorkItem *work_item;
+        // the connect or accept request we still have to reply to
+        const DTU::Message *pending;
+        // the connections that have been established but not accepted yet
+        std::queue<int> accept_queue;
+        // the number of bytes of the current message in the send pipe that are not sent yet
+        size_t send_rem;
+        // whether the EOF could not be written into the recv pipe yet
+        bool eof_pending;
     };
 
-    explicit NMSession(capsel_t srv_sel)
+    explicit NMSession(capsel_t srv_sel, RecvGate *_rgate)
         : ServerSession(srv_sel),
           sgate(),
-          sockets() {
+          rgate(_rgate),
+          sockets(),
+          free_sds() {
     }
 
     ~NMSession() {
-        for(size_t i = 0; i < MAX_SOCKETS; i++)
-            release_sd(static_cast<int>(i));
+        for(size_t i = 0; i < sockets.size(); i++)
+            delete sockets[i];
     }
 
     Socket *get(int sd) {
-        if(sd >= 0 && static_cast<size_t>(sd) < MAX_SOCKETS)
-            return sockets[sd];
+        if(sd >= 0 && static_cast<size_t>(sd) < sockets.size())
+            return sockets[static_cast<size_t>(sd)];
         return nullptr;
     }
 
     int request_sd(NetworkManager::SocketType type, struct ip_pcb *pcb) {
-        for(size_t i = 0; i < MAX_SOCKETS; i++) {
-            if(sockets[i] == nullptr) {
-                sockets[i] = new Socket(type, pcb, static_cast<int>(i));
-                return static_cast<int>(i);
-            }
+        // reuse released descriptors first; the table only grows if all are in use
+        int sd;
+        if(!free_sds.empty()) {
+            sd = free_sds.back();
+            free_sds.pop_back();
+        }
+        else {
+            sd = static_cast<int>(sockets.size());
+            sockets.push_back(nullptr);
         }
-        return -1;
+        sockets[static_cast<size_t>(sd)] = new Socket(type, pcb, sd, this);
+        return sd;
     }
 
     void release_sd(int sd) {
-        if(sd >= 0 && static_cast<size_t>(sd) < MAX_SOCKETS && sockets[sd] != nullptr) {
-            // TODO: Free lwip resources?
-            delete sockets[sd];
-            sockets[sd] = nullptr;
+        Socket *socket = get(sd);
+        if(socket != nullptr) {
+            delete socket;
+            sockets[static_cast<size_t>(sd)] = nullptr;
+            free_sds.push_back(sd);
         }
     }
 
     SendGate *sgate;
+    RecvGate *rgate;
 private:
-    Socket *sockets[MAX_SOCKETS];
+    std::vector<Socket*> sockets;
+    std::vector<int> free_sds;
 };
 
 class NMRequestHandler;
@@ -194,22 +400,23 @@ class NMRequestHandler: public net_reqh_base_t {
 public:
     static constexpr size_t MAX_SOCKET_BACKLOG = 10;
     static constexpr size_t MSG_SIZE = 128;
+    static constexpr uint MSG_BATCH = 8;
 
     explicit NMRequestHandler()
         : net_reqh_base_t(),
           _rgate(RecvGate::create(nextlog2<32 * MSG_SIZE>::val, nextlog2<MSG_SIZE>::val)) {
-        add_operation(NetworkManager::CREATE, &NMRequestHandler::create);
-        add_operation(NetworkManager::BIND, &NMRequestHandler::bind);
-        add_operation(NetworkManager::LISTEN, &NMRequestHandler::listen);
-        add_operation(NetworkManager::CONNECT, &NMRequestHandler::connect);
-        add_operation(NetworkManager::CLOSE, &NMRequestHandler::close);
-
-        using std::placeholders::_1;
-        _rgate.start(std::bind(&NMRequestHandler::handle_message, this, _1));
+        add_operation<&NMRequestHandler::create>(NetworkManager::CREATE);
+        add_operation<&NMRequestHandler::bind>(NetworkManager::BIND);
+        add_operation<&NMRequestHandler::listen>(NetworkManager::LISTEN);
+        add_operation<&NMRequestHandler::connect>(NetworkManager::CONNECT);
+        add_operation<&NMRequestHandler::accept>(NetworkManager::ACCEPT);
+        add_operation<&NMRequestHandler::close>(NetworkManager::CLOSE);
+
+        _rgate.start<net_reqh_base_t, &net_reqh_base_t::handle_message>(this, MSG_BATCH);
     }
 
     virtual Errors::Code open(NMSession **sess, capsel_t srv_sel, word_t) override {
-        *sess = new NMSession(srv_sel);
+        *sess = new NMSession(srv_sel, &_rgate);
         return Errors::NONE;
     }
 
@@ -245,6 +452,10 @@ public:
             socket->work_item = new NMSession::Socket::SocketWorkItem(socket);
             env()->workloop()->add(socket->work_item, false);
 
+            // lwIP keeps data that arrived before the pipes existed; hand it over now, together
+            // with an EOF that could not be delivered yet
+            socket->retry_recv();
+
             // TODO: pass size as argument
             KIF::CapRngDesc crd(KIF::CapRngDesc::OBJ, socket->pipe_caps, 6);
             data.caps = crd.value();
@@ -307,18 +518,11 @@ public:
 
         // allocate new socket descriptor
         int sd = sess->request_sd(type, static_cast<struct ip_pcb*>(pcb));
-        if(sd == -1) {
-            LOG_SESSION("create failed: maximum number of sockets reached");
-            reply_error(is, Errors::NO_SPACE);
-            return;
-        }
 
         // set argument for callback functions
         NMSession::Socket *socket = sess->get(sd);
-        if(socket->type == NetworkManager::SOCK_STREAM) {
-            // TODO: implement tcp_error, ... callback
-            tcp_arg(socket->pcb.tcp, socket);
-        }
+        if(socket->type == NetworkManager::SOCK_STREAM)
+            setup_tcp(socket);
         else if(socket->type == NetworkManager::SOCK_DGRAM)
             udp_recv(socket->pcb.udp, udp_recv_cb, socket);
 
@@ -379,8 +583,10 @@ public:
             err_t err = ERR_OK;
             struct tcp_pcb *lpcb = tcp_listen_with_backlog_and_err(
                 socket->pcb.tcp, MAX_SOCKET_BACKLOG, &err);
-            if(lpcb)
+            if(lpcb) {
                 socket->pcb.tcp = lpcb;
+                tcp_accept(lpcb, tcp_accept_cb);
+            }
 
             if(err != ERR_OK)
                 LOG_SESSION("listen failed: " << errToStr(err));
@@ -413,10 +619,19 @@ public:
         err_t err;
         switch(socket->type) {
             case NetworkManager::SOCK_STREAM:
-                // TODO: implement tcp_connect callback
-                // err = tcp_connect(socket->pcb.tcp, &ip_addr, port, );
-                reply_error(is, Errors::NOT_SUP);
-                return;
+                if(socket->pending || !socket->pcb.tcp) {
+                    LOG_SESSION("connect failed: socket is busy or closed");
+                    reply_error(is, Errors::INV_STATE);
+                    return;
+                }
+                err = tcp_connect(socket->pcb.tcp, &ip_addr, port, tcp_connected_cb);
+                if(err == ERR_OK) {
+                    // we reply as soon as the connection has been established or failed
+                    socket->pending = &is.message();
+                    is.claim();
+                    return;
+                }
+                break;
             case NetworkManager::SOCK_DGRAM:
                 err = udp_connect(socket->pcb.udp, &ip_addr, port);
                 break;
@@ -445,47 +660,130 @@ public:
             return;
         }
 
-        err_t err = ERR_OK;
-        switch(socket->type) {
-            case NetworkManager::SOCK_STREAM:
-                err = tcp_close(socket->pcb.tcp);
-                break;
-            case NetworkManager::SOCK_DGRAM:
-                udp_remove(socket->pcb.udp);
-                break;
-            case NetworkManager::SOCK_RAW:
-                raw_remove(socket->pcb.raw);
-                break;
+        // connections that have not been accepted yet die with the listener
+        while(!socket->accept_queue.empty()) {
+            sess->release_sd(socket->accept_queue.front());
+            socket->accept_queue.pop();
         }
 
         sess->release_sd(sd);
+        reply_error(is, Errors::NONE);
+    }
 
-        if(err != ERR_OK)
-            LOG_SESSION("close failed: " << errToStr(err));
+    void accept(GateIStream &is) {
+        NMSession *sess = is.label<NMSession*>();
+        int sd;
+        is >> sd;
+        LOG_SESSION("net::accept(sd=" << sd << ")");
 
-        reply_error(is, mapError(err));
+        NMSession::Socket *socket = sess->get(sd);
+        if(!socket || socket->type != NetworkManager::SOCK_STREAM || !socket->pcb.tcp ||
+           socket->pcb.tcp->state != LISTEN) {
+            LOG_SESSION("accept failed: not a listening socket");
+            reply_error(is, Errors::INV_ARGS);
+            return;
+        }
+        if(socket->pending) {
+            LOG_SESSION("accept failed: there is already an accept in progress");
+            reply_error(is, Errors::INV_STATE);
+            return;
+        }
+
+        if(!socket->accept_queue.empty()) {
+            int nsd = socket->accept_queue.front();
+            socket->accept_queue.pop();
+            LOG_SESSION("-> sd=" << nsd);
+            reply_vmsg(is, Errors::NONE, nsd);
+        }
+        else {
+            // we reply as soon as the next connection comes in
+            socket->pending = &is.message();
+            is.claim();
+        }
     }
 
 private:
+    static void setup_tcp(NMSession::Socket *socket) {
+        tcp_arg(socket->pcb.tcp, socket);
+        tcp_recv(socket->pcb.tcp, tcp_recv_cb);
+        tcp_sent(socket->pcb.tcp, tcp_sent_cb);
+        tcp_err(socket->pcb.tcp, tcp_err_cb);
+    }
+
     static void udp_recv_cb(void *arg, struct udp_pcb*, struct pbuf *p, const ip_addr_t *addr, u16_t port) {
-        // TODO: avoid unnecessary copy operation
         auto socket = static_cast<NMSession::Socket *>(arg);
-
-        size_t size = p->tot_len + MessageHeader::serialize_length();
-        SLOG(NET, "udp_recv_cb: size " << size);
-        SLOG(NET, "udp_recv_cb: offset " << MessageHeader::serialize_length());
-        u8_t *buf = static_cast<u8_t*>(Heap::alloc(size));
-        Marshaller m(buf, MessageHeader::serialize_length());
-        MessageHeader hdr(IpAddr(lwip_ntohl(addr->addr)), port, p->tot_len);
-        hdr.serialize(m);
-        pbuf_copy_partial(p, buf + MessageHeader::serialize_length(), p->tot_len, 0);
-        SLOG(NET, "udp_recv_cb: forwarding data to user (" << p->tot_len << ")");
-        if(socket->recv_pipe->writer()->write(buf, size, false) == -1)
+        if(!socket->recv_pipe || !socket->forward(p, addr, port))
             SLOG(NET, "udp_recv_cb: recv_pipe is full, dropping datagram");
-        Heap::free(buf);
         pbuf_free(p);
     }
 
+    static err_t tcp_connected_cb(void *arg, struct tcp_pcb*, err_t err) {
+        auto socket = static_cast<NMSession::Socket *>(arg);
+        SLOG(NET, "tcp_connected_cb: sd " << socket->sd << ", err " << errToStr(err));
+        socket->reply_pending(mapError(err));
+        return ERR_OK;
+    }
+
+    static err_t tcp_accept_cb(void *arg, struct tcp_pcb *newpcb, err_t err) {
+        auto listener = static_cast<NMSession::Socket *>(arg);
+        if(!listener || err != ERR_OK || !newpcb)
+            return ERR_VAL;
+
+        if(listener->accept_queue.size() >= MAX_SOCKET_BACKLOG) {
+            SLOG(NET, "tcp_accept_cb: backlog of sd " << listener->sd << " is full");
+            tcp_abort(newpcb);
+            return ERR_ABRT;
+        }
+
+        NMSession *sess = listener->session;
+        int sd = sess->request_sd(NetworkManager::SOCK_STREAM, reinterpret_cast<struct ip_pcb*>(newpcb));
+        setup_tcp(sess->get(sd));
+        LOG_SESSION("tcp_accept_cb: new connection sd=" << sd << " on sd=" << listener->sd);
+
+        if(listener->pending)
+            listener->reply_pending(Errors::NONE, sd);
+        else
+            listener->accept_queue.push(sd);
+        return ERR_OK;
+    }
+
+    static err_t tcp_recv_cb(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t) {
+        auto socket = static_cast<NMSession::Socket *>(arg);
+
+        // the remote side closed the connection
+        if(p == nullptr) {
+            SLOG(NET, "tcp_recv_cb: sd " << socket->sd << " closed by remote");
+            socket->forward_eof();
+            return ERR_OK;
+        }
+
+        // refuse the data if the client can't take it; lwIP will hand it to us again later and
+        // does not open the receive window until we took it
+        if(!socket->recv_pipe || !socket->forward(p, &pcb->remote_ip, pcb->remote_port))
+            return ERR_MEM;
+
+        tcp_recved(pcb, p->tot_len);
+        pbuf_free(p);
+        return ERR_OK;
+    }
+
+    static err_t tcp_sent_cb(void *arg, struct tcp_pcb*, u16_t) {
+        auto socket = static_cast<NMSession::Socket *>(arg);
+        // there is space in the send buffer again
+        if(socket->send_pipe)
+            socket->send_stream();
+        return ERR_OK;
+    }
+
+    static void tcp_err_cb(void *arg, err_t err) {
+        auto socket = static_cast<NMSession::Socket *>(arg);
+        SLOG(NET, "tcp_err_cb: sd " << socket->sd << ", err " << errToStr(err));
+        // lwIP has already freed the pcb
+        socket->pcb.tcp = nullptr;
+        socket->reply_pending(mapError(err));
+        socket->forward_eof();
+    }
+
     static err_t errToStr(err_t err) {
         return err;
     }
@@ -511,44 +809,66 @@ private:
 
 static std::queue<struct pbuf*> recvQueue;
 
-static void eth_recv_callback(uint8_t *pkt, size_t size) {
+/* Collects the buffers of the given pbuf chain in <iov>. Returns 0 if there are too many. */
+static size_t pbuf_to_iov(struct pbuf *p, NetDriver::IOVec *iov) {
+    size_t count = 0;
+    for(struct pbuf *q = p; q != NULL; q = q->next) {
+        if(count == MAX_FRAGMENTS)
+            return 0;
+        iov[count].data = q->payload;
+        iov[count].len = q->len;
+        count++;
+    }
+    return count;
+}
+
+static void eth_recv_callback(NetDriver::Frame &frame) {
     /* Allocate pbuf from pool */
-    struct pbuf *p = pbuf_alloc(PBUF_RAW, size, PBUF_POOL);
+    struct pbuf *p = pbuf_alloc(PBUF_RAW, static_cast<u16_t>(frame.size()), PBUF_POOL);
 
     if(p != NULL) {
-        /* Copy ethernet frame into pbuf */
-        pbuf_take(p, pkt, size);
+        /* Let the driver copy the ethernet frame directly into the pbuf */
+        NetDriver::IOVec iov[MAX_FRAGMENTS];
+        size_t count = pbuf_to_iov(p, iov);
+        if(count == 0 || !frame.read(iov, count)) {
+            SLOG(NET, "Unable to read frame of " << frame.size() << " bytes");
+            pbuf_free(p);
+            return;
+        }
 
         /* Put in a queue which is processed in main loop */
         recvQueue.push(p);
-        //if(!recvQueue.push(p)) {
-        //  /* queue is full -> packet loss */
-        //  pbuf_free(p);
-        //}
     }
 }
 
 static err_t netif_output(struct netif *netif, struct pbuf *p) {
     LINK_STATS_INC(link.xmit);
 
-    SLOG(NET, "netif_output with size " << p->len);
+    SLOG(NET, "netif_output with size " << p->tot_len);
+
+    /* Start MAC transmit here; the driver copies the pbuf chain directly into its buffers */
+    NetDriver *driver = static_cast<NetDriver*>(netif->state);
+    NetDriver::IOVec iov[MAX_FRAGMENTS];
+    size_t count = pbuf_to_iov(p, iov);
+    bool res;
+    if(count > 0)
+        res = driver->sendv(iov, count);
+    else {
+        uint8_t *pkt = (uint8_t*)malloc(p->tot_len);
+        if(!pkt) {
+            SLOG(NET, "Not enough memory to read packet");
+            return ERR_MEM;
+        }
 
-    uint8_t *pkt = (uint8_t*)malloc(p->tot_len);
-    if(!pkt) {
-        SLOG(NET, "Not enough memory to read packet");
-        return ERR_MEM;
+        pbuf_copy_partial(p, pkt, p->tot_len, 0);
+        res = driver->send(pkt, p->tot_len);
+        free(pkt);
     }
 
-    pbuf_copy_partial(p, pkt, p->tot_len, 0);
-    /* Start MAC transmit here */
-    E1000 *e1000 = static_cast<E1000*>(netif->state);
-    if(!e1000->send(pkt, p->tot_len)) {
-        free(pkt);
+    if(!res) {
         SLOG(NET, "netif_output failed!");
         return ERR_IF;
     }
-
-    free(pkt);
     return ERR_OK;
 }
 
@@ -558,7 +878,7 @@ static void netif_status_callback(struct netif *netif) {
 }
 
 static err_t netif_init(struct netif *netif) {
-    E1000 *e1000 = static_cast<E1000*>(netif->state);
+    NetDriver *driver = static_cast<NetDriver*>(netif->state);
 
     netif->linkoutput = netif_output;
     netif->output = etharp_output;
@@ -567,7 +887,7 @@ static err_t netif_init(struct netif *netif) {
     netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET |
                    NETIF_FLAG_IGMP | NETIF_FLAG_MLD6;
 
-    m3::net::MAC mac = e1000->readMAC();
+    m3::net::MAC mac = driver->readMAC();
     static_assert(m3::net::MAC::LEN == sizeof(netif->hwaddr), "mac address size mismatch");
     SMEMCPY(netif->hwaddr, mac.bytes(), m3::net::MAC::LEN);
     netif->hwaddr_len = sizeof(netif->hwaddr);
@@ -576,11 +896,11 @@ static err_t netif_init(struct netif *netif) {
 }
 
 static bool link_state_changed(struct netif *netif) {
-    return static_cast<E1000 *>(netif->state)->linkStateChanged();
+    return static_cast<NetDriver*>(netif->state)->linkStateChanged();
 }
 
 static bool link_is_up(struct netif *netif) {
-    return static_cast<E1000 *>(netif->state)->linkIsUp();
+    return static_cast<NetDriver*>(netif->state)->linkIsUp();
 }
 
 int main(int argc, char **argv) {
@@ -600,13 +920,18 @@ int main(int argc, char **argv) {
 
     struct netif netif;
 
+#if defined(__gem5__)
     pci::ProxiedPciDevice nic("nic", m3::PEISA::NIC);
-    E1000 e1000(nic);
-    e1000.setReceiveCallback(&eth_recv_callback);
+    E1000 driver(nic);
+#else
+    VirtNIC driver;
+#endif
+    driver.setReceiveCallback(&eth_recv_callback);
 
     lwip_init();
 
-    netif_add(&netif, &ip, &netmask, IP4_ADDR_ANY, &e1000, netif_init, netif_input);
+    netif_add(&netif, &ip, &netmask, IP4_ADDR_ANY, static_cast<NetDriver*>(&driver),
+              netif_init, netif_input);
     netif.name[0] = 'e';
     netif.name[1] = '0';
     // netif_create_ip6_linklocal_address(&netif, 1);
@@ -647,6 +972,9 @@ int main(int argc, char **argv) {
         // Hack: run the workloop manually
         // - interrupt receive gate
         env()->workloop()->tick();
+
+        /* Let the driver transmit the frames of this round at once and poll for new ones */
+        driver.poll();
     }
 
     return 0;
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+
+#include <m3/session/NetworkManager.h>
+#include <m3/stream/Standard.h>
+
+using namespace m3;
+
+int main(int argc, char **argv) {
+    const char *message = "GTO____";
+    if(argc == 2)
+        message = argv[1];
+    size_t msglen = strlen(message) + 1;
+    if(msglen > 256)
+        exitmsg("Message is too long");
+
+    NetworkManager net("net0");
+
+    InetSocket *socket = net.create(NetworkManager::SOCK_STREAM);
+    if(!socket)
+        exitmsg("Socket creation failed.");
+
+    if(socket->connect(IpAddr(192, 168, 112, 1), 1338) != Errors::NONE)
+        exitmsg("Socket connect failed:" << Errors::to_string(Errors::last));
+    cout << "Connected.\n";
+
+    for(int i = 0; i < 10; ++i) {
+        ssize_t len = socket->send(message, msglen);
+        cout << "Sent " << len << " bytes\n";
+
+        // the stream might deliver the response in pieces
+        char response[256];
+        size_t total = 0;
+        while(total < msglen) {
+            len = socket->recv(response + total, msglen - total);
+            if(len <= 0)
+                exitmsg("Connection closed by server");
+            total += static_cast<size_t>(len);
+        }
+        cout << "Received response: " << response << "\n";
+    }
+
+    socket->close();
+    delete socket;
+    return 0;
+}
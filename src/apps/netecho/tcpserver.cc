@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+
+#include <m3/session/NetworkManager.h>
+#include <m3/stream/Standard.h>
+
+using namespace m3;
+
+int main() {
+    NetworkManager net("net1");
+
+    InetSocket *socket = net.create(NetworkManager::SOCK_STREAM);
+    if(!socket)
+        exitmsg("Socket creation failed.");
+
+    if(socket->bind(IpAddr(192, 168, 112, 1), 1338) != Errors::NONE)
+        exitmsg("Socket bind failed:" << Errors::to_string(Errors::last));
+    if(socket->listen() != Errors::NONE)
+        exitmsg("Socket listen failed:" << Errors::to_string(Errors::last));
+
+    while(true) {
+        cout << "Waiting for connection...\n";
+        InetSocket *conn = socket->accept();
+        if(!conn)
+            exitmsg("Socket accept failed:" << Errors::to_string(Errors::last));
+        cout << "Accepted connection " << conn->sd() << "\n";
+
+        char buf[256];
+        ssize_t len;
+        while((len = conn->recv(buf, sizeof(buf))) > 0) {
+            if(conn->send(buf, static_cast<size_t>(len)) != len)
+                break;
+        }
+
+        cout << "Connection " << conn->sd() << " closed\n";
+        conn->close();
+        delete conn;
+    }
+}
@@ -142,7 +142,7 @@ m3::Errors::Code ExternalDataSpace::handle_pf(goff_t vaddr) {
         if(!(_flags & m3::Pager::MAP_SHARED) && (_flags & m3::DTU::PTE_W)) {
             m3::MemGate src(m3::MemGate::bind(sel, 0));
             reg->mem(new PhysMem(_as->mem, addr(), reg->size(), m3::MemGate::RWX));
-            copy_block(&src, reg->mem()->gate, reg->mem_offset(), reg->size());
+            reg->mem()->gate->copy_from(src, reg->mem_offset(), reg->size(), 0);
             reg->mem_offset(0);
         }
         else
@@ -22,17 +22,6 @@
 #include "DataSpace.h"
 #include "Region.h"
 
-alignas(64) static char zeros[4096];
-alignas(64) static char tmpbuf[4096];
-
-void copy_block(m3::MemGate *src, m3::MemGate *dst, size_t srcoff, size_t size) {
-    size_t pages = size >> PAGE_BITS;
-    for(size_t i = 0; i < pages; ++i) {
-        src->read (tmpbuf, sizeof(tmpbuf), srcoff + i * PAGE_SIZE);
-        dst->write(tmpbuf, sizeof(tmpbuf), i * PAGE_SIZE);
-    }
-}
-
 Region::~Region() {
     // if another address space still uses this, we still want to unmap it from this one
     if(_ds->addrspace_alive() && _mapped && has_mem() && !_mem->is_last()) {
@@ -95,7 +84,7 @@ void Region::copy(m3::MemGate *mem, goff_t virt) {
     // make sure that the other users of this memory don't continue (in copy()) until this is done
     // TODO if the owner unmaps the memory, we have a problem
     _copying = true;
-    copy_block(ogate, ngate, off, size());
+    ngate->copy_from(*ogate, off, size(), 0);
     _copying = false;
     m3::ThreadManager::get().notify(reinterpret_cast<event_t>(this));
 
@@ -116,7 +105,5 @@ void Region::copy(m3::MemGate *mem, goff_t virt) {
 }
 
 void Region::clear() {
-    size_t pages = size() >> PAGE_BITS;
-    for(size_t i = 0; i < pages; ++i)
-        _mem->gate->write(zeros, sizeof(zeros), i * PAGE_SIZE);
+    _mem->gate->zero(size(), 0);
 }
@@ -26,8 +26,6 @@
 
 #include "PhysMem.h"
 
-void copy_block(m3::MemGate *src, m3::MemGate *dst, size_t srcoff, size_t size);
-
 class DataSpace;
 
 /**
@@ -46,13 +46,12 @@ public:
     explicit MemReqHandler()
         : base_class_t(),
           _rgate(RecvGate::create(nextlog2<32 * MSG_SIZE>::val, nextlog2<MSG_SIZE>::val)) {
-        add_operation(Pager::PAGEFAULT, &MemReqHandler::pf);
-        add_operation(Pager::CLONE, &MemReqHandler::clone);
-        add_operation(Pager::MAP_ANON, &MemReqHandler::map_anon);
-        add_operation(Pager::UNMAP, &MemReqHandler::unmap);
+        add_operation<&MemReqHandler::pf>(Pager::PAGEFAULT);
+        add_operation<&MemReqHandler::clone>(Pager::CLONE);
+        add_operation<&MemReqHandler::map_anon>(Pager::MAP_ANON);
+        add_operation<&MemReqHandler::unmap>(Pager::UNMAP);
 
-        using std::placeholders::_1;
-        _rgate.start(std::bind(&MemReqHandler::handle_message, this, _1));
+        _rgate.start<base_class_t, &base_class_t::handle_message>(this);
     }
 
     virtual Errors::Code open(AddrSpace **sess, capsel_t srv_sel, word_t) override {
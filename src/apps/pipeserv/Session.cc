@@ -59,8 +59,6 @@ PipeData::PipeData(capsel_t srv_sel, m3::RecvGate *rgate, size_t _memsize)
       workitem(),
       reader(),
       writer(),
-      last_reader(),
-      last_writer(),
       pending_reads(),
       pending_writes() {
     workitem.pipe = this;
@@ -97,12 +95,14 @@ PipeChannel *PipeData::attach(capsel_t _sel, bool read) {
 size_t PipeData::get_read_size() const {
     // TODO hand out less, if it is above a certain threshold
     assert(reader.length() > 0);
-    return rbuf.size() / static_cast<size_t>(4 * reader.length());
+    size_t size = rbuf.size() / static_cast<size_t>(4 * reader.length());
+    return Math::max(Math::round_dn(size, DTU_PKG_SIZE), static_cast<size_t>(DTU_PKG_SIZE));
 }
 
 size_t PipeData::get_write_size() const {
     assert(writer.length() > 0);
-    return rbuf.size() / static_cast<size_t>(4 * writer.length());
+    size_t size = rbuf.size() / static_cast<size_t>(4 * writer.length());
+    return Math::max(Math::round_dn(size, DTU_PKG_SIZE), static_cast<size_t>(DTU_PKG_SIZE));
 }
 
 PipeChannel *PipeChannel::clone(capsel_t _sel) const {
@@ -114,7 +114,7 @@ PipeChannel::PipeChannel(PipeData *_pipe, capsel_t _sel)
       m3::SListItem(),
       id(_pipe->nextid++),
       epcap(ObjCap::INVALID),
-      lastamount(),
+      seg(),
       sgate(m3::SendGate::create(_pipe->rgate, reinterpret_cast<label_t>(this), 64, nullptr, sel() + 1)),
       memory(),
       pipe(_pipe) {
@@ -144,10 +144,10 @@ Errors::Code PipeReadChannel::close() {
     if(pipe->flags & READ_EOF)
         return Errors::INV_ARGS;
 
-    if(pipe->last_reader == this) {
+    if(seg) {
         PRINTCHAN(pipe, id, "read-pull: 0");
-        pipe->rbuf.pull(0);
-        pipe->last_reader = nullptr;
+        pipe->rbuf.commit_read(seg, 0);
+        seg = nullptr;
     }
 
     pipe->reader.remove(this);
@@ -169,16 +169,11 @@ void PipeReadChannel::read(GateIStream &is, size_t commit) {
         return;
     }
 
-    if(pipe->last_reader) {
-        if(pipe->last_reader != this) {
-            append_request(pipe, is);
-            return;
-        }
-
-        size_t amount = commit == 0 ? lastamount : commit;
+    if(seg) {
+        size_t amount = commit == 0 ? seg->len : commit;
         PRINTCHAN(pipe, id, "read-pull: " << amount);
-        pipe->rbuf.pull(amount);
-        pipe->last_reader = nullptr;
+        pipe->rbuf.commit_read(seg, amount);
+        seg = nullptr;
     }
 
     if(commit > 0) {
@@ -193,21 +188,18 @@ void PipeReadChannel::read(GateIStream &is, size_t commit) {
         }
     }
 
-    size_t amount = pipe->get_read_size();
-    ssize_t pos = pipe->rbuf.get_read_pos(&amount);
-    if(pos == -1) {
+    seg = pipe->rbuf.reserve_read(pipe->get_read_size());
+    if(seg == nullptr) {
         if(pipe->flags & WRITE_EOF) {
             PRINTCHAN(pipe, id, "read: EOF");
-            reply_vmsg(is, Errors::NONE, (size_t)0, (size_t)0);
+            reply_vmsg(is, Errors::NONE, (size_t)0, (size_t)0, false);
         }
         else
             append_request(pipe, is);
     }
     else {
-        pipe->last_reader = this;
-        lastamount = amount;
-        PRINTCHAN(pipe, id, "read: " << amount << " @" << pos);
-        reply_vmsg(is, Errors::NONE, pos, amount);
+        PRINTCHAN(pipe, id, "read: " << seg->len << " @" << seg->pos);
+        reply_vmsg(is, Errors::NONE, seg->pos, seg->len, false);
     }
 }
 
@@ -218,26 +210,21 @@ void PipeReadChannel::append_request(PipeData *pipe, GateIStream &is) {
 }
 
 void PipeData::handle_pending_read() {
-    if(last_reader)
-        return;
-
+    // hand out data to as many readers as possible, in the order in which they asked for it
     while(pending_reads.length() > 0) {
         PipeData::RdWrRequest<PipeReadChannel> *req = &*pending_reads.begin();
-        size_t ramount = get_read_size();
-        ssize_t rpos = rbuf.get_read_pos(&ramount);
-        if(rpos != -1) {
+        VarRingBuf::Segment *seg = rbuf.reserve_read(get_read_size());
+        if(seg) {
             pending_reads.remove_first();
-            last_reader = req->chan;
-            req->chan->lastamount = ramount;
-            PRINTCHAN(this, req->chan->id, "late-read: " << ramount << " @" << rpos);
-            reply_vmsg_late(*rgate, req->lastmsg, Errors::NONE, rpos, ramount);
+            req->chan->seg = seg;
+            PRINTCHAN(this, req->chan->id, "late-read: " << seg->len << " @" << seg->pos);
+            reply_vmsg_late(*rgate, req->lastmsg, Errors::NONE, seg->pos, seg->len, false);
             delete req;
-            break;
         }
         else if(flags & PipeChannel::WRITE_EOF) {
             pending_reads.remove_first();
             PRINTCHAN(this, req->chan->id, "late-read: EOF");
-            reply_vmsg_late(*rgate, req->lastmsg, Errors::NONE, (size_t)0, (size_t)0);
+            reply_vmsg_late(*rgate, req->lastmsg, Errors::NONE, (size_t)0, (size_t)0, false);
             delete req;
         }
         else
@@ -251,10 +238,10 @@ Errors::Code PipeWriteChannel::close() {
     if(pipe->flags & WRITE_EOF)
         return Errors::INV_ARGS;
 
-    if(pipe->last_writer == this && lastamount != static_cast<size_t>(-1)) {
+    if(seg) {
         PRINTCHAN(pipe, id, "write-push: 0");
-        pipe->rbuf.push(lastamount, 0);
-        pipe->last_writer = nullptr;
+        pipe->rbuf.commit_write(seg, 0);
+        seg = nullptr;
     }
 
     pipe->writer.remove(this);
@@ -282,16 +269,11 @@ void PipeWriteChannel::write(GateIStream &is, size_t commit) {
         return;
     }
 
-    if(pipe->last_writer) {
-        if(pipe->last_writer != this) {
-            append_request(pipe, is);
-            return;
-        }
-
-        size_t amount = commit == 0 ? lastamount : commit;
+    if(seg) {
+        size_t amount = commit == 0 ? seg->len : commit;
         PRINTCHAN(pipe, id, "write-push: " << amount);
-        pipe->rbuf.push(lastamount, amount);
-        pipe->last_writer = nullptr;
+        pipe->rbuf.commit_write(seg, amount);
+        seg = nullptr;
     }
 
     if(commit > 0) {
@@ -304,15 +286,12 @@ void PipeWriteChannel::write(GateIStream &is, size_t commit) {
         return;
     }
 
-    size_t amount = pipe->get_write_size();
-    ssize_t pos = pipe->rbuf.get_write_pos(amount);
-    if(pos == -1)
+    seg = pipe->rbuf.reserve_write(pipe->get_write_size());
+    if(seg == nullptr)
         append_request(pipe, is);
     else {
-        pipe->last_writer = this;
-        lastamount = amount;
-        PRINTCHAN(pipe, id, "write: " << amount << " @" << pos);
-        reply_vmsg(is, Errors::NONE, pos, amount);
+        PRINTCHAN(pipe, id, "write: " << seg->len << " @" << seg->pos);
+        reply_vmsg(is, Errors::NONE, seg->pos, seg->len, false);
     }
 }
 
@@ -323,9 +302,6 @@ void PipeWriteChannel::append_request(PipeData *pipe, GateIStream &is) {
 }
 
 void PipeData::handle_pending_write() {
-    if(last_writer)
-        return;
-
     if(flags & PipeChannel::READ_EOF) {
         while(pending_writes.length() > 0) {
             PipeData::RdWrRequest<PipeWriteChannel> *req = pending_writes.remove_first();
@@ -334,17 +310,18 @@ void PipeData::handle_pending_write() {
             delete req;
         }
     }
-    else if(pending_writes.length() > 0) {
-        PipeData::RdWrRequest<PipeWriteChannel> *req = &*pending_writes.begin();
-        size_t amount = get_write_size();
-        ssize_t wpos = rbuf.get_write_pos(amount);
-        if(wpos != -1) {
-            pending_writes.remove_first();
+    else {
+        // multiple writers can fill their windows concurrently
+        while(pending_writes.length() > 0) {
+            PipeData::RdWrRequest<PipeWriteChannel> *req = &*pending_writes.begin();
+            VarRingBuf::Segment *seg = rbuf.reserve_write(get_write_size());
+            if(!seg)
+                break;
 
-            last_writer = req->chan;
-            req->chan->lastamount = amount;
-            PRINTCHAN(this, req->chan->id, "late-write: " << amount << " @" << wpos);
-            reply_vmsg_late(*rgate, req->lastmsg, Errors::NONE, wpos, amount);
+            pending_writes.remove_first();
+            req->chan->seg = seg;
+            PRINTCHAN(this, req->chan->id, "late-write: " << seg->len << " @" << seg->pos);
+            reply_vmsg_late(*rgate, req->lastmsg, Errors::NONE, seg->pos, seg->len, false);
             delete req;
         }
     }
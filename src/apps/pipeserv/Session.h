@@ -83,7 +83,8 @@ public:
 
     int id;
     capsel_t epcap;
-    size_t lastamount;
+    // the currently handed out window, if any
+    VarRingBuf::Segment *seg;
     m3::SendGate sgate;
     m3::MemGate *memory;
     PipeData *pipe;
@@ -172,8 +173,6 @@ public:
     WorkItem workitem;
     m3::SList<PipeReadChannel> reader;
     m3::SList<PipeWriteChannel> writer;
-    PipeReadChannel *last_reader;
-    PipeWriteChannel *last_writer;
     m3::SList<RdWrRequest<PipeReadChannel>> pending_reads;
     m3::SList<RdWrRequest<PipeWriteChannel>> pending_writes;
 };
@@ -14,99 +14,208 @@
  * General Public License version 2 for more details.
  */
 
+#pragma once
+
 #include <base/Common.h>
+#include <base/col/SList.h>
 #include <base/stream/OStream.h>
 #include <base/util/Math.h>
 #include <base/DTU.h>
 
-#include <algorithm>
-
 #if !defined(SINGLE_ITEM_BUF)
 #   define SINGLE_ITEM_BUF  0
 #endif
 
+/**
+ * A ring buffer that hands out windows (segments) to multiple writers and readers at once. The
+ * segments are kept in the order in which they have been reserved. Readers get the oldest data
+ * that has been committed, and space is reclaimed in order as soon as the oldest segments have
+ * been consumed.
+ *
+ * In message mode, every committed write window is a message, which is handed out to a reader
+ * as a whole and consumed as a whole. Thus, the messages are delimited by the commits (flushes)
+ * of the writers, not by their individual writes.
+ */
 class VarRingBuf {
 public:
+    enum State {
+        WRITING,
+        FULL,
+        READING,
+        DONE,
+    };
+
+    struct Segment : public m3::SListItem {
+        explicit Segment(size_t _start, size_t _end)
+            : m3::SListItem(),
+              start(_start),
+              end(_end),
+              pos(_start),
+              len(_end - _start),
+              state(WRITING) {
+        }
+
+        // the occupied part of the buffer
+        size_t start;
+        size_t end;
+        // the data within it
+        size_t pos;
+        size_t len;
+        State state;
+    };
+
     explicit VarRingBuf(size_t size)
         : _size(size),
+          _msgs(),
           _rdpos(),
           _wrpos(),
-          _last(size) {
-        assert((size & DTU_PKG_SIZE) == 0);
+          _segs() {
+        assert((size % DTU_PKG_SIZE) == 0);
+    }
+    ~VarRingBuf() {
+        while(!empty())
+            delete _segs.remove_first();
     }
 
     bool empty() const {
-        return _rdpos == _wrpos;
+        return _segs.length() == 0;
     }
     size_t size() const {
         return _size;
     }
 
-    ssize_t get_write_pos(size_t size) {
-        if(SINGLE_ITEM_BUF || (_wrpos % DTU_PKG_SIZE)) {
-            if(!empty())
-                return -1;
-            _wrpos = m3::Math::round_up(_wrpos, DTU_PKG_SIZE);
-            _rdpos = _wrpos;
-        }
+    bool messages() const {
+        return _msgs;
+    }
+    void messages(bool msgs) {
+        _msgs = msgs;
+    }
+
+    /**
+     * Reserves a window of at most <size> bytes for writing.
+     *
+     * @param size the desired size
+     * @return the segment or nullptr if the buffer is full
+     */
+    Segment *reserve_write(size_t size) {
+        if(SINGLE_ITEM_BUF && !empty())
+            return nullptr;
 
-        if(_wrpos >= _rdpos) {
-            if(_size - _wrpos >= size)
-                return static_cast<ssize_t>(_wrpos);
-            else if(_rdpos > size)
-                return 0;
+        size_t start, avail;
+        if(empty() || _wrpos > _rdpos) {
+            size_t tail = _size - _wrpos;
+            size_t head = empty() ? 0 : _rdpos;
+            // wrap around, if there is more space at the beginning than at the end
+            if(tail >= size || tail >= head) {
+                start = _wrpos;
+                avail = tail;
+            }
+            else {
+                start = 0;
+                avail = head;
+            }
+        }
+        else {
+            start = _wrpos;
+            avail = _rdpos - _wrpos;
         }
-        else if(_rdpos - _wrpos > size)
-            return static_cast<ssize_t>(_wrpos);
-        return -1;
+        if(avail == 0)
+            return nullptr;
+
+        Segment *seg = new Segment(start, start + m3::Math::min(size, avail));
+        _segs.append(seg);
+        _wrpos = seg->end;
+        return seg;
     }
 
-    ssize_t get_read_pos(size_t *size) {
-        if(_wrpos == _rdpos)
-            return -1;
+    /**
+     * Commits the write window <seg>, of which <amount> bytes have been written.
+     *
+     * @param seg the segment
+     * @param amount the number of written bytes
+     */
+    void commit_write(Segment *seg, size_t amount) {
+        assert(seg->state == WRITING && amount <= seg->len);
+        seg->len = amount;
+        seg->state = amount > 0 ? FULL : DONE;
 
-        size_t rpos = _rdpos;
-        if(rpos == _last)
-            rpos = 0;
-        if(_wrpos > rpos)
-            *size = std::min(_wrpos - rpos,*size);
-        else
-            *size = std::min(std::min(_size, _last) - rpos,*size);
-        return static_cast<ssize_t>(rpos);
+        // give the unused space back, if no one has reserved space behind us. the segment
+        // boundaries have to stay aligned and we can't grow beyond the reserved space.
+        if(&*_segs.tail() == seg) {
+            seg->end = m3::Math::min(seg->end, m3::Math::round_up(seg->start + amount, DTU_PKG_SIZE));
+            _wrpos = seg->end;
+        }
+        free_segments();
     }
 
-    void push(size_t req_size, size_t size) {
-        assert((_wrpos % DTU_PKG_SIZE) == 0);
+    /**
+     * Reserves the oldest committed data for reading. In byte-stream mode, at most <size> bytes
+     * are handed out, whereas in message mode, always a complete message is handed out.
+     *
+     * @param size the desired size
+     * @return the segment or nullptr if there is no data
+     */
+    Segment *reserve_read(size_t size) {
+        for(auto seg = _segs.begin(); seg != _segs.end(); ++seg) {
+            if(seg->state != FULL)
+                continue;
 
-        if(_wrpos >= _rdpos) {
-            if(_size - _wrpos >= req_size)
-                _wrpos += size;
-            else if(_rdpos > req_size && size > 0) {
-                _last = _wrpos;
-                _wrpos = size;
+            // let other readers fetch the remaining data in parallel. the split point has to be
+            // aligned, because the segment boundaries determine the read and write positions.
+            size_t split = m3::Math::round_up(seg->pos + size, DTU_PKG_SIZE);
+            if(!_msgs && size > 0 && split < seg->pos + seg->len) {
+                Segment *rest = new Segment(split, seg->end);
+                rest->len = seg->pos + seg->len - split;
+                rest->state = FULL;
+                _segs.insert(&*seg, rest);
+                seg->end = split;
+                seg->len = split - seg->pos;
             }
+            seg->state = READING;
+            return &*seg;
         }
-        else if(_rdpos - _wrpos > req_size)
-            _wrpos += size;
+        return nullptr;
     }
 
-    void pull(size_t size) {
-        assert(!empty());
-        if(_rdpos == _last) {
-            _rdpos = 0;
-            _last = _size;
+    /**
+     * Commits the read window <seg>, of which <amount> bytes have been consumed. In message mode,
+     * every amount but zero consumes the whole message.
+     *
+     * @param seg the segment
+     * @param amount the number of consumed bytes
+     */
+    void commit_read(Segment *seg, size_t amount) {
+        assert(seg->state == READING);
+        if(amount == 0)
+            seg->state = FULL;
+        else if(_msgs || amount >= seg->len)
+            seg->state = DONE;
+        else {
+            seg->pos += amount;
+            seg->len -= amount;
+            seg->state = FULL;
         }
-        _rdpos += size;
+        free_segments();
     }
 
     friend m3::OStream &operator<<(m3::OStream &os, const VarRingBuf &r) {
-        os << "RingBuf[rd=" << r._rdpos << ",wr=" << r._wrpos << ",last=" << r._last << "]";
+        os << "RingBuf[rd=" << r._rdpos << ",wr=" << r._wrpos << ",segs=" << r._segs.length() << "]";
         return os;
     }
 
 private:
+    void free_segments() {
+        while(!empty() && _segs.begin()->state == DONE)
+            delete _segs.remove_first();
+        if(empty())
+            _rdpos = _wrpos = 0;
+        else
+            _rdpos = _segs.begin()->start;
+    }
+
     size_t _size;
+    bool _msgs;
     size_t _rdpos;
     size_t _wrpos;
-    size_t _last;
+    m3::SList<Segment> _segs;
 };
@@ -23,6 +23,8 @@
 #include <m3/server/RequestHandler.h>
 #include <m3/session/Pipe.h>
 
+#include <stdlib.h>
+
 #include "Session.h"
 
 using namespace m3;
@@ -37,18 +39,18 @@ static Server<PipeServiceHandler> *srv;
 class PipeServiceHandler : public base_class {
 public:
     static constexpr size_t MSG_SIZE = 64;
+    static constexpr uint MSG_BATCH = 8;
 
     explicit PipeServiceHandler()
         : base_class(),
           _rgate(RecvGate::create(nextlog2<32 * MSG_SIZE>::val, nextlog2<MSG_SIZE>::val)) {
-        add_operation(GenericFile::SEEK, &PipeServiceHandler::invalid_op);
-        add_operation(GenericFile::STAT, &PipeServiceHandler::invalid_op);
-        add_operation(GenericFile::NEXT_IN, &PipeServiceHandler::next_in);
-        add_operation(GenericFile::NEXT_OUT, &PipeServiceHandler::next_out);
-        add_operation(GenericFile::COMMIT, &PipeServiceHandler::commit);
-
-        using std::placeholders::_1;
-        _rgate.start(std::bind(&PipeServiceHandler::handle_message, this, _1));
+        add_operation<&PipeServiceHandler::invalid_op>(GenericFile::SEEK);
+        add_operation<&PipeServiceHandler::invalid_op>(GenericFile::STAT);
+        add_operation<&PipeServiceHandler::next_in>(GenericFile::NEXT_IN);
+        add_operation<&PipeServiceHandler::next_out>(GenericFile::NEXT_OUT);
+        add_operation<&PipeServiceHandler::commit>(GenericFile::COMMIT);
+
+        _rgate.start<base_class, &base_class::handle_message>(this, MSG_BATCH);
     }
 
     virtual Errors::Code open(PipeSession **sess, capsel_t srv_sel, word_t arg) override {
@@ -74,11 +76,15 @@ public:
 
     virtual Errors::Code delegate(PipeSession *sess, KIF::Service::ExchangeData &data) override {
         if(sess->type() == PipeSession::META) {
-            if(data.caps != 1 || data.args.count != 0 || static_cast<PipeData*>(sess)->memory)
+            PipeData *pipe = static_cast<PipeData*>(sess);
+            if(data.caps != 1 || data.args.count > 1 || pipe->memory)
                 return Errors::INV_ARGS;
 
+            if(data.args.count == 1)
+                pipe->rbuf.messages(data.args.vals[0] & Pipe::MESSAGES);
+
             capsel_t sel = VPE::self().alloc_sel();
-            static_cast<PipeData*>(sess)->memory = new MemGate(MemGate::bind(sel));
+            pipe->memory = new MemGate(MemGate::bind(sel));
             data.caps = KIF::CapRngDesc(KIF::CapRngDesc::OBJ, sel, data.caps).value();
         }
         else {
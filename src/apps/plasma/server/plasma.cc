@@ -369,10 +369,10 @@ using plasma_reqh_base_t = SimpleRequestHandler<PlasmaRequestHandler, Plasma::Op
 class PlasmaRequestHandler : public plasma_reqh_base_t {
 public:
     explicit PlasmaRequestHandler() : plasma_reqh_base_t() {
-        add_operation(Plasma::LEFT, &PlasmaRequestHandler::left);
-        add_operation(Plasma::RIGHT, &PlasmaRequestHandler::right);
-        add_operation(Plasma::COLUP, &PlasmaRequestHandler::colup);
-        add_operation(Plasma::COLDOWN, &PlasmaRequestHandler::coldown);
+        add_operation<&PlasmaRequestHandler::left>(Plasma::LEFT);
+        add_operation<&PlasmaRequestHandler::right>(Plasma::RIGHT);
+        add_operation<&PlasmaRequestHandler::colup>(Plasma::COLUP);
+        add_operation<&PlasmaRequestHandler::coldown>(Plasma::COLDOWN);
     }
 
     void left(GateIStream &is) {
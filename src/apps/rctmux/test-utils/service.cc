@@ -34,7 +34,7 @@ public:
     explicit TestRequestHandler()
         : base_class(),
           _cnt() {
-        add_operation(TEST, &TestRequestHandler::test);
+        add_operation<&TestRequestHandler::test>(TEST);
     }
 
     void test(GateIStream &is) {
@@ -64,7 +64,9 @@ fn push_back() {
         }
     }
 
-    println!("Appending 100 elements: {}", prof.runner_with_id(&mut ListTester::default(), 0x60));
+    let res = prof.runner_with_id(&mut ListTester::default(), 0x60);
+    println!("Appending 100 elements: {}", res);
+    println!("{}", res.json("boxlist_push_back", 0, 0));
 }
 
 fn push_front() {
@@ -84,7 +86,9 @@ fn push_front() {
         }
     }
 
-    println!("Prepending 100 elements: {}", prof.runner_with_id(&mut ListTester::default(), 0x61));
+    let res = prof.runner_with_id(&mut ListTester::default(), 0x61);
+    println!("Prepending 100 elements: {}", res);
+    println!("{}", res.json("boxlist_push_front", 0, 0));
 }
 
 fn push_pop() {
@@ -107,7 +111,9 @@ fn push_pop() {
         }
     }
 
-    println!("Prepending 1 element: {}", prof.runner_with_id(&mut ListTester::default(), 0x62));
+    let res = prof.runner_with_id(&mut ListTester::default(), 0x62);
+    println!("Prepending 1 element: {}", res);
+    println!("{}", res.json("boxlist_push_pop", 0, 0));
 }
 
 fn clear() {
@@ -127,5 +133,7 @@ fn clear() {
         }
     }
 
-    println!("Clearing 100-element list: {}", prof.runner_with_id(&mut ListTester::default(), 0x63));
+    let res = prof.runner_with_id(&mut ListTester::default(), 0x63);
+    println!("Clearing 100-element list: {}", res);
+    println!("{}", res.json("boxlist_clear", 0, 0));
 }
@@ -41,7 +41,9 @@ fn push_back() {
         }
     }
 
-    println!("Appending 100 elements: {}", prof.runner_with_id(&mut ListTester::default(), 0x50));
+    let res = prof.runner_with_id(&mut ListTester::default(), 0x50);
+    println!("Appending 100 elements: {}", res);
+    println!("{}", res.json("dlist_push_back", 0, 0));
 }
 
 fn push_front() {
@@ -61,7 +63,9 @@ fn push_front() {
         }
     }
 
-    println!("Prepending 100 elements: {}", prof.runner_with_id(&mut ListTester::default(), 0x51));
+    let res = prof.runner_with_id(&mut ListTester::default(), 0x51);
+    println!("Prepending 100 elements: {}", res);
+    println!("{}", res.json("dlist_push_front", 0, 0));
 }
 
 fn clear() {
@@ -81,5 +85,7 @@ fn clear() {
         }
     }
 
-    println!("Clearing 100-element list: {}", prof.runner_with_id(&mut ListTester::default(), 0x52));
+    let res = prof.runner_with_id(&mut ListTester::default(), 0x52);
+    println!("Clearing 100-element list: {}", res);
+    println!("{}", res.json("dlist_clear", 0, 0));
 }
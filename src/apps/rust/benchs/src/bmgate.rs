@@ -15,6 +15,7 @@
  */
 
 use m3::com::MemGate;
+use m3::io;
 use m3::kif;
 use m3::profile;
 use m3::test;
@@ -24,6 +25,7 @@ const SIZE: usize = 2 * 1024 * 1024;
 pub fn run(t: &mut test::Tester) {
     run_test!(t, read);
     run_test!(t, write);
+    run_test!(t, read_sizes);
 }
 
 fn read() {
@@ -32,13 +34,15 @@ fn read() {
 
     let mut prof = profile::Profiler::new().repeats(2).warmup(1);
 
-    println!("2 MiB with 8K buf: {}", prof.run_with_id(|| {
+    let res = prof.run_with_id(|| {
         let mut total = 0;
         while total < SIZE {
             mgate.read(&mut buf, 0).expect("Reading failed");
             total += buf.len();
         }
-    }, 0x30));
+    }, 0x30);
+    println!("2 MiB with 8K buf: {}", res);
+    println!("{}", res.json("mgate_read", buf.len(), SIZE));
 }
 
 fn write() {
@@ -47,11 +51,24 @@ fn write() {
 
     let mut prof = profile::Profiler::new().repeats(2).warmup(1);
 
-    println!("2 MiB with 8K buf: {}", prof.run_with_id(|| {
+    let res = prof.run_with_id(|| {
         let mut total = 0;
         while total < SIZE {
             mgate.write(&buf, 0).expect("Writing failed");
             total += buf.len();
         }
-    }, 0x31));
+    }, 0x31);
+    println!("2 MiB with 8K buf: {}", res);
+    println!("{}", res.json("mgate_write", buf.len(), SIZE));
+}
+
+fn read_sizes() {
+    let mut buf = vec![0u8; 8192];
+    let mgate = MemGate::new(8192, kif::Perm::R).expect("Unable to create mgate");
+
+    let mut prof = profile::Profiler::new().repeats(50).warmup(5);
+
+    prof.sweep(io::stdout(), "mgate_read_size", &[64, 256, 1024, 4096, 8192], |size| {
+        mgate.read(&mut buf[0..size], 0).expect("Reading failed");
+    }, 0x32, true);
 }
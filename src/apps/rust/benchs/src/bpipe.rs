@@ -34,71 +34,73 @@ pub fn run(t: &mut test::Tester) {
 fn child_to_parent() {
     let mut prof = profile::Profiler::new().repeats(2).warmup(1);
 
-    println!("c->p: {} KiB transfer with {} KiB buf: {}", DATA_SIZE / 1024, BUF_SIZE / 1024,
-        prof.run_with_id(|| {
-            let pipe_mem = assert_ok!(MemGate::new(0x10000, kif::Perm::RW));
-            let pipe = assert_ok!(IndirectPipe::new(&pipe_mem, 0x10000));
-
-            let mut vpe = assert_ok!(VPE::new_with(VPEArgs::new("writer")));
-            vpe.files().set(io::STDOUT_FILENO, VPE::cur().files().get(pipe.writer_fd()).unwrap());
-            assert_ok!(vpe.obtain_fds());
-
-            let act = assert_ok!(vpe.run(Box::new(|| {
-                let buf = vec![0u8; BUF_SIZE];
-                let output = VPE::cur().files().get(io::STDOUT_FILENO).unwrap();
-                let mut rem = DATA_SIZE;
-                while rem > 0 {
-                    assert_ok!(output.borrow_mut().write(&buf));
-                    rem -= BUF_SIZE;
-                }
-                0
-            })));
-
-            pipe.close_writer();
+    let res = prof.run_with_id(|| {
+        let pipe_mem = assert_ok!(MemGate::new(0x10000, kif::Perm::RW));
+        let pipe = assert_ok!(IndirectPipe::new(&pipe_mem, 0x10000));
 
-            let mut buf = vec![0u8; BUF_SIZE];
-            let input = VPE::cur().files().get(pipe.reader_fd()).unwrap();
-            while assert_ok!(input.borrow_mut().read(&mut buf)) > 0 {
+        let mut vpe = assert_ok!(VPE::new_with(VPEArgs::new("writer")));
+        vpe.files().set(io::STDOUT_FILENO, VPE::cur().files().get(pipe.writer_fd()).unwrap());
+        assert_ok!(vpe.obtain_fds());
+
+        let act = assert_ok!(vpe.run(Box::new(|| {
+            let buf = vec![0u8; BUF_SIZE];
+            let output = VPE::cur().files().get(io::STDOUT_FILENO).unwrap();
+            let mut rem = DATA_SIZE;
+            while rem > 0 {
+                assert_ok!(output.borrow_mut().write(&buf));
+                rem -= BUF_SIZE;
             }
+            0
+        })));
+
+        pipe.close_writer();
+
+        let mut buf = vec![0u8; BUF_SIZE];
+        let input = VPE::cur().files().get(pipe.reader_fd()).unwrap();
+        while assert_ok!(input.borrow_mut().read(&mut buf)) > 0 {
+        }
+
+        assert_eq!(act.wait(), Ok(0));
+    }, 0x90);
 
-            assert_eq!(act.wait(), Ok(0));
-        }, 0x90)
-    );
+    println!("c->p: {} KiB transfer with {} KiB buf: {}", DATA_SIZE / 1024, BUF_SIZE / 1024, res);
+    println!("{}", res.json("pipe_child_to_parent", BUF_SIZE, DATA_SIZE));
 }
 
 fn parent_to_child() {
     let mut prof = profile::Profiler::new().repeats(2).warmup(1);
 
-    println!("p->c: {} KiB transfer with {} KiB buf: {}", DATA_SIZE / 1024, BUF_SIZE / 1024,
-        prof.run_with_id(|| {
-            let pipe_mem = assert_ok!(MemGate::new(0x10000, kif::Perm::RW));
-            let pipe = assert_ok!(IndirectPipe::new(&pipe_mem, 0x10000));
+    let res = prof.run_with_id(|| {
+        let pipe_mem = assert_ok!(MemGate::new(0x10000, kif::Perm::RW));
+        let pipe = assert_ok!(IndirectPipe::new(&pipe_mem, 0x10000));
 
-            let mut vpe = assert_ok!(VPE::new_with(VPEArgs::new("reader")));
-            vpe.files().set(io::STDIN_FILENO, VPE::cur().files().get(pipe.reader_fd()).unwrap());
-            assert_ok!(vpe.obtain_fds());
+        let mut vpe = assert_ok!(VPE::new_with(VPEArgs::new("reader")));
+        vpe.files().set(io::STDIN_FILENO, VPE::cur().files().get(pipe.reader_fd()).unwrap());
+        assert_ok!(vpe.obtain_fds());
 
-            let act = assert_ok!(vpe.run(Box::new(|| {
-                let mut buf = vec![0u8; BUF_SIZE];
-                let input = VPE::cur().files().get(io::STDIN_FILENO).unwrap();
-                while assert_ok!(input.borrow_mut().read(&mut buf)) > 0 {
-                }
-                0
-            })));
+        let act = assert_ok!(vpe.run(Box::new(|| {
+            let mut buf = vec![0u8; BUF_SIZE];
+            let input = VPE::cur().files().get(io::STDIN_FILENO).unwrap();
+            while assert_ok!(input.borrow_mut().read(&mut buf)) > 0 {
+            }
+            0
+        })));
 
-            pipe.close_reader();
+        pipe.close_reader();
 
-            let buf = vec![0u8; BUF_SIZE];
-            let output = VPE::cur().files().get(pipe.writer_fd()).unwrap();
-            let mut rem = DATA_SIZE;
-            while rem > 0 {
-                assert_ok!(output.borrow_mut().write(&buf));
-                rem -= BUF_SIZE;
-            }
+        let buf = vec![0u8; BUF_SIZE];
+        let output = VPE::cur().files().get(pipe.writer_fd()).unwrap();
+        let mut rem = DATA_SIZE;
+        while rem > 0 {
+            assert_ok!(output.borrow_mut().write(&buf));
+            rem -= BUF_SIZE;
+        }
+
+        pipe.close_writer();
 
-            pipe.close_writer();
+        assert_eq!(act.wait(), Ok(0));
+    }, 0x91);
 
-            assert_eq!(act.wait(), Ok(0));
-        }, 0x91)
-    );
+    println!("p->c: {} KiB transfer with {} KiB buf: {}", DATA_SIZE / 1024, BUF_SIZE / 1024, res);
+    println!("{}", res.json("pipe_parent_to_child", BUF_SIZE, DATA_SIZE));
 }
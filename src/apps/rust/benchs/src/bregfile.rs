@@ -29,7 +29,7 @@ fn read() {
 
     let mut prof = profile::Profiler::new().repeats(2).warmup(1);
 
-    println!("2 MiB file with 8K buf: {}", prof.run_with_id(|| {
+    let res = prof.run_with_id(|| {
         let mut file = assert_ok!(VFS::open("/data/2048k.txt", OpenFlags::R));
         loop {
             let amount = assert_ok!(file.read(&mut buf));
@@ -37,7 +37,9 @@ fn read() {
                 break;
             }
         }
-    }, 0x20));
+    }, 0x20);
+    println!("2 MiB file with 8K buf: {}", res);
+    println!("{}", res.json("regfile_read", buf.len(), 2 * 1024 * 1024));
 }
 
 fn write() {
@@ -46,7 +48,7 @@ fn write() {
 
     let mut prof = profile::Profiler::new().repeats(2).warmup(1);
 
-    println!("2 MiB file with 8K buf: {}", prof.run_with_id(|| {
+    let res = prof.run_with_id(|| {
         let mut file = assert_ok!(VFS::open("/newfile",
             OpenFlags::W | OpenFlags::CREATE | OpenFlags::TRUNC));
 
@@ -58,5 +60,7 @@ fn write() {
             }
             total += amount;
         }
-    }, 0x21));
+    }, 0x21);
+    println!("2 MiB file with 8K buf: {}", res);
+    println!("{}", res.json("regfile_write", buf.len(), SIZE));
 }
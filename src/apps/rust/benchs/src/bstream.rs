@@ -35,7 +35,7 @@ fn pingpong() {
 
     let mut prof = profile::Profiler::new();
 
-    println!("pingpong with (1 * u64) msgs : {}", prof.run_with_id(|| {
+    let res = prof.run_with_id(|| {
         assert_ok!(send_vmsg!(&sgate, reply_gate, 0u64));
 
         let mut msg = assert_ok!(recv_msg(&rgate));
@@ -44,9 +44,11 @@ fn pingpong() {
 
         let mut reply = assert_ok!(recv_msg(reply_gate));
         assert_eq!(reply.pop::<u64>(), 0);
-    }, 0x0));
+    }, 0x0);
+    println!("pingpong with (1 * u64) msgs : {}", res);
+    println!("{}", res.json("stream_pingpong_1u64", 0, 0));
 
-    println!("pingpong with (2 * u64) msgs : {}", prof.run_with_id(|| {
+    let res = prof.run_with_id(|| {
         assert_ok!(send_vmsg!(&sgate, reply_gate, 23u64, 42u64));
 
         let mut msg = assert_ok!(recv_msg(&rgate));
@@ -57,9 +59,11 @@ fn pingpong() {
         let mut reply = assert_ok!(recv_msg(reply_gate));
         assert_eq!(reply.pop::<u64>(), 5);
         assert_eq!(reply.pop::<u64>(), 6);
-    }, 0x1));
+    }, 0x1);
+    println!("pingpong with (2 * u64) msgs : {}", res);
+    println!("{}", res.json("stream_pingpong_2u64", 0, 0));
 
-    println!("pingpong with (4 * u64) msgs : {}", prof.run_with_id(|| {
+    let res = prof.run_with_id(|| {
         assert_ok!(send_vmsg!(&sgate, reply_gate, 23u64, 42u64, 10u64, 12u64));
 
         let mut msg = assert_ok!(recv_msg(&rgate));
@@ -74,9 +78,11 @@ fn pingpong() {
         assert_eq!(reply.pop::<u64>(), 6);
         assert_eq!(reply.pop::<u64>(), 7);
         assert_eq!(reply.pop::<u64>(), 8);
-    }, 0x2));
+    }, 0x2);
+    println!("pingpong with (4 * u64) msgs : {}", res);
+    println!("{}", res.json("stream_pingpong_4u64", 0, 0));
 
-    println!("pingpong with (String) msgs  : {}", prof.run_with_id(|| {
+    let res = prof.run_with_id(|| {
         assert_ok!(send_vmsg!(&sgate, reply_gate, "test"));
 
         let mut msg = assert_ok!(recv_msg(&rgate));
@@ -85,5 +91,7 @@ fn pingpong() {
 
         let mut reply = assert_ok!(recv_msg(reply_gate));
         assert_eq!(reply.pop::<String>(), "foobar".to_string());
-    }, 0x3));
+    }, 0x3);
+    println!("pingpong with (String) msgs  : {}", res);
+    println!("{}", res.json("stream_pingpong_string", 0, 0));
 }
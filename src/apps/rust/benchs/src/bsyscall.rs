@@ -44,9 +44,11 @@ pub fn run(t: &mut test::Tester) {
 fn noop() {
     let mut prof = profile::Profiler::new();
 
-    println!("{}", prof.run_with_id(|| {
+    let res = prof.run_with_id(|| {
         assert_ok!(syscalls::noop());
-    }, 0x10));
+    }, 0x10);
+    println!("{}", res);
+    println!("{}", res.json("syscall_noop", 0, 0));
 }
 
 fn activate() {
@@ -57,9 +59,11 @@ fn activate() {
 
     let mut prof = profile::Profiler::new();
 
-    println!("{}", prof.run_with_id(|| {
+    let res = prof.run_with_id(|| {
         assert_ok!(syscalls::activate(VPE::cur().ep_sel(ep), mgate.sel(), 0));
-    }, 0x11));
+    }, 0x11);
+    println!("{}", res);
+    println!("{}", res.json("syscall_activate", 0, 0));
 }
 
 fn create_rgate() {
@@ -77,7 +81,9 @@ fn create_rgate() {
         }
     }
 
-    println!("{}", prof.runner_with_id(&mut Tester::default(), 0x12));
+    let res = prof.runner_with_id(&mut Tester::default(), 0x12);
+    println!("{}", res);
+    println!("{}", res.json("syscall_create_rgate", 0, 0));
 }
 
 fn create_sgate() {
@@ -100,7 +106,9 @@ fn create_sgate() {
         }
     }
 
-    println!("{}", prof.runner_with_id(&mut Tester::default(), 0x13));
+    let res = prof.runner_with_id(&mut Tester::default(), 0x13);
+    println!("{}", res);
+    println!("{}", res.json("syscall_create_sgate", 0, 0));
 }
 
 fn create_mgate() {
@@ -118,7 +126,9 @@ fn create_mgate() {
         }
     }
 
-    println!("{}", prof.runner_with_id(&mut Tester::default(), 0x14));
+    let res = prof.runner_with_id(&mut Tester::default(), 0x14);
+    println!("{}", res);
+    println!("{}", res.json("syscall_create_mgate", 0, 0));
 }
 
 fn create_map() {
@@ -142,7 +152,9 @@ fn create_map() {
     }
 
     let mut tester = Tester { 0: MemGate::new(0x1000, Perm::RW).unwrap() };
-    println!("{}", prof.runner_with_id(&mut tester, 0x14));
+    let res = prof.runner_with_id(&mut tester, 0x14);
+    println!("{}", res);
+    println!("{}", res.json("syscall_create_map", 0, 0));
 }
 
 fn create_srv() {
@@ -167,7 +179,9 @@ fn create_srv() {
         }
     }
 
-    println!("{}", prof.runner_with_id(&mut Tester::default(), 0x15));
+    let res = prof.runner_with_id(&mut Tester::default(), 0x15);
+    println!("{}", res);
+    println!("{}", res.json("syscall_create_srv", 0, 0));
 }
 
 fn open_sess() {
@@ -188,7 +202,9 @@ fn open_sess() {
         }
     }
 
-    println!("{}", prof.runner_with_id(&mut Tester::default(), 0x16));
+    let res = prof.runner_with_id(&mut Tester::default(), 0x16);
+    println!("{}", res);
+    println!("{}", res.json("syscall_open_sess", 0, 0));
 }
 
 fn derive_mem() {
@@ -211,7 +227,9 @@ fn derive_mem() {
         }
     }
 
-    println!("{}", prof.runner_with_id(&mut Tester::default(), 0x17));
+    let res = prof.runner_with_id(&mut Tester::default(), 0x17);
+    println!("{}", res);
+    println!("{}", res.json("syscall_derive_mem", 0, 0));
 }
 
 fn exchange() {
@@ -243,7 +261,9 @@ fn exchange() {
         }
     }
 
-    println!("{}", prof.runner_with_id(&mut Tester::default(), 0x18));
+    let res = prof.runner_with_id(&mut Tester::default(), 0x18);
+    println!("{}", res);
+    println!("{}", res.json("syscall_exchange", 0, 0));
 }
 
 fn revoke() {
@@ -261,5 +281,7 @@ fn revoke() {
         }
     }
 
-    println!("{}", prof.runner_with_id(&mut Tester::default(), 0x19));
+    let res = prof.runner_with_id(&mut Tester::default(), 0x19);
+    println!("{}", res);
+    println!("{}", res.json("syscall_revoke", 0, 0));
 }
@@ -41,7 +41,9 @@ fn insert() {
         }
     }
 
-    println!("Inserting 100 elements: {}", prof.runner_with_id(&mut BTreeTester::default(), 0x71));
+    let res = prof.runner_with_id(&mut BTreeTester::default(), 0x71);
+    println!("Inserting 100 elements: {}", res);
+    println!("{}", res.json("treap_insert", 0, 0));
 }
 
 fn find() {
@@ -67,7 +69,9 @@ fn find() {
         }
     }
 
-    println!("Searching for 100 elements: {}", prof.runner_with_id(&mut BTreeTester::default(), 0x72));
+    let res = prof.runner_with_id(&mut BTreeTester::default(), 0x72);
+    println!("Searching for 100 elements: {}", res);
+    println!("{}", res.json("treap_find", 0, 0));
 }
 
 fn clear() {
@@ -87,5 +91,7 @@ fn clear() {
         }
     }
 
-    println!("Removing 100-element list: {}", prof.runner_with_id(&mut BTreeTester::default(), 0x73));
+    let res = prof.runner_with_id(&mut BTreeTester::default(), 0x73);
+    println!("Removing 100-element list: {}", res);
+    println!("{}", res.json("treap_clear", 0, 0));
 }
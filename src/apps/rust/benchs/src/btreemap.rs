@@ -41,7 +41,9 @@ fn insert() {
         }
     }
 
-    println!("Inserting 100 elements: {}", prof.runner_with_id(&mut BTreeTester::default(), 0x81));
+    let res = prof.runner_with_id(&mut BTreeTester::default(), 0x81);
+    println!("Inserting 100 elements: {}", res);
+    println!("{}", res.json("treemap_insert", 0, 0));
 }
 
 fn find() {
@@ -63,7 +65,9 @@ fn find() {
         }
     }
 
-    println!("Searching for 100 elements: {}", prof.runner_with_id(&mut BTreeTester::default(), 0x82));
+    let res = prof.runner_with_id(&mut BTreeTester::default(), 0x82);
+    println!("Searching for 100 elements: {}", res);
+    println!("{}", res.json("treemap_find", 0, 0));
 }
 
 fn clear() {
@@ -83,5 +87,7 @@ fn clear() {
         }
     }
 
-    println!("Removing 100-element list: {}", prof.runner_with_id(&mut BTreeTester::default(), 0x83));
+    let res = prof.runner_with_id(&mut BTreeTester::default(), 0x83);
+    println!("Removing 100-element list: {}", res);
+    println!("{}", res.json("treemap_clear", 0, 0));
 }
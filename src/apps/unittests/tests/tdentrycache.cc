@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+#include <base/Common.h>
+
+#include <string.h>
+
+#include "../m3fs/data/DentryCache.h"
+#include "../unittests.h"
+
+using namespace m3;
+
+static bool lookup(DentryCache &cache, inodeno_t dir, const char *name, inodeno_t *ino) {
+    return cache.lookup(dir, name, strlen(name), ino);
+}
+
+static void insert(DentryCache &cache, inodeno_t dir, const char *name, inodeno_t ino) {
+    cache.insert(dir, name, strlen(name), ino);
+}
+
+static void lookups() {
+    DentryCache cache(8);
+    inodeno_t ino;
+
+    assert_false(lookup(cache, 0, "foo", &ino));
+
+    insert(cache, 0, "foo", 3);
+    insert(cache, 0, "bar", INVALID_INO);
+    insert(cache, 1, "foo", 4);
+
+    assert_true(lookup(cache, 0, "foo", &ino));
+    assert_uint(ino, 3);
+    assert_true(lookup(cache, 1, "foo", &ino));
+    assert_uint(ino, 4);
+
+    // negative entries are hits as well
+    assert_true(lookup(cache, 0, "bar", &ino));
+    assert_uint(ino, INVALID_INO);
+
+    // prefixes and other directories don't match
+    assert_false(lookup(cache, 0, "fo", &ino));
+    assert_false(lookup(cache, 0, "fooo", &ino));
+    assert_false(lookup(cache, 2, "foo", &ino));
+
+    // the path lookup passes names that are not null-terminated
+    const char *path = "foo/bar";
+    assert_true(cache.lookup(0, path, 3, &ino));
+    assert_uint(ino, 3);
+
+    // names that don't fit into an entry are not cached
+    char longname[100];
+    memset(longname, 'a', sizeof(longname));
+    cache.insert(0, longname, sizeof(longname), 5);
+    assert_false(cache.lookup(0, longname, sizeof(longname), &ino));
+
+    assert_size(cache.stats().hits, 3);
+    assert_size(cache.stats().neg_hits, 1);
+    assert_size(cache.stats().misses, 5);
+    assert_size(cache.stats().inserts, 3);
+}
+
+static void invalidation() {
+    DentryCache cache(8);
+    inodeno_t ino;
+
+    insert(cache, 0, "file", 3);
+    insert(cache, 0, "dir", 4);
+    insert(cache, 4, "a", 5);
+    insert(cache, 4, "b", 6);
+
+    // unlink replaces the entry by a negative one
+    insert(cache, 0, "file", INVALID_INO);
+    assert_true(lookup(cache, 0, "file", &ino));
+    assert_uint(ino, INVALID_INO);
+
+    // a rename is a link to the new name and an unlink of the old one
+    insert(cache, 4, "c", 5);
+    insert(cache, 4, "a", INVALID_INO);
+    assert_true(lookup(cache, 4, "a", &ino));
+    assert_uint(ino, INVALID_INO);
+    assert_true(lookup(cache, 4, "c", &ino));
+    assert_uint(ino, 5);
+
+    // creating the file again replaces the negative entry
+    insert(cache, 0, "file", 7);
+    assert_true(lookup(cache, 0, "file", &ino));
+    assert_uint(ino, 7);
+
+    // removing a directory drops all entries within it, but nothing else
+    cache.remove_dir(4);
+    assert_false(lookup(cache, 4, "a", &ino));
+    assert_false(lookup(cache, 4, "b", &ino));
+    assert_false(lookup(cache, 4, "c", &ino));
+    assert_true(lookup(cache, 0, "dir", &ino));
+    assert_uint(ino, 4);
+    assert_true(lookup(cache, 0, "file", &ino));
+    assert_uint(ino, 7);
+
+    // the freed entries are reused without evictions
+    for(inodeno_t i = 0; i < 6; ++i) {
+        char name[] = {static_cast<char>('a' + i), '\0'};
+        insert(cache, 8, name, 10 + i);
+    }
+    assert_size(cache.stats().evictions, 0);
+}
+
+static void eviction() {
+    DentryCache cache(3);
+    inodeno_t ino;
+
+    insert(cache, 0, "a", 1);
+    insert(cache, 0, "b", 2);
+    insert(cache, 0, "c", 3);
+
+    // use "a", so that "b" is the least recently used entry
+    assert_true(lookup(cache, 0, "a", &ino));
+
+    insert(cache, 0, "d", 4);
+    assert_size(cache.stats().evictions, 1);
+    assert_false(lookup(cache, 0, "b", &ino));
+    assert_true(lookup(cache, 0, "a", &ino));
+    assert_true(lookup(cache, 0, "c", &ino));
+    assert_true(lookup(cache, 0, "d", &ino));
+
+    // updating an entry doesn't need a new one
+    insert(cache, 0, "c", 5);
+    assert_size(cache.stats().evictions, 1);
+    assert_true(lookup(cache, 0, "c", &ino));
+    assert_uint(ino, 5);
+
+    // now "a" is the oldest one
+    insert(cache, 0, "e", 6);
+    assert_size(cache.stats().evictions, 2);
+    assert_false(lookup(cache, 0, "a", &ino));
+    assert_true(lookup(cache, 0, "e", &ino));
+
+    // a cache without capacity never contains anything
+    DentryCache empty(0);
+    insert(empty, 0, "a", 1);
+    assert_false(lookup(empty, 0, "a", &ino));
+}
+
+void tdentrycache() {
+    RUN_TEST(lookups);
+    RUN_TEST(invalidation);
+    RUN_TEST(eviction);
+}
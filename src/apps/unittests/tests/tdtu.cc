@@ -165,6 +165,44 @@ static void mem_sync() {
     }
 }
 
+static void mem_copy() {
+    static xfer_t data[4];
+
+    MemGate mem1 = m3::MemGate::create_global(0x4000, m3::MemGate::RWX);
+    MemGate mem2 = m3::MemGate::create_global(0x4000, m3::MemGate::RWX);
+    write_vmsg(mem1, 0x100, 1, 2, 3, 4);
+
+    cout << "-- Test copy between gates --\n";
+    {
+        assert_int(mem2.copy_from(mem1, 0x100, sizeof(xfer_t) * 4, 0x200), Errors::NONE);
+        mem2.read(data, sizeof(data), 0x200);
+        assert_xfer(data[0], 1);
+        assert_xfer(data[1], 2);
+        assert_xfer(data[2], 3);
+        assert_xfer(data[3], 4);
+    }
+
+    cout << "-- Test copy within a gate --\n";
+    {
+        assert_int(mem1.copy_from(mem1, 0x100, sizeof(xfer_t) * 4, 0x108), Errors::NONE);
+        mem1.read(data, sizeof(data), 0x108);
+        assert_xfer(data[0], 1);
+        assert_xfer(data[1], 2);
+        assert_xfer(data[2], 3);
+        assert_xfer(data[3], 4);
+    }
+
+    cout << "-- Test zero --\n";
+    {
+        assert_int(mem2.zero(sizeof(xfer_t) * 2, 0x208), Errors::NONE);
+        mem2.read(data, sizeof(data), 0x200);
+        assert_xfer(data[0], 1);
+        assert_xfer(data[1], 0);
+        assert_xfer(data[2], 0);
+        assert_xfer(data[3], 4);
+    }
+}
+
 static void mem_derive() {
     static xfer_t test[6] = {0};
 
@@ -208,6 +246,7 @@ void tdtu() {
     RUN_TEST(cmds_read);
     RUN_TEST(cmds_write);
     RUN_TEST(mem_sync);
+    RUN_TEST(mem_copy);
     RUN_TEST(mem_derive);
 }
 
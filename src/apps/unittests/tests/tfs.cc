@@ -20,6 +20,9 @@
 
 #include <m3/stream/FStream.h>
 #include <m3/stream/Standard.h>
+#include <m3/pipe/DirectPipe.h>
+#include <m3/pipe/DirectPipeReader.h>
+#include <m3/pipe/DirectPipeWriter.h>
 #include <m3/pipe/IndirectPipe.h>
 #include <m3/vfs/VFS.h>
 #include <m3/vfs/FileRef.h>
@@ -282,6 +285,108 @@ static void pipe_mux() {
     }
 }
 
+// the ring has room for 256 bytes of data
+static const size_t RING_PIPE_SIZE = DirectPipe::RING_CTRL_SIZE + 256;
+
+static void ring_read_exactly(DirectPipeReader *reader, uint8_t *buf, size_t count) {
+    while(count > 0) {
+        ssize_t res = reader->read(buf, count, false);
+        if(res <= 0)
+            exitmsg("read from ring pipe failed");
+        buf += res;
+        count -= static_cast<size_t>(res);
+    }
+}
+
+static void pipe_ring_wraparound() {
+    MemGate mem = MemGate::create_global(RING_PIPE_SIZE, MemGate::RW);
+    DirectPipe pipe(VPE::self(), VPE::self(), mem, RING_PIPE_SIZE, DirectPipe::RING);
+    auto reader = static_cast<DirectPipeReader*>(VPE::self().fds()->get(pipe.reader_fd()));
+    auto writer = static_cast<DirectPipeWriter*>(VPE::self().fds()->get(pipe.writer_fd()));
+
+    alignas(DTU_PKG_SIZE) uint8_t src[200];
+    alignas(DTU_PKG_SIZE) uint8_t dst[200];
+    for(size_t round = 0; round < 4; ++round) {
+        for(size_t i = 0; i < sizeof(src); ++i)
+            src[i] = static_cast<uint8_t>(round + i);
+
+        // from the second round on, the data wraps around at the end of the ring
+        assert_ssize(writer->write(src, sizeof(src), false), static_cast<ssize_t>(sizeof(src)));
+        ring_read_exactly(reader, dst, sizeof(dst));
+        assert_int(memcmp(src, dst, sizeof(src)), 0);
+    }
+
+    // everything has been consumed
+    assert_ssize(reader->read(dst, sizeof(dst), false), -1);
+}
+
+static void pipe_ring_partial() {
+    MemGate mem = MemGate::create_global(RING_PIPE_SIZE, MemGate::RW);
+    DirectPipe pipe(VPE::self(), VPE::self(), mem, RING_PIPE_SIZE, DirectPipe::RING);
+    auto reader = static_cast<DirectPipeReader*>(VPE::self().fds()->get(pipe.reader_fd()));
+    auto writer = static_cast<DirectPipeWriter*>(VPE::self().fds()->get(pipe.writer_fd()));
+
+    alignas(DTU_PKG_SIZE) uint8_t buf[320];
+    for(size_t i = 0; i < sizeof(buf); ++i)
+        buf[i] = static_cast<uint8_t>(i);
+
+    // a non-blocking write takes as much as fits, afterwards nothing
+    assert_ssize(writer->write(buf, sizeof(buf), false), 256);
+    assert_ssize(writer->write(buf, sizeof(buf), false), -1);
+
+    // reads return at most the requested amount
+    alignas(DTU_PKG_SIZE) uint8_t dst[96];
+    for(size_t off = 0; off < 256; ) {
+        ssize_t res = reader->read(dst, sizeof(dst), false);
+        assert_ssize(res, static_cast<ssize_t>(Math::min(sizeof(dst), 256 - off)));
+        assert_int(memcmp(dst, buf + off, static_cast<size_t>(res)), 0);
+        off += static_cast<size_t>(res);
+    }
+    assert_ssize(reader->read(dst, sizeof(dst), false), -1);
+
+    // the consumed space can be used again
+    assert_ssize(writer->write(buf, 64, false), 64);
+    ring_read_exactly(reader, dst, 64);
+    assert_int(memcmp(dst, buf, 64), 0);
+}
+
+static void pipe_ring_reader_eof() {
+    MemGate mem = MemGate::create_global(RING_PIPE_SIZE, MemGate::RW);
+    DirectPipe pipe(VPE::self(), VPE::self(), mem, RING_PIPE_SIZE, DirectPipe::RING);
+    auto writer = static_cast<DirectPipeWriter*>(VPE::self().fds()->get(pipe.writer_fd()));
+
+    alignas(DTU_PKG_SIZE) uint8_t buf[256];
+    memset(buf, 0, sizeof(buf));
+    assert_ssize(writer->write(buf, sizeof(buf), false), 256);
+
+    pipe.close_reader();
+
+    // the ring is full, but the writer must not wait for a reader that is gone
+    assert_ssize(writer->write(buf, sizeof(buf), true), 0);
+    assert_ssize(writer->write(buf, sizeof(buf), true), 0);
+}
+
+static void pipe_ring_writer_eof() {
+    MemGate mem = MemGate::create_global(RING_PIPE_SIZE, MemGate::RW);
+    DirectPipe pipe(VPE::self(), VPE::self(), mem, RING_PIPE_SIZE, DirectPipe::RING);
+    auto reader = static_cast<DirectPipeReader*>(VPE::self().fds()->get(pipe.reader_fd()));
+    auto writer = static_cast<DirectPipeWriter*>(VPE::self().fds()->get(pipe.writer_fd()));
+
+    alignas(DTU_PKG_SIZE) uint8_t buf[64];
+    for(size_t i = 0; i < sizeof(buf); ++i)
+        buf[i] = static_cast<uint8_t>(i);
+    assert_ssize(writer->write(buf, sizeof(buf), false), 64);
+
+    pipe.close_writer();
+
+    // the reader gets the remaining data first and the EOF afterwards
+    alignas(DTU_PKG_SIZE) uint8_t dst[64];
+    ring_read_exactly(reader, dst, sizeof(dst));
+    assert_int(memcmp(dst, buf, sizeof(buf)), 0);
+    assert_ssize(reader->read(dst, sizeof(dst), true), 0);
+    assert_ssize(reader->read(dst, sizeof(dst), true), 0);
+}
+
 static void file_errors() {
     const char *filename = "/subdir/subsubdir/testfile.txt";
 
@@ -423,6 +528,206 @@ static void transactions() {
     }
 }
 
+static void copy_range() {
+    const char *src_file = "/copy_src.txt";
+    const char *dst_file = "/copy_dst.txt";
+
+    {
+        FileRef file(src_file, FILE_W | FILE_CREATE | FILE_TRUNC);
+        if(Errors::occurred())
+            exitmsg("open of " << src_file << " failed");
+
+        for(size_t i = 0; i < sizeof(largebuf); ++i)
+            largebuf[i] = i % 100;
+
+        for(int i = 0; i < 20; ++i)
+            assert_int(file->write_all(largebuf, sizeof(largebuf)), Errors::NONE);
+    }
+
+    {
+        FileRef file(dst_file, FILE_W | FILE_CREATE | FILE_TRUNC);
+        if(Errors::occurred())
+            exitmsg("open of " << dst_file << " failed");
+    }
+
+    size_t count = static_cast<size_t>(-1);
+    assert_int(VFS::copy_range(src_file, dst_file, 0, &count), Errors::NONE);
+    assert_size(count, sizeof(largebuf) * 20);
+    check_content(dst_file, sizeof(largebuf) * 20);
+
+    // there is nothing left to copy
+    count = static_cast<size_t>(-1);
+    assert_int(VFS::copy_range(src_file, dst_file, sizeof(largebuf) * 20, &count), Errors::NONE);
+    assert_size(count, 0);
+
+    // the destination does not end at a block boundary anymore
+    count = 1;
+    assert_int(VFS::copy_range(src_file, dst_file, 0, &count), Errors::INV_ARGS);
+
+    assert_int(VFS::unlink(src_file), Errors::NONE);
+    assert_int(VFS::unlink(dst_file), Errors::NONE);
+}
+
+static void splice_and_tee() {
+    const char *src_file = "/splice_src.txt";
+    const char *dst_files[] = {"/splice_dst1.txt", "/splice_dst2.txt"};
+
+    {
+        FileRef file(src_file, FILE_W | FILE_CREATE | FILE_TRUNC);
+        if(Errors::occurred())
+            exitmsg("open of " << src_file << " failed");
+
+        for(size_t i = 0; i < sizeof(largebuf); ++i)
+            largebuf[i] = i % 100;
+
+        for(int i = 0; i < 20; ++i)
+            assert_int(file->write_all(largebuf, sizeof(largebuf)), Errors::NONE);
+    }
+
+    // file to file
+    {
+        FileRef in(src_file, FILE_R);
+        FileRef out(dst_files[0], FILE_W | FILE_CREATE | FILE_TRUNC);
+        if(Errors::occurred())
+            exitmsg("open failed");
+
+        ssize_t res;
+        size_t total = 0;
+        while((res = in->splice(*out, 1000)) > 0)
+            total += static_cast<size_t>(res);
+        assert_ssize(res, 0);
+        assert_size(total, sizeof(largebuf) * 20);
+    }
+    check_content(dst_files[0], sizeof(largebuf) * 20);
+
+    // file to two files
+    {
+        FileRef in(src_file, FILE_R);
+        FileRef out1(dst_files[0], FILE_W | FILE_TRUNC);
+        FileRef out2(dst_files[1], FILE_W | FILE_CREATE | FILE_TRUNC);
+        if(Errors::occurred())
+            exitmsg("open failed");
+
+        File *outs[] = {&*out1, &*out2};
+        while(in->tee(outs, ARRAY_SIZE(outs), 1000) > 0)
+            ;
+    }
+    check_content(dst_files[0], sizeof(largebuf) * 20);
+    check_content(dst_files[1], sizeof(largebuf) * 20);
+
+    // file to pipe and pipe to two files
+    {
+        const size_t PIPE_SIZE = 4096;
+        MemGate mem = MemGate::create_global(PIPE_SIZE, MemGate::RW);
+        IndirectPipe pipe(mem, PIPE_SIZE);
+        File *pwriter = VPE::self().fds()->get(pipe.writer_fd());
+        File *preader = VPE::self().fds()->get(pipe.reader_fd());
+
+        FileRef in(src_file, FILE_R);
+        FileRef out1(dst_files[0], FILE_W | FILE_TRUNC);
+        FileRef out2(dst_files[1], FILE_W | FILE_TRUNC);
+        if(Errors::occurred())
+            exitmsg("open failed");
+
+        // we are on both sides of the pipe; thus, never put more into it than it can hold, while
+        // the reader still holds its last window
+        File *outs[] = {&*out1, &*out2};
+        ssize_t res;
+        size_t total = 0;
+        while((res = in->splice(*pwriter, PIPE_SIZE / 2)) > 0) {
+            assert_int(pwriter->flush(), Errors::NONE);
+
+            size_t rem = static_cast<size_t>(res);
+            while(rem > 0) {
+                ssize_t moved = preader->tee(outs, ARRAY_SIZE(outs), rem);
+                if(moved <= 0)
+                    exitmsg("tee from pipe failed");
+                rem -= static_cast<size_t>(moved);
+            }
+            total += static_cast<size_t>(res);
+        }
+        assert_ssize(res, 0);
+        assert_size(total, sizeof(largebuf) * 20);
+    }
+    check_content(dst_files[0], sizeof(largebuf) * 20);
+    check_content(dst_files[1], sizeof(largebuf) * 20);
+
+    assert_int(VFS::unlink(src_file), Errors::NONE);
+    assert_int(VFS::unlink(dst_files[0]), Errors::NONE);
+    assert_int(VFS::unlink(dst_files[1]), Errors::NONE);
+}
+
+static void append_to_file(const char *filename, int flags, size_t off, size_t count) {
+    FileRef file(filename, FILE_W | flags);
+    if(Errors::occurred())
+        exitmsg("open of " << filename << " failed");
+
+    for(size_t i = 0; i < count; ++i)
+        largebuf[i] = (off + i) % 100;
+    assert_int(file->write_all(largebuf, count), Errors::NONE);
+}
+
+static void inline_files() {
+    const char *filename = "/inline.txt";
+    FileInfo info;
+
+    // small files are stored in the inode
+    append_to_file(filename, FILE_CREATE | FILE_TRUNC, 0, 10);
+    check_content(filename, 10);
+    assert_int(VFS::stat(filename, info), Errors::NONE);
+    assert_uint(info.extents, 0);
+
+    append_to_file(filename, FILE_APPEND, 10, 50);
+    check_content(filename, 60);
+    assert_int(VFS::stat(filename, info), Errors::NONE);
+    assert_uint(info.extents, 0);
+
+    // growing beyond the inode moves the data into a block
+    append_to_file(filename, FILE_APPEND, 60, 500);
+    check_content(filename, 560);
+    assert_int(VFS::stat(filename, info), Errors::NONE);
+    assert_uint(info.extents, 1);
+
+    // truncating makes it inline again
+    append_to_file(filename, FILE_TRUNC, 0, 20);
+    check_content(filename, 20);
+    assert_int(VFS::stat(filename, info), Errors::NONE);
+    assert_uint(info.extents, 0);
+
+    assert_int(VFS::unlink(filename), Errors::NONE);
+}
+
+static void interleaved_appends() {
+    const char *filenames[] = {"/interleaved1.txt", "/interleaved2.txt"};
+
+    {
+        FileRef file1(filenames[0], FILE_W | FILE_CREATE | FILE_TRUNC);
+        FileRef file2(filenames[1], FILE_W | FILE_CREATE | FILE_TRUNC);
+        if(Errors::occurred())
+            exitmsg("open failed");
+
+        for(size_t i = 0; i < sizeof(largebuf); ++i)
+            largebuf[i] = i % 100;
+
+        // without preallocation, the appends would steal each others blocks
+        for(int i = 0; i < 20; ++i) {
+            assert_int(file1->write_all(largebuf, sizeof(largebuf)), Errors::NONE);
+            assert_int(file1->flush(), Errors::NONE);
+            assert_int(file2->write_all(largebuf, sizeof(largebuf)), Errors::NONE);
+            assert_int(file2->flush(), Errors::NONE);
+        }
+    }
+
+    for(size_t i = 0; i < ARRAY_SIZE(filenames); ++i) {
+        check_content(filenames[i], sizeof(largebuf) * 20);
+
+        FileInfo info;
+        assert_int(VFS::stat(filenames[i], info), Errors::NONE);
+        assert_uint(info.extents, 1);
+        assert_int(VFS::unlink(filenames[i]), Errors::NONE);
+    }
+}
+
 static void buffered_read_until_end() {
     FStream file(pat_file, FILE_R, 256);
     if(Errors::occurred())
@@ -562,6 +867,10 @@ void tfs() {
     RUN_TEST(append_with_read);
     RUN_TEST(file_mux);
     RUN_TEST(pipe_mux);
+    RUN_TEST(pipe_ring_wraparound);
+    RUN_TEST(pipe_ring_partial);
+    RUN_TEST(pipe_ring_reader_eof);
+    RUN_TEST(pipe_ring_writer_eof);
     RUN_TEST(file_errors);
 #if DTU_PKG_SIZE == 8
     RUN_TEST(read_file_at_once);
@@ -570,6 +879,10 @@ void tfs() {
     RUN_TEST(read_file_in_large_steps);
     RUN_TEST(write_file_and_read_again);
     RUN_TEST(transactions);
+    RUN_TEST(copy_range);
+    RUN_TEST(splice_and_tee);
+    RUN_TEST(inline_files);
+    RUN_TEST(interleaved_appends);
     RUN_TEST(buffered_read_until_end);
     RUN_TEST(buffered_read_with_seek);
     RUN_TEST(buffered_read_with_large_buf);
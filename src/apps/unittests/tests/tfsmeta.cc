@@ -65,6 +65,38 @@ static void dir_listing() {
     }
 }
 
+static void dir_listing_with_info() {
+    const char *dirname = "/largedir";
+    Dir dir(dirname);
+    if(Errors::occurred())
+        exitmsg("open of " << dirname << " failed");
+
+    // the batched entries have to match the separately requested information
+    size_t count = 0;
+    Dir::Entry e;
+    FileInfo info;
+    while(dir.readdir(e, info)) {
+        char path[64];
+        OStringStream os(path, sizeof(path));
+        os << dirname << "/" << e.name;
+
+        FileInfo sinfo;
+        assert_int(VFS::stat(os.str(), sinfo), Errors::NONE);
+        assert_uint(info.inode, e.nodeno);
+        assert_uint(info.inode, sinfo.inode);
+        assert_uint(info.mode, sinfo.mode);
+        assert_size(info.size, sinfo.size);
+        count++;
+    }
+    assert_size(count, 82);
+
+    // after a reset, we get the same number of entries again
+    dir.reset();
+    for(count = 0; dir.readdir(e, info); )
+        count++;
+    assert_size(count, 82);
+}
+
 static void meta_operations() {
     assert_int(VFS::mkdir("/example", 0755), Errors::NONE);
     assert_int(VFS::mkdir("/example", 0755), Errors::EXISTS);
@@ -124,8 +156,32 @@ static void delete_file() {
     assert_int(Errors::last, Errors::NO_SUCH_FILE);
 }
 
+static void cached_lookups() {
+    FileInfo info;
+
+    {
+        FStream f("/cached_file", FILE_W | FILE_CREATE);
+        f << "test\n";
+    }
+
+    // the lookups fill m3fs's dentry cache, including the negative entry
+    assert_int(VFS::stat("/cached_file", info), Errors::NONE);
+    assert_int(VFS::stat("/renamed_file", info), Errors::NO_SUCH_FILE);
+
+    // rename the file via link and unlink
+    assert_int(VFS::link("/cached_file", "/renamed_file"), Errors::NONE);
+    assert_int(VFS::unlink("/cached_file"), Errors::NONE);
+    assert_int(VFS::stat("/cached_file", info), Errors::NO_SUCH_FILE);
+    assert_int(VFS::stat("/renamed_file", info), Errors::NONE);
+
+    assert_int(VFS::unlink("/renamed_file"), Errors::NONE);
+    assert_int(VFS::stat("/renamed_file", info), Errors::NO_SUCH_FILE);
+}
+
 void tfsmeta() {
     RUN_TEST(dir_listing);
+    RUN_TEST(dir_listing_with_info);
     RUN_TEST(meta_operations);
     RUN_TEST(delete_file);
+    RUN_TEST(cached_lookups);
 }
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+
+#include <base/Common.h>
+#include <base/util/Histogram.h>
+#include <base/util/LatencyTable.h>
+
+#include "../unittests.h"
+
+using namespace m3;
+
+static void buckets() {
+    assert_size(Histogram::bucket(0), 0);
+    assert_size(Histogram::bucket(1), 0);
+    assert_size(Histogram::bucket(2), 1);
+    assert_size(Histogram::bucket(3), 1);
+    assert_size(Histogram::bucket(1024), 10);
+    assert_size(Histogram::bucket(2047), 10);
+    assert_size(Histogram::bucket(static_cast<cycles_t>(-1)), Histogram::BUCKETS - 1);
+}
+
+static void percentiles() {
+    Histogram hist;
+    assert_true(hist.percentile(50) == 0);
+
+    // 90 fast values and 10 slow ones
+    for(int i = 0; i < 90; ++i)
+        hist.add(100);
+    for(int i = 0; i < 10; ++i)
+        hist.add(5000);
+
+    assert_true(hist.count() == 100);
+    assert_true(hist.min() == 100);
+    assert_true(hist.max() == 5000);
+    assert_true(hist.avg() == (90 * 100 + 10 * 5000) / 100);
+    assert_uint(hist.bucket_count(Histogram::bucket(100)), 90);
+
+    // 100 is in [64, 128), 5000 in [4096, 8192), bounded by the maximum
+    assert_true(hist.percentile(50) == 127);
+    assert_true(hist.percentile(90) == 127);
+    assert_true(hist.percentile(91) == 5000);
+    assert_true(hist.percentile(100) == 5000);
+
+    hist.reset();
+    assert_true(hist.count() == 0);
+}
+
+static void table() {
+    LatencyTable &tbl = LatencyTable::get();
+    bool was_enabled = tbl.enabled();
+
+    tbl.enable(false);
+    tbl.start(0x4242, 10);
+    tbl.stop(0x4242, 20);
+    assert_true(tbl.get(0x4242) == nullptr);
+
+    tbl.enable();
+    tbl.start(0x4242, 10);
+    tbl.stop(0x4242, 20);
+    // stop without start is ignored
+    tbl.stop(0x4242, 30);
+    tbl.start(0x4242, 100);
+    tbl.stop(0x4242, 130);
+
+    // Time::start looks up the region first and stores the start time afterwards
+    cycles_t *start = tbl.prepare_start(0x4242);
+    assert_true(start != nullptr);
+    if(start)
+        *start = 200;
+    tbl.stop(0x4242, 220);
+    assert_true(tbl.prepare_start(0) == nullptr);
+
+    const Histogram *hist = tbl.get(0x4242);
+    assert_true(hist != nullptr);
+    if(hist) {
+        assert_true(hist->count() == 3);
+        assert_true(hist->min() == 10);
+        assert_true(hist->max() == 30);
+    }
+
+    tbl.reset();
+    assert_true(tbl.get(0x4242) == nullptr);
+    tbl.enable(was_enabled);
+}
+
+void thistogram() {
+    RUN_TEST(buckets);
+    RUN_TEST(percentiles);
+    RUN_TEST(table);
+}
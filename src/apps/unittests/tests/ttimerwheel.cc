@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+#include <base/Common.h>
+#include <base/col/TimerWheel.h>
+
+#include "../unittests.h"
+
+using namespace m3;
+
+static const cycles_t TICK = static_cast<cycles_t>(1) << TimerWheel::TICK_SHIFT;
+
+static void expire_in_order() {
+    TimerWheel wheel;
+    TimerWheel::Timer timers[4];
+    // within the first level, on a higher level, and beyond the range of the wheel
+    cycles_t whens[] = {TICK * 3 + 5, TICK * 3 + 1, TICK * 5000, TICK << 30};
+    for(size_t i = 0; i < ARRAY_SIZE(timers); ++i) {
+        timers[i].when = whens[i];
+        wheel.insert(&timers[i], 0);
+    }
+    assert_size(wheel.length(), 4);
+    assert_true(wheel.next() <= TICK * 3 + 1);
+
+    // nothing is due yet
+    assert_true(wheel.expire(TICK * 3) == nullptr);
+
+    assert_true(wheel.expire(TICK * 3 + 2) == &timers[1]);
+    assert_true(wheel.expire(TICK * 3 + 2) == nullptr);
+    assert_true(wheel.next() > TICK * 3 + 2);
+    assert_true(wheel.expire(TICK * 3 + 5) == &timers[0]);
+
+    assert_true(wheel.expire(TICK * 4999) == nullptr);
+    assert_true(wheel.next() <= TICK * 5000);
+    assert_true(wheel.expire(TICK * 5000) == &timers[2]);
+
+    assert_true(wheel.expire((TICK << 30) - 1) == nullptr);
+    assert_true(wheel.expire(TICK << 30) == &timers[3]);
+    assert_size(wheel.length(), 0);
+}
+
+static void remove() {
+    TimerWheel wheel;
+    TimerWheel::Timer timers[3];
+    for(size_t i = 0; i < ARRAY_SIZE(timers); ++i) {
+        timers[i].when = 100 + i * TICK * 100;
+        wheel.insert(&timers[i], 0);
+    }
+
+    wheel.remove(&timers[0]);
+    wheel.remove(&timers[2]);
+    assert_size(wheel.length(), 1);
+
+    assert_true(wheel.expire(100 + TICK * 300) == &timers[1]);
+    assert_true(wheel.expire(100 + TICK * 300) == nullptr);
+    assert_size(wheel.length(), 0);
+}
+
+void ttimerwheel() {
+    RUN_TEST(expire_in_order);
+    RUN_TEST(remove);
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+
+#include <base/Common.h>
+#include <base/util/Random.h>
+
+#include "../../pipeserv/VarRingBuf.h"
+#include "../unittests.h"
+
+using namespace m3;
+
+static const size_t BUF_SIZE    = 32768;
+static const size_t CHANS       = 3;
+
+static void split_aligned() {
+    VarRingBuf rbuf(BUF_SIZE);
+    VarRingBuf::Segment *w = rbuf.reserve_write(BUF_SIZE);
+    assert_true(w != nullptr);
+    rbuf.commit_write(w, BUF_SIZE);
+
+    // an unaligned read size must not lead to unaligned segment boundaries
+    size_t rdsize = BUF_SIZE / (4 * CHANS);
+    VarRingBuf::Segment *r1 = rbuf.reserve_read(rdsize);
+    VarRingBuf::Segment *r2 = rbuf.reserve_read(rdsize);
+    assert_true(r1 != nullptr && r2 != nullptr);
+    assert_size(r1->end % DTU_PKG_SIZE, 0);
+    assert_size(r2->start % DTU_PKG_SIZE, 0);
+    assert_size(r2->end % DTU_PKG_SIZE, 0);
+    assert_size(r1->pos + r1->len, r2->pos);
+
+    // consume the first one partially and completely afterwards
+    rbuf.commit_read(r1, 100);
+    r1 = rbuf.reserve_read(rdsize);
+    assert_size(r1->pos, 100);
+    rbuf.commit_read(r1, r1->len);
+    rbuf.commit_read(r2, r2->len);
+
+    // the freed space is available again, but does not overlap with the remaining data
+    w = rbuf.reserve_write(BUF_SIZE);
+    assert_true(w != nullptr);
+    assert_size(w->start, 0);
+    assert_true(w->end <= r2->end);
+    rbuf.commit_write(w, 0);
+}
+
+// marks the bytes that contain unread data or belong to a write window
+static bool live[BUF_SIZE];
+
+static bool all(size_t start, size_t end, bool val) {
+    for(size_t i = start; i < end; ++i) {
+        if(live[i] != val)
+            return false;
+    }
+    return true;
+}
+static void mark(size_t start, size_t end, bool val) {
+    for(size_t i = start; i < end; ++i)
+        live[i] = val;
+}
+
+static void fuzz(size_t writers, size_t readers, bool partial) {
+    VarRingBuf rbuf(BUF_SIZE);
+    VarRingBuf::Segment *wsegs[CHANS] = {};
+    size_t wends[CHANS] = {};
+    VarRingBuf::Segment *rsegs[CHANS] = {};
+    size_t wrsize = Math::round_dn(BUF_SIZE / (4 * writers), DTU_PKG_SIZE);
+    size_t rdsize = BUF_SIZE / (4 * readers);
+    size_t written = 0, read = 0;
+    int errors = 0;
+
+    Random::init(partial ? 42 : 1);
+    mark(0, BUF_SIZE, false);
+    for(int i = 0; i < 20000; ++i) {
+        size_t amount = static_cast<size_t>(Random::get());
+        if(Random::get() % 2 == 0) {
+            size_t c = static_cast<size_t>(Random::get()) % writers;
+            if(wsegs[c] == nullptr) {
+                wsegs[c] = rbuf.reserve_write(wrsize);
+                if(wsegs[c]) {
+                    VarRingBuf::Segment *s = wsegs[c];
+                    if((s->start % DTU_PKG_SIZE) != 0 || s->end > BUF_SIZE || !all(s->start, s->end, false))
+                        errors++;
+                    mark(s->start, s->end, true);
+                    wends[c] = s->end;
+                }
+            }
+            else {
+                VarRingBuf::Segment *s = wsegs[c];
+                amount = partial ? amount % (s->len + 1) : s->len;
+                mark(s->start + amount, wends[c], false);
+                rbuf.commit_write(s, amount);
+                written += amount;
+                wsegs[c] = nullptr;
+            }
+        }
+        else {
+            size_t c = static_cast<size_t>(Random::get()) % readers;
+            if(rsegs[c] == nullptr) {
+                rsegs[c] = rbuf.reserve_read(rdsize);
+                if(rsegs[c] && !all(rsegs[c]->pos, rsegs[c]->pos + rsegs[c]->len, true))
+                    errors++;
+            }
+            else {
+                VarRingBuf::Segment *s = rsegs[c];
+                amount = partial ? amount % (s->len + 1) : s->len;
+                mark(s->pos, s->pos + amount, false);
+                read += amount;
+                rbuf.commit_read(s, amount);
+                rsegs[c] = nullptr;
+            }
+        }
+    }
+
+    // finish all windows and drain the buffer
+    for(size_t c = 0; c < CHANS; ++c) {
+        if(wsegs[c]) {
+            written += wsegs[c]->len;
+            rbuf.commit_write(wsegs[c], wsegs[c]->len);
+        }
+        if(rsegs[c])
+            rbuf.commit_read(rsegs[c], 0);
+    }
+    VarRingBuf::Segment *s;
+    while((s = rbuf.reserve_read(rdsize)) != nullptr) {
+        if(!all(s->pos, s->pos + s->len, true))
+            errors++;
+        mark(s->pos, s->pos + s->len, false);
+        read += s->len;
+        rbuf.commit_read(s, s->len);
+    }
+
+    assert_int(errors, 0);
+    assert_true(written > BUF_SIZE);
+    assert_size(read, written);
+    assert_true(rbuf.empty());
+}
+
+static void multi_full() {
+    fuzz(1, CHANS, false);
+    fuzz(CHANS, CHANS, false);
+}
+
+static void multi_partial() {
+    fuzz(1, CHANS, true);
+    fuzz(CHANS, CHANS, true);
+}
+
+void tvarringbuf() {
+    RUN_TEST(split_aligned);
+    RUN_TEST(multi_full);
+    RUN_TEST(multi_partial);
+}
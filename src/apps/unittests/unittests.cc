@@ -41,6 +41,10 @@ int main() {
     RUN_SUITE(tbitfield);
     RUN_SUITE(theap);
     RUN_SUITE(tstream);
+    RUN_SUITE(ttimerwheel);
+    RUN_SUITE(thistogram);
+    RUN_SUITE(tvarringbuf);
+    RUN_SUITE(tdentrycache);
 
     if(failed > 0)
         cout << "\033[1;31m" << failed << " tests failed\033[0;m\n";
@@ -39,6 +39,10 @@ void tfs();
 void tbitfield();
 void theap();
 void tstream();
+void ttimerwheel();
+void thistogram();
+void tvarringbuf();
+void tdentrycache();
 
 #define assert_int(actual, expected) \
     check_equal<int>((expected), (actual), __FILE__, __LINE__)
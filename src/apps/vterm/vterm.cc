@@ -120,7 +120,7 @@ public:
         if(Errors::last != Errors::NONE)
             reply_error(is, Errors::last);
         else
-            reply_vmsg(is, Errors::NONE, pos, len - pos);
+            reply_vmsg(is, Errors::NONE, pos, len - pos, false);
     }
 
     virtual void next_out(m3::GateIStream &is) override {
@@ -148,7 +148,7 @@ public:
         else {
             pos = 0;
             len = BUF_SIZE;
-            reply_vmsg(is, Errors::NONE, static_cast<size_t>(0), BUF_SIZE);
+            reply_vmsg(is, Errors::NONE, static_cast<size_t>(0), BUF_SIZE, false);
         }
     }
 
@@ -200,14 +200,13 @@ public:
     explicit VTermHandler()
         : base_class(),
           _rgate(RecvGate::create(nextlog2<32 * MSG_SIZE>::val, nextlog2<MSG_SIZE>::val)) {
-        add_operation(GenericFile::SEEK, &VTermHandler::invalid_op);
-        add_operation(GenericFile::STAT, &VTermHandler::invalid_op);
-        add_operation(GenericFile::NEXT_IN, &VTermHandler::next_in);
-        add_operation(GenericFile::NEXT_OUT, &VTermHandler::next_out);
-        add_operation(GenericFile::COMMIT, &VTermHandler::commit);
-
-        using std::placeholders::_1;
-        _rgate.start(std::bind(&VTermHandler::handle_message, this, _1));
+        add_operation<&VTermHandler::invalid_op>(GenericFile::SEEK);
+        add_operation<&VTermHandler::invalid_op>(GenericFile::STAT);
+        add_operation<&VTermHandler::next_in>(GenericFile::NEXT_IN);
+        add_operation<&VTermHandler::next_out>(GenericFile::NEXT_OUT);
+        add_operation<&VTermHandler::commit>(GenericFile::COMMIT);
+
+        _rgate.start<base_class, &base_class::handle_message>(this);
     }
 
     virtual Errors::Code open(VTermSession **sess, capsel_t srv_sel, word_t) override {
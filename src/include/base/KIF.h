@@ -352,6 +352,13 @@ struct KIF {
      * Service calls
      */
     struct Service {
+        /**
+         * The size of the receive buffer slots of services for requests from the kernel and the
+         * number of slots. The kernel sends up to MSG_SLOTS requests to a service at once.
+         */
+        static const size_t MSG_SIZE    = 256;
+        static const size_t MSG_SLOTS   = 4;
+
         enum Operation {
             OPEN,
             OBTAIN,
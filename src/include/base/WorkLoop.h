@@ -29,6 +29,14 @@ public:
     virtual ~WorkItem() {
     }
 
+    /**
+     * @return the endpoint this item receives messages from, or EP_COUNT if it needs to be called
+     *  on every tick. in the former case, it is only called if the endpoint has unread messages.
+     */
+    virtual epid_t ep() const {
+        return EP_COUNT;
+    }
+
     virtual void work() = 0;
 };
 
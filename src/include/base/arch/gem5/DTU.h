@@ -286,6 +286,14 @@ public:
         return read_reg(DtuRegs::MSG_CNT);
     }
 
+    /**
+     * @return a bitmask of the endpoints that might have unread messages. the DTU only counts the
+     *  unread messages in total, so that either all or none are reported.
+     */
+    uint64_t ready_mask() {
+        return msgcnt() > 0 ? ~static_cast<uint64_t>(0) : 0;
+    }
+
     cycles_t tsc() const {
         return read_reg(DtuRegs::CUR_TIME);
     }
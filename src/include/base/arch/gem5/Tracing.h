@@ -58,12 +58,20 @@ public:
         DTU::get().debug_msg((uint64_t)EVENT_FUNC_EXIT << 48);
     }
 
+    inline void event_time_start(uint) {
+    }
+
+    inline void event_time_stop(uint) {
+    }
+
     void flush() {
     }
     void flush_light() {
     }
     void reinit() {
     }
+    void finish() {
+    }
     void init_kernel() {
     }
     void trace_dump() {
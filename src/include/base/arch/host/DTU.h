@@ -131,6 +131,7 @@ public:
         RESP                                    = 5,
         FETCHMSG                                = 6,
         ACKMSG                                  = 7,
+        COPY                                    = 8,
     };
 
     static const epid_t SYSC_SEP                = 0;
@@ -206,6 +207,16 @@ public:
         setup_command(ep, WRITE, msg, size, off, size, label_t(), 0);
         return exec_command();
     }
+    /**
+     * Copies <size> bytes from <srcoff> in the memory of <srcep> to <off> in the memory of <ep>.
+     * Both endpoints have to refer to memory of the same PE, whose DTU performs the copy.
+     */
+    Errors::Code copy(epid_t ep, size_t off, epid_t srcep, size_t srcoff, size_t size) {
+        // CMD_SIZE and CMD_ADDR are not needed for the data, so that we use them for the source
+        setup_command(ep, COPY, reinterpret_cast<const void*>(srcoff), srcep, off, size, label_t(), 0);
+        exec_command();
+        return (get_cmd(CMD_CTRL) & CTRL_ERROR) ? Errors::INV_ARGS : Errors::NONE;
+    }
 
     bool is_valid(epid_t) const {
         // TODO not supported
@@ -216,6 +227,15 @@ public:
         return false;
     }
 
+    /**
+     * @return a bitmask of the endpoints that (might) have unread messages. the bits are set on
+     *  message reception and cleared as soon as the last message has been fetched. as the kernel
+     *  can reconfigure endpoints externally, a set bit is only a hint.
+     */
+    uint64_t ready_mask() const {
+        return _ready;
+    }
+
     Message *fetch_msg(epid_t ep) {
         if(get_ep(ep, EP_BUF_MSGCNT) == 0)
             return nullptr;
@@ -296,6 +316,13 @@ private:
             unread &= ~(static_cast<word_t>(1) << idx);
     }
 
+    void set_ready(epid_t ep, bool ready) {
+        if(ready)
+            __atomic_fetch_or(&_ready, static_cast<uint64_t>(1) << ep, __ATOMIC_RELAXED);
+        else
+            __atomic_fetch_and(&_ready, ~(static_cast<uint64_t>(1) << ep), __ATOMIC_RELAXED);
+    }
+
     bool is_occupied(word_t occupied, size_t idx) const {
         return occupied & (static_cast<word_t>(1) << idx);
     }
@@ -310,12 +337,14 @@ private:
     word_t prepare_send(epid_t ep, peid_t &dstpe, epid_t &dstep);
     word_t prepare_read(epid_t ep, peid_t &dstpe, epid_t &dstep);
     word_t prepare_write(epid_t ep, peid_t &dstpe, epid_t &dstep);
+    word_t prepare_copy(epid_t ep, peid_t &dstpe, epid_t &dstep);
     word_t prepare_fetchmsg(epid_t ep);
     word_t prepare_ackmsg(epid_t ep);
 
     void send_msg(epid_t ep, peid_t dstpe, epid_t dstep, bool isreply);
     void handle_read_cmd(epid_t ep);
     void handle_write_cmd(epid_t ep);
+    void handle_copy_cmd(epid_t ep);
     void handle_resp_cmd();
     void handle_command(peid_t pe);
     void handle_msg(size_t len, epid_t ep);
@@ -328,6 +357,7 @@ private:
     volatile word_t _cmdregs[CMDS_RCNT];
     // have to be aligned by 8 because it shouldn't collide with MemGate::RWX bits
     alignas(8) volatile word_t _epregs[EPS_RCNT * EP_COUNT];
+    volatile uint64_t _ready;
     DTUBackend *_backend;
     pthread_t _tid;
     static Buffer _buf;
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+
+#pragma once
+
+#include <base/Config.h>
+#include <base/arch/host/TracingEvent.h>
+#include <base/tracing/Event.h>
+#include <base/tracing/Config.h>
+
+#include <string.h>
+
+namespace m3 {
+
+class Tracing {
+public:
+    Tracing();
+
+    static inline Tracing &get() {
+        return _inst;
+    }
+
+    inline void event_msg_send(peid_t remotepe, size_t length, uint16_t tag) {
+        record(EVENT_MSG_SEND, remotepe, length, tag);
+    }
+
+    inline void event_msg_recv(peid_t remotepe, size_t length, uint16_t tag) {
+        record(EVENT_MSG_RECV, remotepe, length, tag);
+    }
+
+    inline void event_mem_read(peid_t remotepe, size_t length) {
+        record(EVENT_MEM_READ, remotepe, length, 0);
+    }
+
+    inline void event_mem_write(peid_t remotepe, size_t length) {
+        record(EVENT_MEM_WRITE, remotepe, length, 0);
+    }
+
+    inline void event_mem_finish() {
+        record(EVENT_MEM_FINISH, 0, 0, 0);
+    }
+
+    inline void event_ufunc_enter(const char name[5]) {
+        uint32_t id;
+        memcpy(&id, name, sizeof(id));
+        record(EVENT_UFUNC_ENTER, 0, 0, id);
+    }
+
+    inline void event_ufunc_exit() {
+        record(EVENT_UFUNC_EXIT, 0, 0, 0);
+    }
+
+    inline void event_func_enter(uint32_t id) {
+        record(EVENT_FUNC_ENTER, 0, 0, id);
+    }
+
+    inline void event_func_exit() {
+        record(EVENT_FUNC_EXIT, 0, 0, 0);
+    }
+
+    inline void event_time_start(uint id) {
+        record(EVENT_TIME_START, 0, 0, id);
+    }
+
+    inline void event_time_stop(uint id) {
+        record(EVENT_TIME_STOP, 0, 0, id);
+    }
+
+    /**
+     * Nothing to do here, because the ring is in shared memory and dumped at exit
+     */
+    void flush() {
+    }
+    void flush_light() {
+    }
+
+    /**
+     * Creates a new ring for this process. Has to be called in the child after fork.
+     */
+    void reinit();
+
+    /**
+     * Truncates the trace file. The kernel calls this before starting the other VPEs.
+     */
+    void init_kernel();
+
+    /**
+     * Appends the rings of all processes that did not exit on their own to the trace file and
+     * removes them (kernel only).
+     */
+    void trace_dump();
+
+    /**
+     * Appends the ring of this process to the trace file and removes it. Has to be called at exit,
+     * after the DTU thread has been stopped, because it unmaps the ring.
+     */
+    void finish();
+
+private:
+    void record(uint32_t type, peid_t remote, size_t size, uint32_t payload);
+    void attach();
+    void detach(bool remove);
+    static void dump(const TraceRing *ring);
+
+    TraceRing *_ring;
+    char _name[64];
+    static Tracing _inst;
+};
+
+}
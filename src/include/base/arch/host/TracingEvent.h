@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+
+// ATTENTION: this file should not depend on any other include file,
+// since we use it in the m3trace2otf converter
+
+// number of events in the ring of each process
+#define TRACE_RING_SIZE         (16 * 1024)
+// name of the shared memory that holds the ring (the shm prefix and the pid is added)
+#define TRACE_RING_NAME         "trace-"
+// the file the rings are dumped to
+#define TRACE_FILE              "run/trace.txt"
+
+/*
+
+Each process records its events into a ring in shared memory. The slot of an event is claimed by
+atomically incrementing the position, so that the DTU thread and the application thread can record
+events concurrently. If the ring is full, the oldest events are overwritten.
+
+At exit, each process appends its ring to TRACE_FILE. The kernel appends the rings of processes that
+did not exit on their own (e.g., daemons) during shutdown. The file consists of blocks like this:
+
+h <pe> <pid> <executable>
+<timestamp> <type> <remote> <size> <payload>
+...
+
+The timestamp (TSC value) and the payload are in hex, all other values in decimal. For messages and
+memory accesses, remote is the PE of the communication partner. The payload is the function id
+(EVENT_FUNC_ENTER), the function name (EVENT_UFUNC_ENTER), the id passed to Time::start/stop
+(EVENT_TIME_START/EVENT_TIME_STOP) or the message tag (EVENT_MSG_*).
+
+*/
+
+namespace m3 {
+
+struct TraceEvent {
+    uint64_t timestamp;
+    uint32_t type;
+    uint32_t remote;
+    uint32_t size;
+    uint32_t payload;
+};
+
+struct TraceRing {
+    uint32_t pe;
+    uint32_t pid;
+    char name[32];
+    // the number of events that have been recorded; the ring holds the last TRACE_RING_SIZE ones
+    uint64_t pos;
+    TraceEvent events[TRACE_RING_SIZE];
+};
+
+}
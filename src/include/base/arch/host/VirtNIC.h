@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+
+#pragma once
+
+#include <base/Common.h>
+
+// name of the shared memory that holds the virtual NIC (the shm prefix is added)
+#define VNIC_SHM_NAME           "vnic"
+
+/*
+
+The virtual NIC connects two net instances on host with a point-to-point link. The kernel creates
+the shared memory (-n option) and checks whether the owners of the ports are still alive. Each net
+instance claims a free port by writing its pid into it. A frame is sent by putting it into the
+receive ring of the other port. Each ring has a single producer (the peer) and a single consumer
+(the owner of the port), so that the free-running head and tail counters suffice to synchronize them.
+
+*/
+
+namespace m3 {
+
+struct VirtNICMem {
+    static const size_t PORTS       = 2;
+    static const size_t SLOTS       = 256;
+    static const size_t FRAME_SIZE  = 2048;
+
+    struct Slot {
+        uint32_t size;
+        uint8_t data[FRAME_SIZE - sizeof(uint32_t)];
+    };
+
+    struct Ring {
+        // the next slot to receive from; written by the owner of the port
+        uint32_t head;
+        // the next slot to send to; written by the peer
+        uint32_t tail;
+        Slot slots[SLOTS];
+    };
+
+    struct Port {
+        // the pid of the owner; 0 if the port is free
+        int32_t pid;
+        // set by the kernel if both ports are owned
+        uint32_t link_up;
+        Ring rx;
+    };
+
+    static size_t peer(size_t port) {
+        return (port + 1) % PORTS;
+    }
+
+    Port ports[PORTS];
+};
+
+}
@@ -106,6 +106,12 @@ public:
         }
     }
 
+    inline void event_time_start(uint) {
+    }
+
+    inline void event_time_stop(uint) {
+    }
+
     /**
      * flush local buffer to Mem
      * expects reinit() before next event (events will be flushed instantly between flush() and reinit())
@@ -135,6 +141,12 @@ public:
      */
     void trace_dump();
 
+    /**
+     * nothing to do at exit, the buffer is in Mem
+     */
+    void finish() {
+    }
+
 private:
     void record_event_msg(uint8_t type, uchar remotecore, size_t length, uint16_t tag);
     void record_event_mem(uint8_t type, uchar remotecore, size_t length);
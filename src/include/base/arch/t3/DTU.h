@@ -114,6 +114,14 @@ public:
         return true;
     }
 
+    /**
+     * @return a bitmask of the endpoints that might have unread messages. this DTU can't tell
+     *  us, so that all endpoints are reported.
+     */
+    uint64_t ready_mask() const {
+        return ~static_cast<uint64_t>(0);
+    }
+
     bool fetch_msg(epid_t ep) const {
         return element_count(ep) - _unack[ep] > 0;
     }
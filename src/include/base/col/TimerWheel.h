@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+#pragma once
+
+#include <base/Common.h>
+#include <base/col/DList.h>
+
+namespace m3 {
+
+/**
+ * A hierarchical timing wheel. Timers are put into one of LEVELS wheels with SLOTS slots each,
+ * depending on how far they are in the future. The slots of level 0 cover a single tick, the
+ * slots of level n cover SLOTS^n ticks. Whenever the current time reaches a slot of a higher
+ * level, its timers are distributed to the lower levels. Thus, inserting and removing timers
+ * takes constant time. A bitmap per level is used to find the next non-empty slot quickly.
+ *
+ * The timers are intrusive, i.e., the user inherits from TimerWheel::Timer and is responsible
+ * for the allocation.
+ */
+class TimerWheel {
+public:
+    static const uint TICK_SHIFT    = 10;
+    static const uint SLOT_BITS     = 6;
+    static const uint SLOTS         = 1 << SLOT_BITS;
+    static const uint LEVELS        = 4;
+
+    struct Timer : public DListItem {
+        explicit Timer()
+            : DListItem(),
+              when(),
+              level(),
+              slot() {
+        }
+
+        cycles_t when;
+        uint8_t level;
+        uint8_t slot;
+    };
+
+    explicit TimerWheel()
+        : _count(),
+          _cur(),
+          _next(static_cast<cycles_t>(-1)),
+          _bitmap(),
+          _slots() {
+    }
+
+    /**
+     * @return the number of timers
+     */
+    size_t length() const {
+        return _count;
+    }
+
+    /**
+     * @return a lower bound for the time at which the next timer expires (-1 if there is none)
+     */
+    cycles_t next() const {
+        return _next;
+    }
+
+    /**
+     * Inserts <t>, which expires at <t->when>.
+     *
+     * @param t the timer
+     * @param now the current time
+     */
+    void insert(Timer *t, cycles_t now) {
+        // if we have no timers, we might be far behind; start at the current time
+        if(_count == 0)
+            _cur = now >> TICK_SHIFT;
+        _count++;
+        if(t->when < _next)
+            _next = t->when;
+        place(t);
+    }
+
+    /**
+     * Removes <t> from the wheel.
+     *
+     * @param t the timer
+     */
+    void remove(Timer *t) {
+        DList<Timer> &list = _slots[t->level][t->slot];
+        list.remove(t);
+        if(list.length() == 0)
+            _bitmap[t->level] &= ~(static_cast<uint64_t>(1) << t->slot);
+        // _next stays a valid lower bound
+        _count--;
+    }
+
+    /**
+     * Removes and returns the next timer that has expired at <now>. Call it repeatedly to get all
+     * expired timers. It is allowed to insert and remove timers in between.
+     *
+     * @param now the current time
+     * @return the expired timer or nullptr if there is none
+     */
+    Timer *expire(cycles_t now) {
+        if(_count == 0 || now < _next)
+            return nullptr;
+
+        uint64_t nowtick = now >> TICK_SHIFT;
+        while(_count > 0) {
+            uint level = 0;
+            uint64_t ev = next_event(&level);
+            if(ev > nowtick)
+                break;
+            if(ev > _cur) {
+                _cur = ev;
+                cascade();
+            }
+
+            DList<Timer> &list = _slots[0][_cur & (SLOTS - 1)];
+            for(auto it = list.begin(); it != list.end(); ++it) {
+                if(it->when <= now) {
+                    Timer *t = &*it;
+                    remove(t);
+                    return t;
+                }
+            }
+
+            // the remaining timers of the current tick are not due yet
+            if(_cur == nowtick)
+                break;
+        }
+
+        // nothing happens until <now>, so we can move forward
+        if(_cur < nowtick)
+            _cur = nowtick;
+        update_next();
+        return nullptr;
+    }
+
+private:
+    void place(Timer *t) {
+        uint64_t tick = t->when >> TICK_SHIFT;
+        if(tick < _cur)
+            tick = _cur;
+
+        uint level = 0;
+        while(level < LEVELS - 1 && (tick >> (level * SLOT_BITS)) - (_cur >> (level * SLOT_BITS)) >= SLOTS)
+            level++;
+        uint64_t lslot = tick >> (level * SLOT_BITS);
+        // timers beyond the range of the wheel are put into the last slot and placed again later
+        uint64_t max = (_cur >> (level * SLOT_BITS)) + SLOTS - 1;
+        if(lslot > max)
+            lslot = max;
+
+        t->level = static_cast<uint8_t>(level);
+        t->slot = static_cast<uint8_t>(lslot & (SLOTS - 1));
+        _slots[t->level][t->slot].append(t);
+        _bitmap[t->level] |= static_cast<uint64_t>(1) << t->slot;
+    }
+
+    void cascade() {
+        for(uint level = LEVELS - 1; level > 0; --level) {
+            uint shift = level * SLOT_BITS;
+            if(_cur & ((static_cast<uint64_t>(1) << shift) - 1))
+                continue;
+
+            uint slot = (_cur >> shift) & (SLOTS - 1);
+            DList<Timer> &list = _slots[level][slot];
+            _bitmap[level] &= ~(static_cast<uint64_t>(1) << slot);
+            while(list.length() > 0)
+                place(list.removeFirst());
+        }
+    }
+
+    uint64_t next_event(uint *evlevel) const {
+        uint64_t ev = static_cast<uint64_t>(-1);
+        for(uint level = 0; level < LEVELS; ++level) {
+            if(_bitmap[level] == 0)
+                continue;
+
+            // level 0 fires the current slot; higher levels have no timers in their current slot
+            uint shift = level * SLOT_BITS;
+            uint first = level == 0 ? 0 : 1;
+            uint rot = ((_cur >> shift) + first) & (SLOTS - 1);
+            uint64_t bits = _bitmap[level];
+            if(rot)
+                bits = (bits >> rot) | (bits << (SLOTS - rot));
+            uint64_t tick = ((_cur >> shift) + first + static_cast<uint>(__builtin_ctzll(bits))) << shift;
+            // on equality, prefer the higher level, because it needs to be distributed first
+            if(tick <= ev) {
+                ev = tick;
+                *evlevel = level;
+            }
+        }
+        return ev;
+    }
+
+    void update_next() {
+        if(_count == 0) {
+            _next = static_cast<cycles_t>(-1);
+            return;
+        }
+
+        uint level = 0;
+        uint64_t ev = next_event(&level);
+        if(level > 0) {
+            // the timers need to be distributed first
+            _next = ev << TICK_SHIFT;
+            return;
+        }
+
+        _next = static_cast<cycles_t>(-1);
+        DList<Timer> &list = _slots[0][ev & (SLOTS - 1)];
+        for(auto it = list.begin(); it != list.end(); ++it) {
+            if(it->when < _next)
+                _next = it->when;
+        }
+    }
+
+    size_t _count;
+    uint64_t _cur;
+    cycles_t _next;
+    uint64_t _bitmap[LEVELS];
+    DList<Timer> _slots[LEVELS][SLOTS];
+};
+
+}
@@ -16,8 +16,8 @@
 
 #pragma once
 
-// this does currently only work on the T2 chip and on gem5
-#if defined(__t2__) || defined(__gem5__)
+// this does currently only work on the T2 chip, on gem5 and on host
+#if defined(__t2__) || defined(__gem5__) || defined(__host__)
 
 // enable/disable tracing
 // #define TRACE_ENABLED
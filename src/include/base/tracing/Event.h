@@ -32,6 +32,8 @@ enum event_types {
     EVENT_MEM_READ              = 8,
     EVENT_MEM_WRITE             = 9,
     EVENT_MEM_FINISH            = 10,
+    EVENT_TIME_START            = 11,
+    EVENT_TIME_STOP             = 12,
 };
 
 #if defined(TRACE_FUNCS_TO_STRING)
@@ -110,6 +110,10 @@
 #define EVENT_TRACE_MSG_SEND(pe, len, tag)      m3::Tracing::get().event_msg_send(pe, len, tag);
 /// message receive
 #define EVENT_TRACE_MSG_RECV(pe, len, tag)      m3::Tracing::get().event_msg_recv(pe, len, tag);
+/// start of a time measurement via Time::start
+#define EVENT_TRACE_TIME_START(id)              m3::Tracing::get().event_time_start(id);
+/// end of a time measurement via Time::stop
+#define EVENT_TRACE_TIME_STOP(id)               m3::Tracing::get().event_time_stop(id);
 ///
 /// initialize at kernel
 #define EVENT_TRACE_INIT_KERNEL()               m3::Tracing::get().init_kernel();
@@ -121,11 +125,15 @@
 #define EVENT_TRACE_FLUSH()                     m3::Tracing::get().flush();
 /// dump trace to stdout (kernel only)
 #define EVENT_TRACE_DUMP()                      m3::Tracing::get().trace_dump();
+/// dump the trace of this process at exit
+#define EVENT_TRACE_FINISH()                    m3::Tracing::get().finish();
 
 #if defined(__t2__)
 #   include <base/arch/t2/Tracing.h>
 #elif defined(__gem5__)
 #   include <base/arch/gem5/Tracing.h>
+#elif defined(__host__)
+#   include <base/arch/host/Tracing.h>
 #endif
 
 namespace m3 {
@@ -166,10 +174,13 @@ public:
 #define EVENT_TRACE_MEM_WRITE(pe, length)
 #define EVENT_TRACE_MSG_SEND(pe, length, tag)
 #define EVENT_TRACE_MSG_RECV(pe, length, tag)
+#define EVENT_TRACE_TIME_START(id)
+#define EVENT_TRACE_TIME_STOP(id)
 #define EVENT_TRACE_INIT_KERNEL()
 #define EVENT_TRACE_REINIT()
 #define EVENT_TRACE_FLUSH_LIGHT()
 #define EVENT_TRACE_FLUSH()
 #define EVENT_TRACE_DUMP()
+#define EVENT_TRACE_FINISH()
 
 #endif
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+
+#pragma once
+
+#include <base/Common.h>
+#include <base/stream/OStream.h>
+#include <base/util/Math.h>
+
+namespace m3 {
+
+/**
+ * A histogram of latencies with logarithmic buckets. Bucket i counts the values in [2^i, 2^(i+1)),
+ * bucket 0 additionally counts 0. Adding a value is cheap and does not allocate memory, so that it
+ * can be used on hot paths. Percentiles are therefore only precise up to a factor of two.
+ */
+class Histogram {
+public:
+    static const size_t BUCKETS = 48;
+
+    constexpr Histogram()
+        : _count(),
+          _sum(),
+          _min(),
+          _max(),
+          _buckets() {
+    }
+
+    /**
+     * @param val the value
+     * @return the bucket for given value
+     */
+    static size_t bucket(cycles_t val) {
+        if(val == 0)
+            return 0;
+        size_t log = sizeof(unsigned long long) * 8 - 1 -
+                     static_cast<size_t>(__builtin_clzll(static_cast<unsigned long long>(val)));
+        return Math::min(log, BUCKETS - 1);
+    }
+
+    /**
+     * Adds given value to the histogram
+     *
+     * @param val the value
+     */
+    void add(cycles_t val) {
+        if(_count == 0 || val < _min)
+            _min = val;
+        if(val > _max)
+            _max = val;
+        _count++;
+        _sum += val;
+        _buckets[bucket(val)]++;
+    }
+
+    /**
+     * Removes all values
+     */
+    void reset() {
+        _count = 0;
+        _sum = 0;
+        _min = 0;
+        _max = 0;
+        for(size_t i = 0; i < BUCKETS; ++i)
+            _buckets[i] = 0;
+    }
+
+    uint64_t count() const {
+        return _count;
+    }
+    cycles_t min() const {
+        return _min;
+    }
+    cycles_t max() const {
+        return _max;
+    }
+    cycles_t avg() const {
+        return _count ? _sum / _count : 0;
+    }
+    uint32_t bucket_count(size_t i) const {
+        return _buckets[i];
+    }
+
+    /**
+     * Determines the p-th percentile. As the buckets are logarithmic, the result is the end of the
+     * bucket that contains the percentile, bounded by the minimum and maximum.
+     *
+     * @param p the percentile (0..100)
+     * @return the upper bound for the p-th percentile
+     */
+    cycles_t percentile(uint p) const {
+        if(_count == 0)
+            return 0;
+
+        uint64_t rank = Math::max<uint64_t>((_count * p + 99) / 100, 1);
+        uint64_t seen = 0;
+        for(size_t i = 0; i < BUCKETS; ++i) {
+            seen += _buckets[i];
+            if(seen >= rank) {
+                cycles_t end = i + 1 < BUCKETS ? (static_cast<cycles_t>(2) << i) - 1 : _max;
+                return Math::max(Math::min(end, _max), _min);
+            }
+        }
+        return _max;
+    }
+
+    friend OStream &operator<<(OStream &os, const Histogram &h) {
+        os << "count=" << h.count() << " min=" << h.min() << " avg=" << h.avg()
+           << " p50=" << h.percentile(50) << " p90=" << h.percentile(90)
+           << " p99=" << h.percentile(99) << " max=" << h.max();
+        return os;
+    }
+
+private:
+    uint64_t _count;
+    cycles_t _sum;
+    cycles_t _min;
+    cycles_t _max;
+    uint32_t _buckets[BUCKETS];
+};
+
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+
+#pragma once
+
+#include <base/Common.h>
+#include <base/stream/OStream.h>
+#include <base/util/Histogram.h>
+
+namespace m3 {
+
+/**
+ * Collects latency histograms for the regions between Time::start(id) and Time::stop(id). The
+ * table has a fixed size and does not allocate memory, so that it can stay enabled in production
+ * runs. It is disabled by default and can be enabled via enable() or, on host, by setting the
+ * environment variable M3_LATENCIES. If enabled, the histograms are printed on exit.
+ *
+ * Regions with id 0 are ignored. If a region is started again before it has been stopped, the
+ * latter start counts. Ids beyond MAX_IDS different ones are ignored.
+ */
+class LatencyTable {
+    struct Entry {
+        constexpr Entry()
+            : id(),
+              running(),
+              start(),
+              hist() {
+        }
+
+        unsigned id;
+        bool running;
+        cycles_t start;
+        Histogram hist;
+    };
+
+public:
+    static const size_t MAX_IDS = 16;
+
+    static LatencyTable &get() {
+        return _inst;
+    }
+
+    constexpr LatencyTable()
+        : _enabled(),
+          _entries() {
+    }
+
+    bool enabled() const {
+        return _enabled;
+    }
+    void enable(bool en = true) {
+        _enabled = en;
+    }
+
+    /**
+     * Marks region <id> as started and returns the location for its start time. Time::start uses
+     * that to look up the region before it reads the counter, so that the lookup is not measured.
+     *
+     * @return the location for the start time or nullptr if the region is not recorded
+     */
+    cycles_t *prepare_start(unsigned id) {
+        if(_enabled && id) {
+            Entry *e = find(id, true);
+            if(e) {
+                e->running = true;
+                return &e->start;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Records the start of region <id> at <now>
+     */
+    void start(unsigned id, cycles_t now) {
+        cycles_t *start = prepare_start(id);
+        if(start)
+            *start = now;
+    }
+
+    /**
+     * Records the end of region <id> at <now>
+     */
+    void stop(unsigned id, cycles_t now) {
+        if(_enabled && id) {
+            Entry *e = find(id, false);
+            if(e && e->running) {
+                e->hist.add(now - e->start);
+                e->running = false;
+            }
+        }
+    }
+
+    /**
+     * @param id the region id
+     * @return the histogram for given region or nullptr if it has never been started
+     */
+    const Histogram *get(unsigned id) const {
+        Entry *e = const_cast<LatencyTable*>(this)->find(id, false);
+        return e ? &e->hist : nullptr;
+    }
+
+    /**
+     * Removes all regions
+     */
+    void reset();
+
+    /**
+     * Prints the histograms of all regions to <os>
+     */
+    void print(OStream &os) const;
+
+    /**
+     * Prints the histograms to the serial line, if enabled
+     */
+    void dump() const;
+
+private:
+    Entry *find(unsigned id, bool create) {
+        // open addressing with linear probing; the ids are typically constants like 0xaaaa
+        size_t start = (id * 2654435761U) % MAX_IDS;
+        for(size_t i = 0; i < MAX_IDS; ++i) {
+            Entry *e = _entries + (start + i) % MAX_IDS;
+            if(e->id == id)
+                return e;
+            if(e->id == 0) {
+                if(!create)
+                    return nullptr;
+                e->id = id;
+                return e;
+            }
+        }
+        return nullptr;
+    }
+
+    bool _enabled;
+    Entry _entries[MAX_IDS];
+    static LatencyTable _inst;
+};
+
+}
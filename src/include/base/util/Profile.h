@@ -17,7 +17,9 @@
 #pragma once
 
 #include <base/Common.h>
+#include <base/util/LatencyTable.h>
 #include <base/util/Math.h>
+#include <base/util/Sort.h>
 #include <base/util/Time.h>
 
 #include <base/stream/OStream.h>
@@ -27,6 +29,17 @@
 namespace m3 {
 
 class Profile;
+class Results;
+
+/**
+ * Prints results as a JSON object on a single line for regression tracking
+ */
+struct JSONResults {
+    const Results &res;
+    const char *name;
+    size_t param;
+    size_t units;
+};
 
 class Results {
     friend class Profile;
@@ -34,8 +47,20 @@ class Results {
 public:
     explicit Results(size_t runs)
         : _runs(0),
+          _sorted(true),
           _times(new cycles_t[runs]) {
     }
+    Results(Results &&r)
+        : _runs(r._runs),
+          _sorted(r._sorted),
+          _times(r._times) {
+        r._times = nullptr;
+    }
+    Results(const Results&) = delete;
+    Results &operator=(const Results&) = delete;
+    ~Results() {
+        delete[] _times;
+    }
 
     size_t runs() const {
         return _runs;
@@ -45,7 +70,7 @@ public:
         cycles_t sum = 0;
         for(size_t i = 0; i < _runs; ++i)
             sum += _times[i];
-        return sum / _runs;
+        return _runs ? sum / _runs : 0;
     }
 
     float stddev() const {
@@ -59,23 +84,95 @@ public:
                 val = _times[i] - average;
             sum += val * val;
         }
-        return Math::sqrt((float)sum / _runs);
+        return _runs ? Math::sqrt((float)sum / _runs) : 0;
+    }
+
+    /**
+     * @param p the percentile (0..100)
+     * @return the p-th percentile of the runtimes (nearest rank)
+     */
+    cycles_t percentile(uint p) const {
+        if(_runs == 0)
+            return 0;
+        sort_times();
+        size_t rank = (_runs * p + 99) / 100;
+        return _times[rank > 0 ? rank - 1 : 0];
+    }
+    cycles_t min() const {
+        return percentile(0);
+    }
+    cycles_t median() const {
+        return percentile(50);
+    }
+    cycles_t max() const {
+        return percentile(100);
+    }
+
+    /**
+     * @param units the number of units (e.g., bytes or operations) processed per run
+     * @return the throughput in units per cycle
+     */
+    float throughput(size_t units) const {
+        cycles_t average = avg();
+        return average ? static_cast<float>(units) / average : 0;
+    }
+
+    /**
+     * Returns an object to print the results as a single JSON line via operator<<.
+     *
+     * @param name the name of the benchmark
+     * @param param the parameter of the benchmark (e.g., the message size; 0 = none)
+     * @param units the units processed per run to report the throughput (0 = none)
+     */
+    JSONResults json(const char *name, size_t param = 0, size_t units = 0) const {
+        return JSONResults{*this, name, param, units};
     }
 
     friend OStream &operator<<(OStream &os, const Results &r) {
-        os << r.avg() << " cycles/iter (+/- " << r.stddev() << " with " << r.runs() << " runs)";
+        os << r.avg() << " cycles/iter (+/- " << r.stddev() << " with " << r.runs() << " runs)"
+           << ", median " << r.median() << ", p99 " << r.percentile(99) << ", max " << r.max();
         return os;
     }
 
 private:
     void push(cycles_t time) {
         _times[_runs++] = time;
+        _sorted = false;
+    }
+
+    void sort_times() const {
+        if(!_sorted) {
+            sort(_times, _times + _runs, [](cycles_t a, cycles_t b) {
+                return a < b;
+            });
+            _sorted = true;
+        }
     }
 
     size_t _runs;
+    mutable bool _sorted;
     cycles_t *_times;
 };
 
+inline OStream &operator<<(OStream &os, const JSONResults &j) {
+    const Results &r = j.res;
+    os << "{\"name\":\"" << j.name << "\"";
+    if(j.param)
+        os << ",\"param\":" << j.param;
+    os << ",\"runs\":" << r.runs()
+       << ",\"avg\":" << r.avg()
+       << ",\"stddev\":" << r.stddev()
+       << ",\"min\":" << r.min()
+       << ",\"median\":" << r.median()
+       << ",\"p90\":" << r.percentile(90)
+       << ",\"p99\":" << r.percentile(99)
+       << ",\"max\":" << r.max();
+    if(j.units)
+        os << ",\"throughput\":" << r.throughput(j.units);
+    os << "}";
+    return os;
+}
+
 struct Runner {
     virtual ~Runner() {
     }
@@ -93,6 +190,24 @@ public:
           _warmup(warmup) {
     }
 
+    /**
+     * Enables or disables the latency histograms for all Time::start/stop regions, including the
+     * ones of run_with_id and runner_with_id.
+     *
+     * @param en whether to enable them
+     */
+    static void enable_latencies(bool en = true) {
+        LatencyTable::get().enable(en);
+    }
+
+    /**
+     * @param id the id passed to Time::start/stop
+     * @return the latency histogram for the regions with given id or nullptr
+     */
+    static const Histogram *latencies(unsigned id) {
+        return LatencyTable::get().get(id);
+    }
+
     template<typename F>
     ALWAYS_INLINE Results run(F func) const {
         return run_with_id(func, 0);
@@ -100,7 +215,7 @@ public:
 
     template<typename F>
     ALWAYS_INLINE Results run_with_id(F func, unsigned id) const {
-        Results res(_warmup + _repeats);
+        Results res(_repeats);
         for(ulong i = 0; i < _warmup + _repeats; ++i) {
             auto start = Time::start(id);
             func();
@@ -114,7 +229,7 @@ public:
 
     template<class R>
     ALWAYS_INLINE Results runner_with_id(R &runner, unsigned id) const {
-        Results res(_warmup + _repeats);
+        Results res(_repeats);
         for(ulong i = 0; i < _warmup + _repeats; ++i) {
             runner.pre();
 
@@ -130,6 +245,30 @@ public:
         return res;
     }
 
+    /**
+     * Runs <func>(param) for all given parameters (e.g., message sizes) and prints one JSON line
+     * per parameter to <os>.
+     *
+     * @param os the stream to print the results to
+     * @param name the name of the benchmark
+     * @param params the parameters
+     * @param count the number of parameters
+     * @param func the benchmark, receiving the parameter
+     * @param id the id for Time::start/stop
+     * @param tput whether to report the throughput, treating the parameter as processed units
+     */
+    template<typename F>
+    void sweep(OStream &os, const char *name, const size_t *params, size_t count, F func,
+               unsigned id = 0, bool tput = false) const {
+        for(size_t i = 0; i < count; ++i) {
+            size_t param = params[i];
+            Results res = run_with_id([&func, param] {
+                func(param);
+            }, id);
+            os << res.json(name, param, tput ? param : 0) << "\n";
+        }
+    }
+
 private:
     ulong _repeats;
     ulong _warmup;
@@ -67,9 +67,15 @@ using time_t    = uint32_t;
 
 enum {
     INODE_DIR_COUNT     = 3,
+    INODE_INLINE_SIZE   = 96,
     MAX_BLOCK_SIZE      = 4096,
 };
 
+enum {
+    // the file content is stored in the inode instead of in extents
+    INODE_INLINE        = 1,
+};
+
 constexpr inodeno_t INVALID_INO = static_cast<inodeno_t>(-1);
 
 #define M3FS_SEEK_SET 0
@@ -111,11 +117,27 @@ struct FileInfo {
     blockno_t firstblock;
 };
 
-// should be 64 bytes large
+// the record that is produced for each directory entry by READDIR_PLUS
+struct alignas(DTU_PKG_SIZE) DirEntryInfo {
+    static constexpr size_t MAX_NAME_LEN    = 28;
+
+    FileInfo info;
+    char name[MAX_NAME_LEN];
+};
+
+// should be 128 bytes large
 struct alignas(DTU_PKG_SIZE) INode {
+    // inline files store their content in the area from <direct> to the end of the inode
+    char *inline_data() {
+        return reinterpret_cast<char*>(direct);
+    }
+    const char *inline_data() const {
+        return reinterpret_cast<const char*>(direct);
+    }
+
     dev_t devno;
     uint16_t links;
-    uint8_t : 8;
+    uint8_t flags;
     inodeno_t inode;
     mode_t mode;
     uint64_t size;
@@ -125,8 +147,11 @@ struct alignas(DTU_PKG_SIZE) INode {
     Extent direct[INODE_DIR_COUNT];
     blockno_t indirect;
     blockno_t dindirect;
+    char tail[INODE_INLINE_SIZE - sizeof(Extent) * INODE_DIR_COUNT - sizeof(blockno_t) * 2];
 } PACKED;
 
+static_assert(sizeof(INode) == 128, "INode has the wrong size");
+
 struct DirEntry {
     inodeno_t nodeno;
     uint32_t namelen;
@@ -293,6 +318,10 @@ static UNUSED m3::blockno_t get_block_no_rec(const m3::INode &ino, m3::blockno_t
     return res;
 }
 
+static UNUSED bool is_inline(const m3::INode &ino) {
+    return (ino.flags & m3::INODE_INLINE) != 0;
+}
+
 static UNUSED m3::blockno_t get_block_no(const m3::INode &ino, size_t no) {
     for(size_t i = 0; i < m3::INODE_DIR_COUNT; ++i) {
         if(ino.direct[i].length > no)
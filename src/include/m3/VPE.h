@@ -74,6 +74,11 @@ public:
     enum Flags {
         MUXABLE     = KIF::VPEFlags::MUXABLE,
         PINNED      = KIF::VPEFlags::PINNED,
+        // let run() map the text of the current program read-only into the VPE instead of copying
+        // it. this requires a pager for the VPE and only affects parents without pager, because
+        // parents with pager clone their address space anyway. note that the VPE loses access to
+        // the text as soon as the current program exits.
+        SHARE_TEXT  = 1 << 8,
     };
 
     explicit VPE();
@@ -312,6 +317,21 @@ public:
         return res;
     }
 
+#if defined(__host__)
+    /**
+     * The statistics of the cache for the executables that exec() extracts from the filesystem
+     */
+    struct ExecCacheStats {
+        size_t hits;
+        size_t misses;
+    };
+
+    /**
+     * @return the statistics of the executable cache of this program
+     */
+    static const ExecCacheStats &exec_cache_stats();
+#endif
+
 private:
     void mark_caps_allocated(capsel_t sel, uint count) {
         _next_sel = Math::max(_next_sel, sel + count);
@@ -319,10 +339,12 @@ private:
 
     void init_state();
     void init_fs();
+#if defined(__host__)
+    bool pass_state(int pid);
+#endif
     Errors::Code run(void *lambda);
-    Errors::Code load_segment(ElfPh &pheader, char *buffer);
+    Errors::Code load_segment(ElfPh &pheader);
     Errors::Code load(int argc, const char **argv, uintptr_t *entry, char *buffer, size_t *size);
-    void clear_mem(char *buffer, size_t count, uintptr_t dest);
     size_t store_arguments(char *buffer, int argc, const char **argv);
 
     uintptr_t get_entry();
@@ -339,6 +361,7 @@ private:
     MountTable *_ms;
     FileTable *_fds;
     FStream *_exec;
+    uint _flags;
     static VPE _self;
 };
 
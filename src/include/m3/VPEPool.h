@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+#pragma once
+
+#include <base/util/String.h>
+#include <base/PEDesc.h>
+
+#include <m3/VPE.h>
+
+namespace m3 {
+
+/**
+ * A pool of VPEs that have been created in advance, i.e., including the VPE capability, the pager
+ * session and the default endpoints. This allows to move the VPE creation off the critical path:
+ * the pool is filled up front and acquire() hands out one of these VPEs, which is ready to run a
+ * program or function immediately.
+ *
+ * Each VPE is handed out once and owned by the caller afterwards. That is, VPEs are not recycled,
+ * because capabilities delegated to a VPE for one program should not leak into the next one.
+ * Instead, refill() can be called whenever convenient, e.g., while waiting for the programs.
+ */
+class VPEPool {
+public:
+    /**
+     * Creates a pool of <size> VPEs with the given properties.
+     *
+     * @param name the name for all VPEs
+     * @param size the number of VPEs to keep idle
+     * @param pe the desired PE type (default: same as the current PE)
+     * @param pager the pager (optional)
+     * @param flags see VPE::Flags
+     */
+    explicit VPEPool(const String &name, size_t size, const PEDesc &pe = VPE::self().pe(),
+                     const char *pager = nullptr, uint flags = 0);
+    ~VPEPool();
+
+    VPEPool(const VPEPool&) = delete;
+    VPEPool &operator=(const VPEPool&) = delete;
+
+    /**
+     * @return the number of VPEs the pool keeps idle at most
+     */
+    size_t size() const {
+        return _size;
+    }
+    /**
+     * @return the number of VPEs that are currently idle
+     */
+    size_t idle() const {
+        return _idle;
+    }
+
+    /**
+     * Takes an idle VPE out of the pool. If none is idle, a new VPE is created. The caller takes
+     * the ownership of the VPE.
+     *
+     * @return the VPE or nullptr if it could not be created (see Errors::last)
+     */
+    VPE *acquire();
+
+    /**
+     * Creates new VPEs until the pool is full again or the creation failed.
+     *
+     * @return the number of idle VPEs
+     */
+    size_t refill();
+
+private:
+    VPE *create();
+
+    String _name;
+    PEDesc _pe;
+    const char *_pager;
+    uint _flags;
+    size_t _size;
+    size_t _idle;
+    VPE **_vpes;
+};
+
+}
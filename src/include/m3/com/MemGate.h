@@ -50,6 +50,14 @@ public:
         CMD_NOPF = DTU::CmdFlags::NOPF,
     };
 
+    /**
+     * An element of a scatter/gather list
+     */
+    struct IOVec {
+        void *data;
+        size_t len;
+    };
+
     /**
      * Creates a new memory gate for global memory. That is, it requests <size> bytes of global
      * memory with given permissions.
@@ -152,7 +160,29 @@ public:
      */
     Errors::Code read(void *data, size_t len, goff_t offset);
 
+    /**
+     * Copies <len> bytes from <srcoff> in <src> to <offset> in this memory gate.
+     *
+     * @param src the memory gate to copy from
+     * @param srcoff the start-offset in <src>
+     * @param len the number of bytes to copy
+     * @param offset the start-offset in this memory gate
+     * @return the error code or Errors::NONE
+     */
+    Errors::Code copy_from(MemGate &src, goff_t srcoff, size_t len, goff_t offset);
+
+    /**
+     * Overwrites <len> bytes at <offset> with zeros.
+     *
+     * @param len the number of bytes to clear
+     * @param offset the start-offset
+     * @return the error code or Errors::NONE
+     */
+    Errors::Code zero(size_t len, goff_t offset);
+
 private:
+    static const size_t COPY_BUF_SIZE = 4096;
+
     Errors::Code forward(void *&data, size_t &len, goff_t &offset, uint flags);
 
     uint _cmdflags;
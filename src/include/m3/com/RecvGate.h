@@ -48,13 +48,15 @@ class RecvGate : public Gate {
 
     class RecvGateWorkItem : public WorkItem {
     public:
-        explicit RecvGateWorkItem(RecvGate *buf) : _buf(buf) {
+        explicit RecvGateWorkItem(RecvGate *buf, uint batch) : _buf(buf), _batch(batch) {
         }
 
+        virtual epid_t ep() const override;
         virtual void work() override;
 
     protected:
         RecvGate *_buf;
+        uint _batch;
     };
 
     explicit RecvGate(VPE &vpe, capsel_t cap, int order, uint flags)
@@ -64,12 +66,15 @@ class RecvGate : public Gate {
           _order(order),
           _free(FREE_BUF),
           _handler(),
+          _rawhandler(),
+          _handlerobj(),
           _workitem() {
     }
     explicit RecvGate(VPE &vpe, capsel_t cap, epid_t ep, void *buf, int order, int msgorder, uint flags);
 
 public:
     using msghandler_t = std::function<void(GateIStream&)>;
+    using rawhandler_t = void (*)(void *obj, GateIStream&);
 
     /**
      * @return the receive gate for system call replies
@@ -148,6 +153,8 @@ public:
               _order(r._order),
               _free(r._free),
               _handler(r._handler),
+              _rawhandler(r._rawhandler),
+              _handlerobj(r._handlerobj),
               _workitem(r._workitem) {
         r._free = 0;
         r._workitem = nullptr;
@@ -181,11 +188,37 @@ public:
     void deactivate();
 
     /**
-     * Starts to listen for received messages, i.e., creates a WorkLoop item.
+     * Starts to listen for received messages, i.e., creates a WorkLoop item. With <batch> > 1, up
+     * to <batch> messages are handled each time the WorkLoop finds messages at the endpoint. In
+     * this case, the handler must not stop or destroy the receive gate. Each start replaces the
+     * handler of the previous one.
      *
      * @param handler the handler to call for received messages
+     * @param batch the maximum number of messages to handle at once
      */
-    void start(msghandler_t handler);
+    void start(msghandler_t handler, uint batch = 1);
+
+    /**
+     * Starts to listen for received messages and calls <F> on <obj> for each of them. In contrast
+     * to the variant with msghandler_t, the handler is called through a plain function pointer to
+     * a thunk that calls <F>, instead of through a (potentially heap-allocated) std::function.
+     *
+     * @param obj the object to call the handler on
+     * @param batch the maximum number of messages to handle at once (see above)
+     */
+    template<class T, void (T::*F)(GateIStream&)>
+    void start(T *obj, uint batch = 1) {
+        start(&call_member<T, F>, obj, batch);
+    }
+
+    /**
+     * Starts to listen for received messages and calls <handler> with <obj> for each of them.
+     *
+     * @param handler the handler to call for received messages
+     * @param obj the argument for the handler
+     * @param batch the maximum number of messages to handle at once (see above)
+     */
+    void start(rawhandler_t handler, void *obj, uint batch = 1);
 
     /**
      * Stops to listen for received messages
@@ -232,6 +265,13 @@ public:
     }
 
 private:
+    template<class T, void (T::*F)(GateIStream&)>
+    static void call_member(void *obj, GateIStream &is) {
+        (static_cast<T*>(obj)->*F)(is);
+    }
+
+    void start_work(uint batch);
+
     static void *allocate(VPE &vpe, epid_t ep, size_t size);
     static void free(void *);
 
@@ -240,6 +280,8 @@ private:
     int _order;
     uint _free;
     msghandler_t _handler;
+    rawhandler_t _rawhandler;
+    void *_handlerobj;
     RecvGateWorkItem *_workitem;
     static RecvGate _syscall;
     static RecvGate _upcall;
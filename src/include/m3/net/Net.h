@@ -15,6 +15,8 @@
  * General Public License version 2 for more details.
  */
 
+#pragma once
+
 #include <base/Common.h>
 
 namespace m3 {
@@ -47,6 +47,11 @@ namespace m3 {
  * being done with reading/writing, you need to close the file descriptor to notify the other
  * end. This is also required for the part that you do not use.
  *
+ * By default, every chunk that is written into the pipe is announced to the reader by a message
+ * and the reader replies to it after consuming the chunk. In RING mode, reader and writer instead
+ * exchange their positions via a control block at the beginning of the shared memory and only send
+ * a message if the other side waits for data or space, respectively.
+ *
  * Caution: the current implementation does only support the communication between the two VPEs
  *          specified on construction.
  *
@@ -102,6 +107,30 @@ public:
         WRITE_EOF   = 1 << 1,
     };
 
+    enum Flags {
+        // exchange the positions via shared memory and send messages only to wake up the other side
+        RING        = 1 << 0,
+    };
+
+    /**
+     * The control block at the beginning of the shared memory in RING mode. The first part is only
+     * written by the writer, the second part only by the reader.
+     */
+    struct RingCtrl {
+        // the total number of bytes written
+        uint64_t wrpos;
+        // whether the writer is done
+        uint64_t wreof;
+        // the total number of bytes read
+        uint64_t rdpos;
+        // whether the reader waits for a message from the writer
+        uint64_t rdwait;
+        // whether the reader is done
+        uint64_t rdeof;
+    };
+
+    static const size_t RING_CTRL_SIZE  = 64;
+
     /**
      * Creates a pipe with VPE <rd> as the reader and <wr> as the writer, using a shared memory
      * area of <size> bytes.
@@ -110,8 +139,9 @@ public:
      * @param wr the writer of the pipe
      * @param mem the shared memory area
      * @param size the size of the shared memory area
+     * @param flags the flags (see Flags)
      */
-    explicit DirectPipe(VPE &rd, VPE &wr, MemGate &mem, size_t size);
+    explicit DirectPipe(VPE &rd, VPE &wr, MemGate &mem, size_t size, uint flags = 0);
     DirectPipe(const DirectPipe&) = delete;
     DirectPipe &operator=(const DirectPipe&) = delete;
     ~DirectPipe();
@@ -155,6 +185,7 @@ private:
     VPE &_rd;
     VPE &_wr;
     size_t _size;
+    uint _flags;
     RecvGate _rgate;
     MemGate _mem;
     SendGate _sgate;
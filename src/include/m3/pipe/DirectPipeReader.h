@@ -33,7 +33,12 @@ class DirectPipeReader : public File {
 
 public:
     struct State {
-        explicit State(capsel_t caps);
+        explicit State(capsel_t caps, size_t size = 0, uint flags = 0);
+
+        void read_data(void *buffer, MemGate *mem, goff_t memoff, size_t amount, goff_t pos);
+        void fetch_ring();
+        void publish_ring();
+        void reply_notifies();
 
         MemGate _mgate;
         RecvGate _rgate;
@@ -42,9 +47,17 @@ public:
         size_t _pkglen;
         int _eof;
         GateIStream _is;
+        // for DirectPipe::RING
+        size_t _size;
+        uint _flags;
+        uint64_t _ringrd;
+        uint64_t _ringwr;
+        bool _wreof;
+        bool _waiting;
     };
 
     explicit DirectPipeReader(capsel_t caps, State *state);
+    explicit DirectPipeReader(capsel_t caps, size_t size, uint flags, State *state);
 
 public:
     /**
@@ -65,7 +78,20 @@ public:
         return read(buffer, count, true);
     }
     // returns -1 when in non blocking mode and there is no data to read
-    ssize_t read(void *, size_t, bool blocking);
+    ssize_t read(void *buffer, size_t count, bool blocking) {
+        return do_read(buffer, nullptr, 0, count, blocking);
+    }
+    virtual ssize_t read_mem(MemGate &mem, goff_t off, size_t count) override {
+        return do_read(nullptr, &mem, off, count, true);
+    }
+
+    /**
+     * Activates the receive gate, if necessary, and returns its endpoint. The writer's messages
+     * arrive at this endpoint, so that it can be used to wait for data to become available.
+     *
+     * @return the endpoint of the receive gate
+     */
+    epid_t ep();
     virtual ssize_t write(const void *, size_t) override {
         // not supported
         return 0;
@@ -83,10 +109,14 @@ public:
     static File *unserialize(Unmarshaller &um);
 
 private:
+    ssize_t do_read(void *buffer, MemGate *mem, goff_t memoff, size_t count, bool blocking);
+    ssize_t read_ring(void *buffer, MemGate *mem, goff_t memoff, size_t count, bool blocking);
     void send_eof();
 
     bool _noeof;
     capsel_t _caps;
+    size_t _size;
+    uint _flags;
     State *_state;
 };
 
@@ -32,10 +32,18 @@ class DirectPipeWriter : public File {
 
 public:
     struct State {
-        explicit State(capsel_t caps, size_t size);
+        explicit State(capsel_t caps, size_t size, uint flags = 0);
 
         ssize_t find_spot(size_t *len);
+        void got_reply(size_t len);
+        bool fits(size_t count);
         void read_replies();
+        void write_data(const void *buffer, MemGate *mem, goff_t memoff, size_t amount, goff_t pos);
+        void publish_ring(bool eof);
+        void fetch_ring();
+        void drain_ring_replies();
+        bool wait_ring_reply();
+        void notify_ring();
 
         MemGate _mgate;
         RecvGate _rgate;
@@ -46,9 +54,16 @@ public:
         size_t _wrpos;
         int _capacity;
         int _eof;
+        // for DirectPipe::RING
+        uint _flags;
+        uint64_t _ringwr;
+        uint64_t _ringrd;
+        bool _rdwait;
+        bool _notified;
     };
 
     explicit DirectPipeWriter(capsel_t caps, size_t size, State *state);
+    explicit DirectPipeWriter(capsel_t caps, size_t size, uint flags, State *state);
 
 public:
     /**
@@ -73,7 +88,12 @@ public:
         return write(buffer, count, true);
     }
     // returns -1 when in non blocking mode and there is not enough space left in buffer
-    ssize_t write(const void *buffer, size_t count, bool blocking);
+    ssize_t write(const void *buffer, size_t count, bool blocking) {
+        return do_write(buffer, nullptr, 0, count, blocking);
+    }
+    virtual ssize_t write_mem(MemGate &mem, goff_t off, size_t count) override {
+        return do_write(nullptr, &mem, off, count, true);
+    }
 
     virtual File *clone() const override {
         return nullptr;
@@ -87,10 +107,13 @@ public:
     static File *unserialize(Unmarshaller &um);
 
 private:
+    ssize_t do_write(const void *buffer, MemGate *mem, goff_t memoff, size_t count, bool blocking);
+    ssize_t write_ring(const void *buffer, MemGate *mem, goff_t memoff, size_t count, bool blocking);
     void send_eof();
 
     capsel_t _caps;
     size_t _size;
+    uint _flags;
     State *_state;
     bool _noeof;
 };
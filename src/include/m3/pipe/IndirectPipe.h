@@ -24,7 +24,17 @@ namespace m3 {
 
 class IndirectPipe {
 public:
-    explicit IndirectPipe(MemGate &mem, size_t memsize, const char *service = "pipe", int flags = 0);
+    /**
+     * Creates a new pipe at service <service> using <mem> as the buffer.
+     *
+     * @param mem the memory to use as the buffer
+     * @param memsize the size of the buffer
+     * @param service the name of the pipe service
+     * @param flags the flags for the files (FILE_*)
+     * @param pipeflags the flags for the pipe (Pipe::Flags)
+     */
+    explicit IndirectPipe(MemGate &mem, size_t memsize, const char *service = "pipe",
+                          int flags = 0, uint pipeflags = 0);
     ~IndirectPipe();
 
     /**
@@ -25,8 +25,9 @@ namespace m3 {
 struct RemoteServer {
     explicit RemoteServer(VPE &vpe, const String &name)
         : srv(ObjCap::SERVICE, VPE::self().alloc_sels(2)),
-          rgate(RecvGate::create_for(vpe, srv.sel() + 1, nextlog2<256>::val,
-                                                             nextlog2<256>::val)) {
+          rgate(RecvGate::create_for(vpe, srv.sel() + 1,
+                nextlog2<KIF::Service::MSG_SIZE * KIF::Service::MSG_SLOTS>::val,
+                nextlog2<KIF::Service::MSG_SIZE>::val)) {
         rgate.activate();
         Syscalls::get().createsrv(srv.sel(), vpe.sel(), rgate.sel(), name);
         vpe.delegate(KIF::CapRngDesc(KIF::CapRngDesc::OBJ, srv.sel(), 2));
@@ -29,7 +29,7 @@ class RequestHandler : public Handler<SESS> {
     template<class HDL>
     friend class Server;
 
-    using handler_func = void (CLS::*)(GateIStream &is);
+    using handler_func = void (*)(CLS *obj, GateIStream &is);
 
 public:
     explicit RequestHandler()
@@ -37,16 +37,23 @@ public:
         _callbacks() {
     }
 
-    void add_operation(OP op, handler_func func) {
-        _callbacks[op] = func;
+    /**
+     * Registers <F> as the handler for <op>. The member function is bound at compile time, so that
+     * the dispatch is a single indirect call through the table.
+     *
+     * @param op the operation
+     */
+    template<void (CLS::*F)(GateIStream &is)>
+    void add_operation(OP op) {
+        _callbacks[op] = &call_operation<F>;
     }
 
     void handle_message(GateIStream &msg) {
         EVENT_TRACER_Service_request();
         OP op;
         msg >> op;
-        if(static_cast<size_t>(op) < sizeof(_callbacks) / sizeof(_callbacks[0])) {
-            (static_cast<CLS*>(this)->*_callbacks[op])(msg);
+        if(static_cast<size_t>(op) < OPCNT && _callbacks[op]) {
+            _callbacks[op](static_cast<CLS*>(this), msg);
             return;
         }
 
@@ -54,6 +61,11 @@ public:
     }
 
 private:
+    template<void (CLS::*F)(GateIStream &is)>
+    static void call_operation(CLS *obj, GateIStream &is) {
+        (obj->*F)(is);
+    }
+
     handler_func _callbacks[OPCNT];
 };
 
@@ -36,7 +36,8 @@ public:
         : ObjCap(SERVICE, VPE::self().alloc_sel()),
           _handler(handler),
           _ctrl_handler(),
-          _rgate(RecvGate::create(nextlog2<256>::val, nextlog2<256>::val)) {
+          _rgate(RecvGate::create(nextlog2<KIF::Service::MSG_SIZE * KIF::Service::MSG_SLOTS>::val,
+                                  nextlog2<KIF::Service::MSG_SIZE>::val)) {
         init();
 
         LLOG(SERV, "create(" << name << ")");
@@ -47,7 +48,8 @@ public:
         : ObjCap(SERVICE, caps + 0),
           _handler(handler),
           _ctrl_handler(),
-          _rgate(RecvGate::bind(caps + 1, nextlog2<256>::val, ep)) {
+          _rgate(RecvGate::bind(caps + 1,
+                                nextlog2<KIF::Service::MSG_SIZE * KIF::Service::MSG_SLOTS>::val, ep)) {
         init();
     }
 
@@ -62,8 +64,7 @@ public:
 
 private:
     void init() {
-        using std::placeholders::_1;
-        _rgate.start(std::bind(&Server::handle_message, this, _1));
+        _rgate.start<Server, &Server::handle_message>(this);
 
         _ctrl_handler[KIF::Service::OPEN] = &Server::handle_open;
         _ctrl_handler[KIF::Service::OBTAIN] = &Server::handle_obtain;
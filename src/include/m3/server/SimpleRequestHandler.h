@@ -37,12 +37,13 @@ struct SimpleSession : public ServerSession {
 
 template<typename CLS, typename OP, size_t OPCNT, size_t MSG_SIZE = 128>
 class SimpleRequestHandler : public RequestHandler<CLS, OP, OPCNT, SimpleSession> {
+    using reqh_type = RequestHandler<CLS, OP, OPCNT, SimpleSession>;
+
 public:
     explicit SimpleRequestHandler()
-        : RequestHandler<CLS, OP, OPCNT, SimpleSession>(),
+        : reqh_type(),
           _rgate(RecvGate::create(nextlog2<32 * MSG_SIZE>::val, nextlog2<MSG_SIZE>::val)) {
-        using std::placeholders::_1;
-        _rgate.start(std::bind(&SimpleRequestHandler::handle_message, this, _1));
+        _rgate.template start<reqh_type, &reqh_type::handle_message>(this);
     }
 
     virtual Errors::Code open(SimpleSession **sess, capsel_t srv_sel, word_t) override {
@@ -47,6 +47,8 @@ public:
         UNLINK,
         OPEN_PRIV,
         CLOSE_PRIV,
+        COPY_RANGE,
+        READDIR_PLUS,
         COUNT
     };
 
@@ -90,6 +92,8 @@ public:
     virtual Errors::Code rmdir(const char *path) override;
     virtual Errors::Code link(const char *oldpath, const char *newpath) override;
     virtual Errors::Code unlink(const char *path) override;
+    virtual Errors::Code copy_range(const char *srcpath, const char *dstpath,
+                                    size_t off, size_t *count) override;
 
     virtual Errors::Code delegate(VPE &vpe) override;
     virtual void serialize(Marshaller &m) override;
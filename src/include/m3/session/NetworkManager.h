@@ -103,7 +103,7 @@ class NetworkManager;
 
 class InetSocket {
 public:
-    explicit InetSocket(int sd, NetworkManager &nm);
+    explicit InetSocket(int sd, NetworkManager &nm, bool stream = false);
     ~InetSocket();
 
     int sd() {
@@ -113,12 +113,15 @@ public:
     Errors::Code bind(IpAddr addr, uint16_t port);
     Errors::Code listen();
     Errors::Code connect(IpAddr addr, uint16_t port);
+    // blocks until a connection has been established on this listening socket
+    InetSocket *accept();
 
     // blocks when send buffer of the socket is full
     ssize_t send(const void *buffer, size_t count, bool blocking = true);
     ssize_t sendto(const void *buffer, size_t count, IpAddr addr, uint16_t port, bool blocking = true);
 
-    // blocks when receive buffer of the socket is empty
+    // blocks when receive buffer of the socket is empty. stream sockets return 0 on EOF and might
+    // deliver received data in different chunks than it has been sent.
     ssize_t recv(void *buffer, size_t count, bool blocking = true);
     ssize_t recvmsg(void *buffer, size_t count, IpAddr *addr, uint16_t *port, bool blocking = true);
 
@@ -127,6 +130,9 @@ public:
 private:
     friend NetworkManager;
     int _sd;
+    bool _stream;
+    // the number of bytes of the current message in the receive pipe that are not read yet
+    size_t _recv_rem;
     NetworkManager &_nm;
     NetDirectPipe *_recv_pipe;
     NetDirectPipe *_send_pipe;
@@ -163,9 +169,12 @@ public:
     Errors::Code bind(int sd, IpAddr addr, uint16_t port);
     Errors::Code listen(int sd);
     Errors::Code connect(int sd, IpAddr addr, uint16_t port);
+    InetSocket *accept(int sd);
     Errors::Code close(int sd);
 
 private:
+    InetSocket *open_socket(int sd, bool stream);
+
     SendGate _metagate;
 };
 
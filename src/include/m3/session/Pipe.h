@@ -24,9 +24,23 @@ namespace m3 {
 
 class Pipe : public ClientSession {
 public:
-    explicit Pipe(const String &service, MemGate &memory, size_t memsize)
+    enum Flags {
+        // every committed write window (e.g., via File::flush) is a message, which is handed out
+        // to a single reader as a whole. note that the boundaries are not visible to the reader:
+        // a read never returns data of two messages, but a message might take multiple reads.
+        MESSAGES    = 1,
+    };
+
+    explicit Pipe(const String &service, MemGate &memory, size_t memsize, uint flags = 0)
         : ClientSession(service, memsize) {
-        delegate_obj(memory.sel());
+        if(flags) {
+            KIF::ExchangeArgs args;
+            args.count = 1;
+            args.vals[0] = flags;
+            delegate(KIF::CapRngDesc(KIF::CapRngDesc::OBJ, memory.sel()), &args);
+        }
+        else
+            delegate_obj(memory.sel());
     }
 
     GenericFile *create_channel(bool read, int flags = 0) {
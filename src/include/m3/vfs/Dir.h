@@ -18,6 +18,9 @@
 
 #include <base/Common.h>
 
+#include <base/util/String.h>
+
+#include <m3/com/MemGate.h>
 #include <m3/stream/FStream.h>
 
 namespace m3 {
@@ -26,6 +29,9 @@ namespace m3 {
  * A directory which allows to iterate over the directory entries.
  */
 class Dir {
+    // the number of entries fetched at once by readdir(Entry&, FileInfo&)
+    static constexpr size_t BATCH_SIZE  = 32;
+
 public:
     // ensure that it's a multiple of DTU_PKG_SIZE
     struct Entry {
@@ -41,8 +47,17 @@ public:
      * @param path the path of the directory
      * @param flags the desired flags (FILE_R by default)
      */
-    explicit Dir(const char *path, int flags = FILE_R) : _f(path, flags, sizeof(Entry) * 16) {
+    explicit Dir(const char *path, int flags = FILE_R)
+        : _f(path, flags, sizeof(Entry) * 16),
+          _path(path),
+          _mem(),
+          _batch(),
+          _batch_pos(),
+          _batch_count(),
+          _pos(),
+          _plus(true) {
     }
+    ~Dir();
 
     /**
      * Retrieves the file information about this directory
@@ -62,16 +77,40 @@ public:
      */
     bool readdir(Entry &e);
 
+    /**
+     * Reads the next directory entry into <e> and the information about the file it refers to
+     * into <info>. If supported by the filesystem, the entries are fetched in batches, including
+     * the file information, so that neither a request per entry nor a stat per file is required.
+     *
+     * @param e the entry to write to
+     * @param info the file information to write to
+     * @return true if an entry has been read; false indicates EOF
+     */
+    bool readdir(Entry &e, FileInfo &info);
+
     /**
      * Resets the file position to the beginning
      */
     void reset() {
         _f.seek(0, M3FS_SEEK_SET);
         _f.clear_state();
+        _batch_pos = _batch_count = 0;
+        _pos = 0;
     }
 
 private:
+    bool fetch_batch();
+
     FStream _f;
+    String _path;
+    MemGate *_mem;
+    DirEntryInfo *_batch;
+    size_t _batch_pos;
+    size_t _batch_count;
+    size_t _pos;
+    bool _plus;
 };
 
+static_assert(Dir::Entry::MAX_NAME_LEN == DirEntryInfo::MAX_NAME_LEN, "Name lengths are out of sync");
+
 }
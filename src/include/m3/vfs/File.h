@@ -27,6 +27,7 @@ namespace m3 {
 class VFS;
 class FStream;
 class FileTable;
+class MemGate;
 
 /**
  * The base-class of all files. Can't be instantiated.
@@ -189,6 +190,61 @@ public:
         return Errors::NONE;
     }
 
+    /**
+     * Reads at most <count> bytes from the file into <mem> at offset <off>. Files that hold their
+     * data in memory override this to copy between the gates instead of through a buffer.
+     *
+     * @param mem the memory to read into
+     * @param off the offset in <mem>
+     * @param count the number of bytes to read
+     * @return the number of read bytes (0 = EOF, <0 = error)
+     */
+    virtual ssize_t read_mem(MemGate &mem, goff_t off, size_t count);
+
+    /**
+     * Writes at most <count> bytes from <mem> at offset <off> into the file.
+     *
+     * @param mem the memory to write from
+     * @param off the offset in <mem>
+     * @param count the number of bytes to write
+     * @return the number of written bytes (0 = EOF, <0 = error)
+     */
+    virtual ssize_t write_mem(MemGate &mem, goff_t off, size_t count);
+
+    /**
+     * Moves at most <count> bytes from this file into <out>. If one of the files provides a memory
+     * window (e.g., files of m3fs or pipes of the pipe service), the data is transferred between
+     * the memory gates without passing through a buffer of the caller.
+     *
+     * @param out the file to write to
+     * @param count the number of bytes to move
+     * @return the number of moved bytes (0 = EOF, <0 = error)
+     */
+    virtual ssize_t splice(File &out, size_t count) {
+        return out.splice_from(*this, count);
+    }
+
+    /**
+     * The counterpart of splice: moves at most <count> bytes from <in> into this file.
+     *
+     * @param in the file to read from
+     * @param count the number of bytes to move
+     * @return the number of moved bytes (0 = EOF, <0 = error)
+     */
+    virtual ssize_t splice_from(File &in, size_t count);
+
+    /**
+     * Moves at most <count> bytes from this file into all of the <num> files in <outs>, that is,
+     * every file receives the same data. If writing to one of the files fails, the data is
+     * consumed nevertheless, because the other files might have received it already.
+     *
+     * @param outs the files to write to
+     * @param num the number of files
+     * @param count the number of bytes to move
+     * @return the number of moved bytes (0 = EOF, <0 = error)
+     */
+    virtual ssize_t tee(File *const *outs, size_t num, size_t count);
+
     /**
      * Performs a flush of the so far written data
      *
@@ -230,6 +286,8 @@ private:
         _fd = fd;
     }
 
+    static const size_t SPLICE_BUF_SIZE = 4096;
+
     int _flags;
     fd_t _fd;
 };
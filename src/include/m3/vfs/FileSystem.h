@@ -93,6 +93,19 @@ public:
      */
     virtual Errors::Code unlink(const char *path) = 0;
 
+    /**
+     * Appends up to <*count> bytes, starting at <off> in <srcpath>, to <dstpath> without
+     * transferring the data to the client.
+     *
+     * @param srcpath the file to copy from
+     * @param dstpath the file to append to
+     * @param off the offset in <srcpath>
+     * @param count the number of bytes to copy; receives the number of copied bytes
+     * @return Errors::NONE on success
+     */
+    virtual Errors::Code copy_range(const char *srcpath, const char *dstpath,
+                                    size_t off, size_t *count) = 0;
+
     /**
      * Delegates all this filesystem to the given VPE.
      *
@@ -86,6 +86,12 @@ public:
     virtual ssize_t read(void *buffer, size_t count) override;
     virtual ssize_t write(const void *buffer, size_t count) override;
 
+    virtual ssize_t read_mem(MemGate &mem, goff_t off, size_t count) override;
+    virtual ssize_t write_mem(MemGate &mem, goff_t off, size_t count) override;
+    virtual ssize_t splice(File &out, size_t count) override;
+    virtual ssize_t splice_from(File &in, size_t count) override;
+    virtual ssize_t tee(File *const *outs, size_t num, size_t count) override;
+
     virtual Errors::Code flush() override {
         return _writing ? submit() : Errors::NONE;
     }
@@ -125,6 +131,9 @@ private:
         return !(flags() & FILE_NOSESS);
     }
     void evict();
+    void set_window(GateIStream &is);
+    Errors::Code next_in();
+    Errors::Code next_out();
     Errors::Code submit();
     Errors::Code delegate_ep();
 
@@ -139,6 +148,9 @@ private:
     size_t _pos;
     size_t _len;
     bool _writing;
+    // whether the current window has been transferred within the messages (see M3FS)
+    bool _inline;
+    char *_inline_buf;
 };
 
 }
@@ -123,6 +123,19 @@ public:
      */
     static Errors::Code unlink(const char *path);
 
+    /**
+     * Appends up to <*count> bytes, starting at <off> in <srcpath>, to <dstpath>. The data is
+     * copied by the filesystem itself, i.e., it is not transferred to this VPE. Both paths need
+     * to belong to the same filesystem and <dstpath> needs to exist.
+     *
+     * @param srcpath the file to copy from
+     * @param dstpath the file to append to
+     * @param off the offset in <srcpath>
+     * @param count the number of bytes to copy; receives the number of copied bytes
+     * @return the error, if any happened
+     */
+    static Errors::Code copy_range(const char *srcpath, const char *dstpath, size_t off, size_t *count);
+
     /**
      * Prints the current mounts to <os>.
      *
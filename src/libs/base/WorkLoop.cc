@@ -60,8 +60,12 @@ void WorkLoop::remove(WorkItem *item) {
 }
 
 void WorkLoop::tick() {
-    for(size_t i = 0; i < _count; ++i)
-        _items[i]->work();
+    uint64_t ready = DTU::get().ready_mask();
+    for(size_t i = 0; i < _count; ++i) {
+        epid_t ep = _items[i]->ep();
+        if(ep >= EP_COUNT || (ready & (static_cast<uint64_t>(1) << ep)))
+            _items[i]->work();
+    }
 }
 
 void WorkLoop::run() {
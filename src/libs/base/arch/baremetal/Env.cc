@@ -17,6 +17,7 @@
 #include <base/stream/OStream.h>
 #include <base/stream/Serial.h>
 #include <base/tracing/Tracing.h>
+#include <base/util/LatencyTable.h>
 #include <base/Env.h>
 #include <base/DTU.h>
 #include <functional>
@@ -85,6 +86,7 @@ void Env::run() {
 }
 
 USED void Env::exit(int code) {
+    LatencyTable::get().dump();
     pre_exit();
     __cxa_finalize(nullptr);
     backend()->exit(code);
@@ -14,6 +14,7 @@
  * General Public License version 2 for more details.
  */
 
+#include <base/util/LatencyTable.h>
 #include <base/util/Time.h>
 #include <base/DTU.h>
 
@@ -39,12 +40,17 @@ static inline cycles_t gem5_debug(unsigned msg) {
 namespace m3 {
 
 cycles_t Time::start(unsigned msg) {
+    cycles_t *lat = LatencyTable::get().prepare_start(msg);
     CPU::compiler_barrier();
-    return gem5_debug(START_TSC | msg);
+    cycles_t res = gem5_debug(START_TSC | msg);
+    if(lat)
+        *lat = res;
+    return res;
 }
 
 cycles_t Time::stop(unsigned msg) {
     cycles_t res = gem5_debug(STOP_TSC | msg);
+    LatencyTable::get().stop(msg, res);
     CPU::compiler_barrier();
     return res;
 }
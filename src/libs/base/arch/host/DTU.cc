@@ -17,6 +17,7 @@
 #include <base/arch/host/HWInterrupts.h>
 #include <base/arch/host/DTUBackend.h>
 #include <base/log/Lib.h>
+#include <base/tracing/Tracing.h>
 #include <base/util/Math.h>
 #include <base/DTU.h>
 #include <base/Env.h>
@@ -39,6 +40,7 @@ DTU::DTU()
     : _run(true),
       _cmdregs(),
       _epregs(),
+      _ready(),
       _tid() {
 }
 
@@ -64,6 +66,7 @@ void DTU::reset() {
     for(epid_t i = 0; i < EP_COUNT; ++i) {
         if(get_ep(i, EP_BUF_ADDR) == 0)
             memset(ep_regs() + i * EPS_RCNT, 0, EPS_RCNT * sizeof(word_t));
+        set_ready(i, get_ep(i, EP_BUF_MSGCNT) > 0);
     }
 
     delete _backend;
@@ -71,10 +74,13 @@ void DTU::reset() {
 
 void DTU::try_sleep(bool, uint64_t) const {
     // check if there are unread messages. if there are, we don't want to wait but need to
-    // handle the messages first
-    for(epid_t i = 0; i < EP_COUNT; ++i) {
-        if(get_ep(i, EP_BUF_MSGCNT) > 0)
+    // handle the messages first. it suffices to look at the endpoints that are marked ready.
+    uint64_t ready = _ready;
+    while(ready) {
+        epid_t ep = static_cast<epid_t>(__builtin_ctzll(ready));
+        if(get_ep(ep, EP_BUF_MSGCNT) > 0)
             return;
+        ready &= ready - 1;
     }
 
     _backend->wait(DTUBackend::Event::MSG);
@@ -87,15 +93,17 @@ void DTU::configure_recv(epid_t ep, uintptr_t buf, uint order, uint msgorder) {
     set_ep(ep, EP_BUF_ROFF, 0);
     set_ep(ep, EP_BUF_WOFF, 0);
     set_ep(ep, EP_BUF_MSGCNT, 0);
+    set_ready(ep, false);
     set_ep(ep, EP_BUF_UNREAD, 0);
     set_ep(ep, EP_BUF_OCCUPIED, 0);
     assert((1UL << (order - msgorder)) <= sizeof(word_t) * 8);
 }
 
 word_t DTU::check_cmd(epid_t ep, int op, word_t label, word_t credits, size_t offset, size_t length) {
-    if(op == READ || op == WRITE) {
+    if(op == READ || op == WRITE || op == COPY) {
         uint perms = label & KIF::Perm::RWX;
-        if(!(perms & (1U << (op - 1)))) {
+        uint needed = static_cast<uint>(op == READ ? KIF::Perm::R : KIF::Perm::W);
+        if(!(perms & needed)) {
             LLOG(DTUERR, "DMA-error: operation not permitted on ep " << ep << " (perms="
                     << perms << ", op=" << op << ")");
             return CTRL_ERROR;
@@ -198,6 +206,38 @@ word_t DTU::prepare_write(epid_t ep, peid_t &dstpe, epid_t &dstep) {
     return 0;
 }
 
+word_t DTU::prepare_copy(epid_t ep, peid_t &dstpe, epid_t &dstep) {
+    const epid_t srcep = get_cmd(CMD_SIZE);
+    const size_t srcoff = get_cmd(CMD_ADDR);
+    const size_t length = get_cmd(CMD_LENGTH);
+    if(srcep >= EP_COUNT) {
+        LLOG(DTUERR, "DMA-error: invalid source ep-id (" << srcep << ")");
+        return CTRL_ERROR;
+    }
+
+    word_t res = check_cmd(srcep, READ, get_ep(srcep, EP_LABEL), get_ep(srcep, EP_CREDITS),
+        srcoff, length);
+    if(res != 0)
+        return res;
+
+    dstpe = get_ep(ep, EP_PEID);
+    dstep = get_ep(ep, EP_EPID);
+    if(get_ep(srcep, EP_PEID) != dstpe) {
+        LLOG(DTUERR, "DMA-error: copy between different PEs (" << get_ep(srcep, EP_PEID)
+            << " and " << dstpe << ")");
+        return CTRL_ERROR;
+    }
+
+    _buf.credits = 0;
+    _buf.label = get_ep(ep, EP_LABEL);
+    _buf.length = sizeof(word_t) * 4;
+    reinterpret_cast<word_t*>(_buf.data)[0] = get_cmd(CMD_OFFSET);
+    reinterpret_cast<word_t*>(_buf.data)[1] = length;
+    reinterpret_cast<word_t*>(_buf.data)[2] = get_ep(srcep, EP_LABEL);
+    reinterpret_cast<word_t*>(_buf.data)[3] = srcoff;
+    return 0;
+}
+
 word_t DTU::prepare_ackmsg(epid_t ep) {
     const word_t addr = get_cmd(CMD_OFFSET);
     size_t bufaddr = get_ep(ep, EP_BUF_ADDR);
@@ -256,6 +296,8 @@ found:
     set_ep(ep, EP_BUF_UNREAD, unread);
     set_ep(ep, EP_BUF_ROFF, roff);
     set_ep(ep, EP_BUF_MSGCNT, msgs);
+    if(msgs == 0)
+        set_ready(ep, false);
 
     size_t addr = get_ep(ep, EP_BUF_ADDR);
     set_cmd(CMD_OFFSET, addr + i * (1UL << msgord));
@@ -300,6 +342,12 @@ void DTU::handle_command(peid_t pe) {
         case WRITE:
             newctrl |= prepare_write(ep, dstpe, dstep);
             break;
+        case COPY:
+            newctrl |= prepare_copy(ep, dstpe, dstep);
+            // we report the completion of the copy later
+            if(~newctrl & CTRL_ERROR)
+                newctrl |= (ctrl & ~CTRL_START);
+            break;
         case FETCHMSG:
             newctrl |= prepare_fetchmsg(ep);
             set_cmd(CMD_CTRL, newctrl);
@@ -314,9 +362,10 @@ void DTU::handle_command(peid_t pe) {
 
     // prepare message (add length and label)
     _buf.opcode = op;
+    // always tell the receiver who we are (for tracing)
+    _buf.pe = pe;
     if(ctrl & CTRL_DEL_REPLY_CAP) {
         _buf.has_replycap = 1;
-        _buf.pe = pe;
         _buf.snd_ep = ep;
         _buf.rpl_ep = reply_ep;
         _buf.replylabel = get_cmd(CMD_REPLYLBL);
@@ -324,8 +373,26 @@ void DTU::handle_command(peid_t pe) {
     else
         _buf.has_replycap = 0;
 
+    switch(op) {
+        case READ:
+        case COPY:
+            EVENT_TRACE_MEM_READ(dstpe, get_cmd(CMD_LENGTH));
+            break;
+        case WRITE:
+            EVENT_TRACE_MEM_WRITE(dstpe, get_cmd(CMD_LENGTH));
+            break;
+        default:
+            EVENT_TRACE_MSG_SEND(dstpe, _buf.length, dstep);
+            break;
+    }
+
     send_msg(ep, dstpe, dstep, op == REPLY);
 
+    // writes are not acknowledged
+    if(op == WRITE) {
+        EVENT_TRACE_MEM_FINISH();
+    }
+
 error:
     set_cmd(CMD_CTRL, newctrl);
 }
@@ -373,6 +440,31 @@ void DTU::handle_write_cmd(epid_t) {
     memcpy(reinterpret_cast<void*>(offset), _buf.data + sizeof(word_t) * 2, length);
 }
 
+void DTU::handle_copy_cmd(epid_t ep) {
+    word_t base = _buf.label & ~static_cast<word_t>(KIF::Perm::RWX);
+    word_t offset = base + reinterpret_cast<word_t*>(_buf.data)[0];
+    word_t length = reinterpret_cast<word_t*>(_buf.data)[1];
+    word_t srcbase = reinterpret_cast<word_t*>(_buf.data)[2] & ~static_cast<word_t>(KIF::Perm::RWX);
+    word_t srcoffset = srcbase + reinterpret_cast<word_t*>(_buf.data)[3];
+    LLOG(DTU, "(copy) " << length << " bytes from #" << fmt(srcbase, "x")
+            << "+#" << fmt(srcoffset - srcbase, "x") << " to #" << fmt(base, "x")
+            << "+#" << fmt(offset - base, "x"));
+    peid_t dstpe = _buf.pe;
+    epid_t dstep = _buf.rpl_ep;
+
+    // the ranges might overlap, if both endpoints refer to the same memory
+    memmove(reinterpret_cast<void*>(offset), reinterpret_cast<void*>(srcoffset), length);
+
+    _buf.opcode = RESP;
+    _buf.credits = 0;
+    _buf.label = 0;
+    _buf.length = sizeof(word_t) * 3;
+    reinterpret_cast<word_t*>(_buf.data)[0] = 0;
+    reinterpret_cast<word_t*>(_buf.data)[1] = 0;
+    reinterpret_cast<word_t*>(_buf.data)[2] = 0;
+    send_msg(ep, dstpe, dstep, true);
+}
+
 void DTU::handle_resp_cmd() {
     word_t base = _buf.label & ~static_cast<word_t>(KIF::Perm::RWX);
     word_t offset = base + reinterpret_cast<word_t*>(_buf.data)[0];
@@ -381,7 +473,10 @@ void DTU::handle_resp_cmd() {
     LLOG(DTU, "(resp) " << length << " bytes to #" << fmt(base, "x")
             << "+#" << fmt(offset - base, "x") << " -> " << resp);
     assert(length <= sizeof(_buf.data));
-    memcpy(reinterpret_cast<void*>(offset), _buf.data + sizeof(word_t) * 3, length);
+    // copies don't transfer data back
+    if(length > 0)
+        memcpy(reinterpret_cast<void*>(offset), _buf.data + sizeof(word_t) * 3, length);
+    EVENT_TRACE_MEM_FINISH();
     /* provide feedback to SW */
     set_cmd(CMD_CTRL, resp);
     _backend->notify(DTUBackend::Event::RESP);
@@ -431,6 +526,7 @@ found:
     set_ep(ep, EP_BUF_UNREAD, unread);
     set_ep(ep, EP_BUF_MSGCNT, msgs);
     set_ep(ep, EP_BUF_WOFF, woff);
+    set_ready(ep, true);
 
     size_t addr = get_ep(ep, EP_BUF_ADDR);
     memcpy(reinterpret_cast<void*>(addr + i * (1UL << msgord)), &_buf, len);
@@ -454,8 +550,12 @@ void DTU::handle_receive(epid_t ep) {
         case WRITE:
             handle_write_cmd(ep);
             break;
+        case COPY:
+            handle_copy_cmd(ep);
+            break;
         case SEND:
         case REPLY:
+            EVENT_TRACE_MSG_RECV(_buf.pe, _buf.length, ep);
             handle_msg(static_cast<size_t>(res), ep);
             break;
     }
@@ -15,6 +15,8 @@
  */
 
 #include <base/log/Lib.h>
+#include <base/tracing/Tracing.h>
+#include <base/util/LatencyTable.h>
 #include <base/Backtrace.h>
 #include <base/Env.h>
 #include <base/DTU.h>
@@ -54,8 +56,11 @@ static void init_syscall() {
 }
 
 static void on_exit_func(int status, void *) {
+    LatencyTable::get().dump();
     Syscalls::get().exit(status);
     stop_dtu();
+    // now that the DTU thread is gone, nobody records events anymore
+    EVENT_TRACE_FINISH();
 }
 
 static void load_params(Env *e) {
@@ -110,6 +115,9 @@ Env::Init::Init() {
     init_env();
 
     Serial::init(executable(), env()->pe);
+
+    if(getenv("M3_LATENCIES"))
+        LatencyTable::get().enable();
 }
 
 Env::Init::~Init() {
@@ -134,6 +142,8 @@ void Env::reset() {
 
     // we have to call init for this VPE in case we hadn't done that yet
     init_syscall();
+
+    EVENT_TRACE_REINIT();
 }
 
 Env::Env(EnvBackend *backend, int logfd)
@@ -14,17 +14,15 @@
  * General Public License version 2 for more details.
  */
 
+#include <base/tracing/Tracing.h>
+#include <base/util/LatencyTable.h>
 #include <base/util/Time.h>
 
 #include <sys/time.h>
 
 namespace m3 {
 
-cycles_t Time::start(unsigned u) {
-    return stop(u);
-}
-
-cycles_t Time::stop(unsigned) {
+static cycles_t read_counter() {
 #if defined(__i386__) or defined(__x86_64__)
     uint32_t u, l;
     asm volatile ("rdtsc" : "=a" (l), "=d" (u) : : "memory");
@@ -39,4 +37,22 @@ cycles_t Time::stop(unsigned) {
 #endif
 }
 
+// record the events outside of the measured time
+
+cycles_t Time::start(unsigned id) {
+    EVENT_TRACE_TIME_START(id);
+    cycles_t *lat = LatencyTable::get().prepare_start(id);
+    cycles_t res = read_counter();
+    if(lat)
+        *lat = res;
+    return res;
+}
+
+cycles_t Time::stop(unsigned id) {
+    cycles_t res = read_counter();
+    LatencyTable::get().stop(id, res);
+    EVENT_TRACE_TIME_STOP(id);
+    return res;
+}
+
 }
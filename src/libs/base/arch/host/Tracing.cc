@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+
+#include <base/tracing/Tracing.h>
+
+#if defined(TRACE_ENABLED)
+
+#include <base/Env.h>
+#include <base/Init.h>
+
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace m3 {
+
+INIT_PRIO_USER(3) Tracing Tracing::_inst;
+
+static uint64_t timestamp() {
+#if defined(__i386__) or defined(__x86_64__)
+    return __builtin_ia32_rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + static_cast<uint64_t>(ts.tv_nsec);
+#endif
+}
+
+static void write_all(int fd, const char *buf, size_t len) {
+    while(len > 0) {
+        ssize_t res = write(fd, buf, len);
+        if(res <= 0)
+            return;
+        buf += res;
+        len -= static_cast<size_t>(res);
+    }
+}
+
+Tracing::Tracing()
+    : _ring(),
+      _name() {
+    attach();
+}
+
+void Tracing::finish() {
+    // if we have been forked without reinit, the ring belongs to our parent
+    if(_ring && _ring->pid == static_cast<uint32_t>(getpid())) {
+        dump(_ring);
+        detach(true);
+    }
+}
+
+void Tracing::attach() {
+    snprintf(_name, sizeof(_name), "%s" TRACE_RING_NAME "%d",
+             env()->shm_prefix().c_str(), getpid());
+
+    // tracing is best effort; if we can't create the ring, we just don't record anything
+    int fd = shm_open(_name, O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if(fd == -1)
+        return;
+    if(ftruncate(fd, sizeof(TraceRing)) == -1) {
+        close(fd);
+        shm_unlink(_name);
+        return;
+    }
+
+    void *addr = mmap(nullptr, sizeof(TraceRing), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if(addr == MAP_FAILED) {
+        shm_unlink(_name);
+        return;
+    }
+
+    _ring = static_cast<TraceRing*>(addr);
+    _ring->pe = static_cast<uint32_t>(env()->pe);
+    _ring->pid = static_cast<uint32_t>(getpid());
+    strncpy(_ring->name, Env::executable(), sizeof(_ring->name) - 1);
+}
+
+void Tracing::detach(bool remove) {
+    munmap(_ring, sizeof(TraceRing));
+    if(remove)
+        shm_unlink(_name);
+    _ring = nullptr;
+}
+
+void Tracing::reinit() {
+    // the ring we inherited from our parent stays with the parent
+    if(_ring)
+        detach(false);
+    attach();
+}
+
+void Tracing::init_kernel() {
+    int fd = open(TRACE_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd != -1)
+        close(fd);
+}
+
+void Tracing::trace_dump() {
+    // the shared memory objects are in /dev/shm, without the leading slash
+    char prefix[64];
+    snprintf(prefix, sizeof(prefix), "%s" TRACE_RING_NAME, env()->shm_prefix().c_str() + 1);
+    size_t prefixlen = strlen(prefix);
+
+    DIR *dir = opendir("/dev/shm");
+    if(!dir)
+        return;
+
+    struct dirent *e;
+    while((e = readdir(dir))) {
+        if(strncmp(e->d_name, prefix, prefixlen) != 0)
+            continue;
+
+        char name[128];
+        snprintf(name, sizeof(name), "/%s", e->d_name);
+        // our own ring is dumped at exit
+        if(strcmp(name, _name) == 0)
+            continue;
+
+        int fd = shm_open(name, O_RDONLY, 0);
+        if(fd == -1)
+            continue;
+        void *addr = mmap(nullptr, sizeof(TraceRing), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+
+        if(addr != MAP_FAILED) {
+            dump(static_cast<const TraceRing*>(addr));
+            munmap(addr, sizeof(TraceRing));
+        }
+        shm_unlink(name);
+    }
+    closedir(dir);
+}
+
+void Tracing::record(uint32_t type, peid_t remote, size_t size, uint32_t payload) {
+    if(!_ring)
+        return;
+
+    // claim a slot; this allows the DTU thread to record events concurrently
+    uint64_t idx = __atomic_fetch_add(&_ring->pos, 1, __ATOMIC_RELAXED);
+    TraceEvent *ev = _ring->events + idx % TRACE_RING_SIZE;
+    ev->timestamp = timestamp();
+    ev->type = type;
+    ev->remote = static_cast<uint32_t>(remote);
+    ev->size = static_cast<uint32_t>(size);
+    ev->payload = payload;
+}
+
+void Tracing::dump(const TraceRing *ring) {
+    int fd = open(TRACE_FILE, O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if(fd == -1)
+        return;
+
+    // other processes might dump their ring at the same time
+    flock(fd, LOCK_EX);
+
+    char buf[4096];
+    size_t pos = static_cast<size_t>(snprintf(buf, sizeof(buf), "h %u %u %s\n",
+                                              ring->pe, ring->pid, ring->name));
+
+    uint64_t end = __atomic_load_n(&ring->pos, __ATOMIC_ACQUIRE);
+    uint64_t start = end > TRACE_RING_SIZE ? end - TRACE_RING_SIZE : 0;
+    for(uint64_t i = start; i < end; ++i) {
+        if(sizeof(buf) - pos < 64) {
+            write_all(fd, buf, pos);
+            pos = 0;
+        }
+
+        const TraceEvent *ev = ring->events + i % TRACE_RING_SIZE;
+        pos += static_cast<size_t>(snprintf(buf + pos, sizeof(buf) - pos, "%" PRIx64 " %u %u %u %x\n",
+                                            ev->timestamp, ev->type, ev->remote, ev->size,
+                                            ev->payload));
+    }
+    write_all(fd, buf, pos);
+
+    flock(fd, LOCK_UN);
+    close(fd);
+}
+
+}
+
+#endif
@@ -14,16 +14,13 @@
  * General Public License version 2 for more details.
  */
 
+#include <base/util/LatencyTable.h>
 #include <base/util/Time.h>
 #include <base/CPU.h>
 
 namespace m3 {
 
-cycles_t Time::start(UNUSED unsigned id) {
-    return stop(id);
-}
-
-cycles_t Time::stop(UNUSED unsigned id) {
+static cycles_t read_counter() {
     cycles_t cycles = 0;
 
     DTU::get().set_target(SLOT_NO, CCOUNT_CORE, CCOUNT_ADDR);
@@ -36,4 +33,18 @@ cycles_t Time::stop(UNUSED unsigned id) {
     return cycles;
 }
 
+cycles_t Time::start(unsigned id) {
+    cycles_t *lat = LatencyTable::get().prepare_start(id);
+    cycles_t res = read_counter();
+    if(lat)
+        *lat = res;
+    return res;
+}
+
+cycles_t Time::stop(unsigned id) {
+    cycles_t res = read_counter();
+    LatencyTable::get().stop(id, res);
+    return res;
+}
+
 }
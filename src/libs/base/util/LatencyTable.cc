@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+
+#include <base/stream/Serial.h>
+#include <base/util/LatencyTable.h>
+
+namespace m3 {
+
+LatencyTable LatencyTable::_inst;
+
+void LatencyTable::reset() {
+    for(size_t i = 0; i < MAX_IDS; ++i)
+        _entries[i] = Entry();
+}
+
+void LatencyTable::print(OStream &os) const {
+    for(size_t i = 0; i < MAX_IDS; ++i) {
+        const Entry *e = _entries + i;
+        if(e->id == 0 || e->hist.count() == 0)
+            continue;
+
+        os << "Latency of " << fmt(e->id, "#x") << ": " << e->hist << "\n";
+        os << "  buckets:";
+        for(size_t b = 0; b < Histogram::BUCKETS; ++b) {
+            if(e->hist.bucket_count(b))
+                os << " 2^" << b << "=" << e->hist.bucket_count(b);
+        }
+        os << "\n";
+    }
+}
+
+void LatencyTable::dump() const {
+    if(_enabled)
+        print(Serial::get());
+}
+
+}
@@ -49,7 +49,8 @@ VPE::VPE()
       _rbufend(),
       _ms(),
       _fds(),
-      _exec() {
+      _exec(),
+      _flags() {
     static_assert(EP_COUNT <= 64, "64 endpoints are the maximum due to the 64-bit bitmask");
     init_state();
     init_fs();
@@ -79,7 +80,8 @@ VPE::VPE(const String &name, const PEDesc &pe, const char *pager, uint flags, co
       _rbufend(),
       _ms(new MountTable()),
       _fds(new FileTable()),
-      _exec() {
+      _exec(),
+      _flags(flags) {
     // create pager first, to create session and obtain gate cap
     if(_pe.has_virtmem()) {
         if(pager)
@@ -90,6 +92,8 @@ VPE::VPE(const String &name, const PEDesc &pe, const char *pager, uint flags, co
             return;
     }
 
+    // SHARE_TEXT is handled by us
+    flags &= ~static_cast<uint>(SHARE_TEXT);
     capsel_t group_sel = group ? group->sel() : ObjCap::INVALID;
     KIF::CapRngDesc dst(KIF::CapRngDesc::OBJ, sel(), 2 + EP_COUNT - DTU::FIRST_FREE_EP);
     if(_pager) {
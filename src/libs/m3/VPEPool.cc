@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2018, Nils Asmussen <nils@os.inf.tu-dresden.de>
+ * Economic rights: Technische Universitaet Dresden (Germany)
+ *
+ * This file is part of M3 (Microkernel-based SysteM for Heterogeneous Manycores).
+ *
+ * M3 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * M3 is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details.
+ */
+
+#include <m3/VPEPool.h>
+
+namespace m3 {
+
+VPEPool::VPEPool(const String &name, size_t size, const PEDesc &pe, const char *pager, uint flags)
+    : _name(name),
+      _pe(pe),
+      _pager(pager),
+      _flags(flags),
+      _size(size),
+      _idle(),
+      _vpes(new VPE*[size]) {
+    refill();
+}
+
+VPEPool::~VPEPool() {
+    while(_idle > 0)
+        delete _vpes[--_idle];
+    delete[] _vpes;
+}
+
+VPE *VPEPool::create() {
+    // the VPE constructor only sets Errors::last on failure
+    Errors::last = Errors::NONE;
+    VPE *vpe = new VPE(_name, _pe, _pager, _flags);
+    if(Errors::last != Errors::NONE) {
+        delete vpe;
+        return nullptr;
+    }
+    return vpe;
+}
+
+VPE *VPEPool::acquire() {
+    if(_idle > 0)
+        return _vpes[--_idle];
+    return create();
+}
+
+size_t VPEPool::refill() {
+    while(_idle < _size) {
+        VPE *vpe = create();
+        if(!vpe)
+            break;
+        _vpes[_idle++] = vpe;
+    }
+    return _idle;
+}
+
+}
@@ -176,17 +176,7 @@ Errors::Code VPE::exec(int argc, const char **argv) {
     return start();
 }
 
-void VPE::clear_mem(char *buffer, size_t count, uintptr_t dest) {
-    memset(buffer, 0, BUF_SIZE);
-    while(count > 0) {
-        size_t amount = std::min(count, BUF_SIZE);
-        _mem.write(buffer, Math::round_up(amount, DTU_PKG_SIZE), dest);
-        count -= amount;
-        dest += amount;
-    }
-}
-
-Errors::Code VPE::load_segment(ElfPh &pheader, char *buffer) {
+Errors::Code VPE::load_segment(ElfPh &pheader) {
     if(_pager) {
         int prot = 0;
         if(pheader.p_flags & PF_R)
@@ -212,20 +202,20 @@ Errors::Code VPE::load_segment(ElfPh &pheader, char *buffer) {
     if(_exec->seek(off, M3FS_SEEK_SET) != off)
         return Errors::INVALID_ELF;
 
+    // let the file copy the data directly into the PE's memory
     size_t count = pheader.p_filesz;
     size_t segoff = pheader.p_vaddr;
     while(count > 0) {
-        size_t amount = std::min(count, BUF_SIZE);
-        if(_exec->read(buffer, amount) != amount)
-            return Errors::last;
+        ssize_t res = _exec->file()->read_mem(_mem, segoff, count);
+        if(res <= 0)
+            return res == 0 ? Errors::INVALID_ELF : Errors::last;
 
-        _mem.write(buffer, Math::round_up(amount, DTU_PKG_SIZE), segoff);
-        count -= amount;
-        segoff += amount;
+        count -= static_cast<size_t>(res);
+        segoff += static_cast<size_t>(res);
     }
 
     /* zero the rest */
-    clear_mem(buffer, pheader.p_memsz - pheader.p_filesz, segoff);
+    _mem.zero(Math::round_up(pheader.p_memsz - pheader.p_filesz, DTU_PKG_SIZE), segoff);
     return Errors::NONE;
 }
 
@@ -254,7 +244,7 @@ Errors::Code VPE::load(int argc, const char **argv, uintptr_t *entry, char *buff
         if(pheader.p_type != PT_LOAD || pheader.p_memsz == 0 || skip_section(&pheader))
             continue;
 
-        load_segment(pheader, buffer);
+        load_segment(pheader);
         end = pheader.p_vaddr + pheader.p_memsz;
     }
 
@@ -45,10 +45,26 @@ Errors::Code VPE::copy_sections() {
         Errors::Code err;
 
         // map text
-        start_addr = Math::round_dn(reinterpret_cast<uintptr_t>(&_text_start), DTU_PKG_SIZE);
-        end_addr = Math::round_up(reinterpret_cast<uintptr_t>(&_text_end), DTU_PKG_SIZE);
-        err = _pager->map_anon(&start_addr, end_addr - start_addr,
-                               Pager::READ | Pager::WRITE | Pager::EXEC, 0);
+        if(_flags & SHARE_TEXT) {
+            // the text is page aligned and followed by the page aligned data section
+            start_addr = reinterpret_cast<uintptr_t>(&_text_start);
+            end_addr = Math::round_up(reinterpret_cast<uintptr_t>(&_text_end),
+                                      static_cast<uintptr_t>(PAGE_SIZE));
+            // keep the capability until we exit to be able to share it with all our children
+            static MemGate *text = nullptr;
+            if(!text) {
+                text = new MemGate(VPE::self().mem().derive(start_addr, end_addr - start_addr,
+                                                            MemGate::R | MemGate::X));
+            }
+            err = _pager->map_mem(&start_addr, *text, end_addr - start_addr,
+                                  Pager::READ | Pager::EXEC);
+        }
+        else {
+            start_addr = Math::round_dn(reinterpret_cast<uintptr_t>(&_text_start), DTU_PKG_SIZE);
+            end_addr = Math::round_up(reinterpret_cast<uintptr_t>(&_text_end), DTU_PKG_SIZE);
+            err = _pager->map_anon(&start_addr, end_addr - start_addr,
+                                   Pager::READ | Pager::WRITE | Pager::EXEC, 0);
+        }
         if(err != Errors::NONE)
             return err;
 
@@ -67,9 +83,11 @@ Errors::Code VPE::copy_sections() {
     }
 
     /* copy text */
-    start_addr = Math::round_dn(reinterpret_cast<uintptr_t>(&_text_start), DTU_PKG_SIZE);
-    end_addr = Math::round_up(reinterpret_cast<uintptr_t>(&_text_end), DTU_PKG_SIZE);
-    _mem.write(reinterpret_cast<void*>(start_addr), end_addr - start_addr, start_addr);
+    if(!_pager || !(_flags & SHARE_TEXT)) {
+        start_addr = Math::round_dn(reinterpret_cast<uintptr_t>(&_text_start), DTU_PKG_SIZE);
+        end_addr = Math::round_up(reinterpret_cast<uintptr_t>(&_text_end), DTU_PKG_SIZE);
+        _mem.write(reinterpret_cast<void*>(start_addr), end_addr - start_addr, start_addr);
+    }
 
     /* copy data and heap */
     start_addr = Math::round_dn(reinterpret_cast<uintptr_t>(&_data_start), DTU_PKG_SIZE);
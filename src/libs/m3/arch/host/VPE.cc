@@ -27,6 +27,8 @@
 
 #include <sys/fcntl.h>
 #include <sys/stat.h>
+#include <errno.h>
+#include <signal.h>
 #include <stdlib.h>
 #include <unistd.h>
 
@@ -34,37 +36,97 @@ namespace m3 {
 
 // this should be enough for now
 static const size_t STATE_BUF_SIZE    = 4096;
+static const size_t EXEC_BUF_SIZE     = 64 * 1024;
 
-static void write_file(pid_t pid, const char *suffix, const void *data, size_t size) {
-    if(data) {
-        char path[64];
-        snprintf(path, sizeof(path), "/tmp/m3/%d-%s", pid, suffix);
-        int fd = open(path, O_WRONLY | O_TRUNC | O_CREAT, 0600);
-        if(fd < 0)
-            perror("open");
-        else {
-            write(fd, data, size);
-            close(fd);
-        }
+static VPE::ExecCacheStats exec_stats;
+
+static bool state_path(char *path, size_t size, pid_t pid, const char *suffix) {
+    int len = snprintf(path, size, "/tmp/m3/%d-%s", pid, suffix);
+    return len >= 0 && static_cast<size_t>(len) < size;
+}
+
+static bool write_all(int fd, const void *data, size_t size) {
+    const char *bytes = static_cast<const char*>(data);
+    while(size > 0) {
+        ssize_t res = write(fd, bytes, size);
+        if(res == -1 && errno == EINTR)
+            continue;
+        if(res <= 0)
+            return false;
+        bytes += res;
+        size -= static_cast<size_t>(res);
+    }
+    return true;
+}
+
+static bool read_all(int fd, void *data, size_t size) {
+    char *bytes = static_cast<char*>(data);
+    while(size > 0) {
+        ssize_t res = read(fd, bytes, size);
+        if(res == -1 && errno == EINTR)
+            continue;
+        if(res <= 0)
+            return false;
+        bytes += res;
+        size -= static_cast<size_t>(res);
+    }
+    return true;
+}
+
+static bool write_file(pid_t pid, const char *suffix, const void *data, size_t size) {
+    char path[64];
+    if(!state_path(path, sizeof(path), pid, suffix))
+        return false;
+
+    int fd = open(path, O_WRONLY | O_TRUNC | O_CREAT, 0600);
+    if(fd < 0) {
+        perror("open");
+        return false;
     }
+
+    bool res = write_all(fd, data, size);
+    if(!res)
+        perror("write");
+    close(fd);
+    // don't let the child see a partially written state
+    if(!res)
+        unlink(path);
+    return res;
 }
 
 static void *read_from(const char *suffix, void *dst, size_t &size) {
     char path[64];
-    snprintf(path, sizeof(path), "/tmp/m3/%d-%s", getpid(), suffix);
+    if(!state_path(path, sizeof(path), getpid(), suffix))
+        return nullptr;
+
     int fd = open(path, O_RDONLY);
     if(fd >= 0) {
+        bool alloced = false;
         if(dst == nullptr) {
             struct stat st;
-            if(fstat(fd, &st) == -1)
+            if(fstat(fd, &st) == -1) {
+                close(fd);
                 return nullptr;
+            }
             size = static_cast<size_t>(st.st_size);
             dst = Heap::alloc(size);
+            alloced = true;
+        }
+        else {
+            // the file is at most as large as the buffer
+            struct stat st;
+            if(fstat(fd, &st) == 0)
+                size = Math::min(size, static_cast<size_t>(st.st_size));
         }
 
-        read(fd, dst, size);
+        bool res = read_all(fd, dst, size);
         unlink(path);
         close(fd);
+        if(!res) {
+            if(alloced)
+                Heap::free(dst);
+            return nullptr;
+        }
         return dst;
     }
     return nullptr;
@@ -98,6 +160,77 @@ void VPE::init_fs() {
     delete[] buf;
 }
 
+static Errors::Code fetch_executable(File *bin, char *path, size_t size) {
+    // executables are cached until the kernel terminates. m3fs updates the modification time on
+    // every change, so that the file is identified by its inode, modification time and size.
+    FileInfo info;
+    Errors::Code res = bin->stat(info);
+    if(res != Errors::NONE)
+        return res;
+
+    int len = snprintf(path, size, "/tmp/m3/exec-%u-%u-%u-%zu",
+                       static_cast<uint>(info.devno), static_cast<uint>(info.inode),
+                       static_cast<uint>(info.lastmod), info.size);
+    if(len < 0 || static_cast<size_t>(len) >= size)
+        return Errors::INV_ARGS;
+    if(access(path, X_OK) == 0) {
+        exec_stats.hits++;
+        return Errors::NONE;
+    }
+
+    exec_stats.misses++;
+    char templ[] = "/tmp/m3/exectmp-XXXXXX";
+    int tmp = mkstemp(templ);
+    if(tmp < 0)
+        return Errors::OUT_OF_MEM;
+
+    // copy executable from M3-fs to a temp file
+    char *buffer = new char[EXEC_BUF_SIZE];
+    bool ok = true;
+    ssize_t count;
+    while(ok && (count = bin->read(buffer, EXEC_BUF_SIZE)) > 0)
+        ok = write_all(tmp, buffer, static_cast<size_t>(count));
+    delete[] buffer;
+
+    // it needs to be executable
+    fchmod(tmp, 0700);
+    // close writable fd to make it non-busy
+    close(tmp);
+
+    // publish it atomically to not let concurrent execs see a partially written file
+    if(!ok || count < 0 || rename(templ, path) == -1) {
+        unlink(templ);
+        return Errors::OUT_OF_MEM;
+    }
+    return Errors::NONE;
+}
+
+bool VPE::pass_state(int pid) {
+    size_t len = STATE_BUF_SIZE;
+    unsigned char *buf = new unsigned char[len];
+
+    Marshaller m(buf, len);
+    m << _next_sel << _eps;
+    bool res = write_file(pid, "other", buf, m.total());
+
+    if(res) {
+        len = _ms->serialize(buf, STATE_BUF_SIZE);
+        res = write_file(pid, "ms", buf, len);
+    }
+
+    if(res) {
+        len = _fds->serialize(buf, STATE_BUF_SIZE);
+        res = write_file(pid, "fds", buf, len);
+    }
+
+    delete[] buf;
+    return res;
+}
+
+const VPE::ExecCacheStats &VPE::exec_cache_stats() {
+    return exec_stats;
+}
+
 Errors::Code VPE::run(void *lambda) {
     char byte = 1;
     int fd[2];
@@ -134,20 +267,11 @@ Errors::Code VPE::run(void *lambda) {
         xfer_t arg = static_cast<xfer_t>(pid);
         Syscalls::get().vpectrl(sel(), KIF::Syscall::VCTRL_START, arg);
 
-        size_t len = STATE_BUF_SIZE;
-        unsigned char *buf = new unsigned char[len];
-
-        Marshaller m(buf, len);
-        m << _next_sel << _eps;
-        write_file(pid, "other", buf, m.total());
-
-        len = _ms->serialize(buf, len);
-        write_file(pid, "ms", buf, len);
-
-        len = _fds->serialize(buf, STATE_BUF_SIZE);
-        write_file(pid, "fds", buf, len);
-
-        delete[] buf;
+        if(!pass_state(pid)) {
+            kill(pid, SIGKILL);
+            close(fd[1]);
+            return Errors::OUT_OF_MEM;
+        }
 
         // notify child; it can start now
         write(fd[1], &byte, 1);
@@ -157,28 +281,21 @@ Errors::Code VPE::run(void *lambda) {
 }
 
 Errors::Code VPE::exec(int argc, const char **argv) {
-    static char buffer[1024];
-    char templ[] = "/tmp/m3-XXXXXX";
-    int tmp, pid, fd[2];
-    ssize_t res;
+    char path[64];
+    int pid, fd[2];
     char byte = 1;
     if(pipe(fd) == -1)
         return Errors::OUT_OF_MEM;
 
-    FileRef bin(argv[0], FILE_R);
-    if(Errors::occurred())
-        goto errorTemp;
-    tmp = mkstemp(templ);
-    if(tmp < 0)
-        goto errorTemp;
-
-    // copy executable from M3-fs to a temp file
-    while((res = bin->read(buffer, sizeof(buffer))) > 0)
-        write(tmp, buffer, static_cast<size_t>(res));
+    {
+        FileRef bin(argv[0], FILE_R);
+        if(Errors::occurred() || fetch_executable(bin.get(), path, sizeof(path)) != Errors::NONE)
+            goto error;
+    }
 
     pid = fork();
     if(pid == -1)
-        goto errorExec;
+        goto error;
     else if(pid == 0) {
         // child
         close(fd[1]);
@@ -193,42 +310,23 @@ Errors::Code VPE::exec(int argc, const char **argv) {
             args[i] = const_cast<char*>(argv[i]);
         args[argc] = nullptr;
 
-        // open it readonly again as fexecve requires
-        int tmpdup = open(templ, O_RDONLY);
-        // we don't need it anymore afterwards
-        unlink(templ);
-        // it needs to be executable
-        fchmod(tmpdup, 0700);
-        // close writable fd to make it non-busy
-        close(tmp);
-
         // execute that file
-        fexecve(tmpdup, args, environ);
+        execve(path, args, environ);
         PANIC("Exec of '" << argv[0] << "' failed: " << strerror(errno));
     }
     else {
         // parent
         close(fd[0]);
-        close(tmp);
 
         // let the kernel create the config-file etc. for the given pid
         xfer_t arg = static_cast<xfer_t>(pid);
         Syscalls::get().vpectrl(sel(), KIF::Syscall::VCTRL_START, arg);
 
-        size_t len = STATE_BUF_SIZE;
-        unsigned char *buf = new unsigned char[len];
-
-        Marshaller m(buf, len);
-        m << _next_sel << _eps;
-        write_file(pid, "other", buf, m.total());
-
-        len = _ms->serialize(buf, STATE_BUF_SIZE);
-        write_file(pid, "ms", buf, len);
-
-        len = _fds->serialize(buf, STATE_BUF_SIZE);
-        write_file(pid, "fds", buf, len);
-
-        delete[] buf;
+        if(!pass_state(pid)) {
+            kill(pid, SIGKILL);
+            close(fd[1]);
+            return Errors::OUT_OF_MEM;
+        }
 
         // notify child; it can start now
         write(fd[1], &byte, 1);
@@ -236,13 +334,10 @@ Errors::Code VPE::exec(int argc, const char **argv) {
     }
     return Errors::NONE;
 
-errorExec:
-    close(tmp);
-errorTemp:
+error:
     close(fd[0]);
     close(fd[1]);
     return Errors::OUT_OF_MEM;
-
 }
 
 }
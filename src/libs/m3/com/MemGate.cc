@@ -105,4 +105,63 @@ retry:
     return res;
 }
 
+Errors::Code MemGate::copy_from(MemGate &src, goff_t srcoff, size_t len, goff_t offset) {
+#if defined(__host__)
+    // if both gates refer to memory of the same PE, let its DTU copy the data in one step
+    ensure_activated();
+    src.ensure_activated();
+    if(ep() != UNBOUND && src.ep() != UNBOUND &&
+       DTU::get().get_ep(ep(), DTU::EP_PEID) == DTU::get().get_ep(src.ep(), DTU::EP_PEID)) {
+        if(DTU::get().copy(ep(), offset, src.ep(), srcoff, len) == Errors::NONE)
+            return Errors::NONE;
+    }
+#endif
+
+    // the DTU can only transfer between local and remote memory; thus, we need a bounce buffer.
+    // read and write might cause a thread switch, so that a temporary one is used if another
+    // thread is already copying.
+    alignas(64) static char copy_buf[COPY_BUF_SIZE];
+    static bool copy_buf_busy = false;
+
+    char *buffer = copy_buf;
+    if(copy_buf_busy)
+        buffer = new char[COPY_BUF_SIZE];
+    else
+        copy_buf_busy = true;
+
+    Errors::Code res = Errors::NONE;
+    while(len > 0) {
+        size_t amount = Math::min(len, COPY_BUF_SIZE);
+        if((res = src.read(buffer, amount, srcoff)) != Errors::NONE)
+            break;
+        if((res = write(buffer, amount, offset)) != Errors::NONE)
+            break;
+        len -= amount;
+        srcoff += amount;
+        offset += amount;
+    }
+
+    if(buffer == copy_buf)
+        copy_buf_busy = false;
+    else
+        delete[] buffer;
+    return res;
+}
+
+Errors::Code MemGate::zero(size_t len, goff_t offset) {
+    static char *zeros = nullptr;
+    if(!zeros)
+        zeros = new char[COPY_BUF_SIZE]();
+
+    while(len > 0) {
+        size_t amount = Math::min(len, COPY_BUF_SIZE);
+        Errors::Code res = write(zeros, amount, offset);
+        if(res != Errors::NONE)
+            return res;
+        len -= amount;
+        offset += amount;
+    }
+    return Errors::NONE;
+}
+
 }
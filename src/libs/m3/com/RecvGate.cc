@@ -59,12 +59,22 @@ INIT_PRIO_RECVBUF RecvGate RecvGate::_default (
         m3::nextlog2<DEF_RBUF_SIZE>::val, DEF_RBUF_ORDER, 0
 );
 
+epid_t RecvGate::RecvGateWorkItem::ep() const {
+    return _buf->ep() == UNBOUND ? EP_COUNT : _buf->ep();
+}
+
 void RecvGate::RecvGateWorkItem::work() {
-    DTU::Message *msg = DTU::get().fetch_msg(_buf->ep());
-    if(msg) {
+    for(uint i = 0; i < _batch; ++i) {
+        DTU::Message *msg = DTU::get().fetch_msg(_buf->ep());
+        if(!msg)
+            break;
+
         LLOG(IPC, "Received msg @ " << (void*)msg << " over ep " << _buf->ep());
         GateIStream is(*_buf, msg);
-        _buf->_handler(is);
+        if(_buf->_rawhandler)
+            _buf->_rawhandler(_buf->_handlerobj, is);
+        else
+            _buf->_handler(is);
     }
 }
 
@@ -75,6 +85,8 @@ RecvGate::RecvGate(VPE &vpe, capsel_t cap, epid_t ep, void *buf, int order, int
       _order(order),
       _free(0),
       _handler(),
+      _rawhandler(),
+      _handlerobj(),
       _workitem() {
     if(sel() != ObjCap::INVALID) {
         Errors::Code res = Syscalls::get().creatergate(sel(), order, msgorder);
@@ -163,15 +175,28 @@ void RecvGate::deactivate() {
     stop();
 }
 
-void RecvGate::start(msghandler_t handler) {
+void RecvGate::start(msghandler_t handler, uint batch) {
+    _handler = handler;
+    _rawhandler = nullptr;
+    _handlerobj = nullptr;
+    start_work(batch);
+}
+
+void RecvGate::start(rawhandler_t handler, void *obj, uint batch) {
+    _handler = nullptr;
+    _rawhandler = handler;
+    _handlerobj = obj;
+    start_work(batch);
+}
+
+void RecvGate::start_work(uint batch) {
     activate();
 
     assert(&_vpe == &VPE::self());
     assert(!_workitem);
-    _handler = handler;
 
     bool permanent = ep() < DTU::FIRST_FREE_EP;
-    _workitem = new RecvGateWorkItem(this);
+    _workitem = new RecvGateWorkItem(this, batch);
     env()->workloop()->add(_workitem, permanent);
 }
 
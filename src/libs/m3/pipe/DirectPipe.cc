@@ -21,10 +21,11 @@
 
 namespace m3 {
 
-DirectPipe::DirectPipe(VPE &rd, VPE &wr, MemGate &mem, size_t size)
+DirectPipe::DirectPipe(VPE &rd, VPE &wr, MemGate &mem, size_t size, uint flags)
     : _rd(rd),
       _wr(wr),
       _size(size),
+      _flags(flags),
       _rgate(RecvGate::create(VPE::self().alloc_sels(3), nextlog2<MSG_BUF_SIZE>::val, nextlog2<MSG_SIZE>::val)),
       _mem(mem.derive_with_sel(_rgate.sel() + 1, 0, size)),
       _sgate(SendGate::create(&_rgate, 0, CREDITS, nullptr, _rgate.sel() + 2)),
@@ -32,11 +33,18 @@ DirectPipe::DirectPipe(VPE &rd, VPE &wr, MemGate &mem, size_t size)
       _wrfd() {
     assert(Math::is_aligned(size, DTU_PKG_SIZE));
 
-    DirectPipeReader::State *rstate = &rd == &VPE::self() ? new DirectPipeReader::State(caps()) : nullptr;
-    _rdfd = VPE::self().fds()->alloc(new DirectPipeReader(caps(), rstate));
+    if(_flags & RING) {
+        assert(size > RING_CTRL_SIZE);
+        _mem.zero(RING_CTRL_SIZE, 0);
+    }
+
+    DirectPipeReader::State *rstate = &rd == &VPE::self()
+        ? new DirectPipeReader::State(caps(), _size, _flags) : nullptr;
+    _rdfd = VPE::self().fds()->alloc(new DirectPipeReader(caps(), _size, _flags, rstate));
 
-    DirectPipeWriter::State *wstate = &wr == &VPE::self() ? new DirectPipeWriter::State(caps() + 1, _size) : nullptr;
-    _wrfd = VPE::self().fds()->alloc(new DirectPipeWriter(caps() + 1, _size, wstate));
+    DirectPipeWriter::State *wstate = &wr == &VPE::self()
+        ? new DirectPipeWriter::State(caps() + 1, _size, _flags) : nullptr;
+    _wrfd = VPE::self().fds()->alloc(new DirectPipeWriter(caps() + 1, _size, _flags, wstate));
 }
 
 DirectPipe::~DirectPipe() {
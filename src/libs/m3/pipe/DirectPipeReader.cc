@@ -16,25 +16,74 @@
 
 #include <base/util/Time.h>
 
+#include <cstddef>
+
 #include <m3/pipe/DirectPipe.h>
 #include <m3/pipe/DirectPipeReader.h>
 
 namespace m3 {
 
-DirectPipeReader::State::State(capsel_t caps)
+DirectPipeReader::State::State(capsel_t caps, size_t size, uint flags)
     : _mgate(MemGate::bind(caps + 1)),
       _rgate(RecvGate::bind(caps + 0, nextlog2<DirectPipe::MSG_BUF_SIZE>::val)),
       _pos(),
       _rem(),
       _pkglen(static_cast<size_t>(-1)),
       _eof(0),
-      _is(_rgate, nullptr) {
+      _is(_rgate, nullptr),
+      _size((flags & DirectPipe::RING) ? size - DirectPipe::RING_CTRL_SIZE : size),
+      _flags(flags),
+      _ringrd(),
+      _ringwr(),
+      _wreof(),
+      _waiting() {
+}
+
+void DirectPipeReader::State::read_data(void *buffer, MemGate *mem, goff_t memoff,
+                                        size_t amount, goff_t pos) {
+    Time::start(0xaaaa);
+    if(mem)
+        mem->copy_from(_mgate, pos, amount, memoff);
+    // Skip data when no buffer is specified
+    else if(buffer)
+        _mgate.read(buffer, amount, pos);
+    Time::stop(0xaaaa);
+}
+
+void DirectPipeReader::State::fetch_ring() {
+    uint64_t wr[2];
+    _mgate.read(wr, sizeof(wr), offsetof(DirectPipe::RingCtrl, wrpos));
+    _ringwr = wr[0];
+    _wreof = wr[1] != 0;
+}
+
+void DirectPipeReader::State::publish_ring() {
+    uint64_t rd[2] = {_ringrd, _waiting};
+    _mgate.write(rd, sizeof(rd), offsetof(DirectPipe::RingCtrl, rdpos));
+}
+
+void DirectPipeReader::State::reply_notifies() {
+    // the writer expects a reply to each notification, either because it waits for space or to
+    // know that we have seen it
+    _rgate.activate();
+    DTU::Message *msg;
+    while((msg = DTU::get().fetch_msg(_rgate.ep())) != nullptr) {
+        GateIStream is(_rgate, msg);
+        DBG_PIPE("[read] replying to notify\n");
+        reply_vmsg(is, static_cast<size_t>(0));
+    }
 }
 
 DirectPipeReader::DirectPipeReader(capsel_t caps, State *state)
+    : DirectPipeReader(caps, 0, 0, state) {
+}
+
+DirectPipeReader::DirectPipeReader(capsel_t caps, size_t size, uint flags, State *state)
     : File(FILE_R),
       _noeof(),
       _caps(caps),
+      _size(size),
+      _flags(flags),
       _state(state) {
 }
 
@@ -48,8 +97,15 @@ void DirectPipeReader::send_eof() {
         return;
 
     if(!_state)
-        _state = new State(_caps);
-    if(~_state->_eof & DirectPipe::READ_EOF) {
+        _state = new State(_caps, _size, _flags);
+    if((_flags & DirectPipe::RING) && (~_state->_eof & DirectPipe::READ_EOF)) {
+        uint64_t eof = 1;
+        _state->_mgate.write(&eof, sizeof(eof), offsetof(DirectPipe::RingCtrl, rdeof));
+        // the writer might wait for a reply, which it will not get otherwise
+        _state->reply_notifies();
+        _state->_eof |= DirectPipe::READ_EOF;
+    }
+    else if(~_state->_eof & DirectPipe::READ_EOF) {
         // if we have not fetched a message yet, do so now
         if(_state->_pkglen == static_cast<size_t>(-1))
             _state->_is = receive_vmsg(_state->_rgate, _state->_pos, _state->_pkglen);
@@ -59,11 +115,60 @@ void DirectPipeReader::send_eof() {
     }
 }
 
-ssize_t DirectPipeReader::read(void *buffer, size_t count, bool blocking) {
+ssize_t DirectPipeReader::read_ring(void *buffer, MemGate *mem, goff_t memoff,
+                                    size_t count, bool blocking) {
+    while(_state->_ringrd == _state->_ringwr) {
+        _state->fetch_ring();
+        if(_state->_ringrd != _state->_ringwr)
+            break;
+        if(_state->_wreof) {
+            _state->_eof |= DirectPipe::WRITE_EOF;
+            return 0;
+        }
+        if(!blocking)
+            return -1;
+
+        // announce that we wait before we check again to not miss the notification
+        if(!_state->_waiting) {
+            _state->_waiting = true;
+            _state->publish_ring();
+            continue;
+        }
+
+        GateIStream is = receive_msg(_state->_rgate);
+        DBG_PIPE("[read] got notify\n");
+        reply_vmsg(is, static_cast<size_t>(0));
+    }
+    _state->_waiting = false;
+
+    size_t off = static_cast<size_t>(_state->_ringrd % _state->_size);
+    size_t avail = static_cast<size_t>(_state->_ringwr - _state->_ringrd);
+    size_t amount = Math::min(count, Math::min(avail, _state->_size - off));
+    DBG_PIPE("[read] read from pos=" << off << ", len=" << amount << "\n");
+    _state->read_data(buffer, mem, memoff, amount, DirectPipe::RING_CTRL_SIZE + off);
+    _state->_ringrd += amount;
+
+    // publish our position and wake up the writer, if it waits for space
+    _state->publish_ring();
+    _state->reply_notifies();
+    return static_cast<ssize_t>(amount);
+}
+
+epid_t DirectPipeReader::ep() {
+    if(!_state)
+        _state = new State(_caps, _size, _flags);
+    _state->_rgate.activate();
+    return _state->_rgate.ep();
+}
+
+ssize_t DirectPipeReader::do_read(void *buffer, MemGate *mem, goff_t memoff,
+                                  size_t count, bool blocking) {
     if(!_state)
-        _state = new State(_caps);
+        _state = new State(_caps, _size, _flags);
     if(_state->_eof)
         return 0;
+    if(_flags & DirectPipe::RING)
+        return read_ring(buffer, mem, memoff, count, blocking);
 
     if(_state->_rem == 0) {
         if(_state->_pos > 0) {
@@ -95,12 +200,7 @@ ssize_t DirectPipeReader::read(void *buffer, size_t count, bool blocking) {
     if(amount == 0)
         _state->_eof |= DirectPipe::WRITE_EOF;
     else {
-        // Skip data when no buffer is specified
-        if(buffer) {
-            Time::start(0xaaaa);
-            _state->_mgate.read(buffer, amount, _state->_pos);
-            Time::stop(0xaaaa);
-        }
+        _state->read_data(buffer, mem, memoff, amount, _state->_pos);
         _state->_pos += amount;
         _state->_rem -= amount;
     }
@@ -113,13 +213,15 @@ Errors::Code DirectPipeReader::delegate(VPE &vpe) {
 
 void DirectPipeReader::serialize(Marshaller &m) {
     // we can't share the reader between two VPEs atm anyway, so don't serialize the current state
-    m << _caps;
+    m << _caps << _size << _flags;
 }
 
 File *DirectPipeReader::unserialize(Unmarshaller &um) {
     capsel_t caps;
-    um >> caps;
-    return new DirectPipeReader(caps, nullptr);
+    size_t size;
+    uint flags;
+    um >> caps >> size >> flags;
+    return new DirectPipeReader(caps, size, flags, nullptr);
 }
 
 }
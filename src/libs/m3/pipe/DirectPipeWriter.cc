@@ -16,25 +16,92 @@
 
 #include <base/util/Time.h>
 
+#include <cstddef>
+
 #include <m3/com/GateStream.h>
 #include <m3/pipe/DirectPipe.h>
 #include <m3/pipe/DirectPipeWriter.h>
 
 namespace m3 {
 
-DirectPipeWriter::State::State(capsel_t caps, size_t size)
+DirectPipeWriter::State::State(capsel_t caps, size_t size, uint flags)
     : _mgate(MemGate::bind(caps + 0)),
       _rgate(RecvGate::create(nextlog2<DirectPipe::MSG_BUF_SIZE>::val, nextlog2<DirectPipe::MSG_SIZE>::val)),
       _sgate(SendGate::bind(caps + 1, &_rgate)),
-      _size(size),
+      _size((flags & DirectPipe::RING) ? size - DirectPipe::RING_CTRL_SIZE : size),
       _free(_size),
       _rdpos(),
       _wrpos(),
       _capacity(DirectPipe::MSG_BUF_SIZE / DirectPipe::MSG_SIZE),
-      _eof() {
+      _eof(),
+      _flags(flags),
+      _ringwr(),
+      _ringrd(),
+      _rdwait(),
+      _notified() {
     _rgate.activate();
 }
 
+void DirectPipeWriter::State::write_data(const void *buffer, MemGate *mem, goff_t memoff,
+                                         size_t amount, goff_t pos) {
+    Time::start(0xaaaa);
+    if(mem)
+        _mgate.copy_from(*mem, memoff, amount, pos);
+    else
+        _mgate.write(buffer, amount, pos);
+    Time::stop(0xaaaa);
+}
+
+void DirectPipeWriter::State::publish_ring(bool eof) {
+    uint64_t wr[2] = {_ringwr, eof};
+    _mgate.write(wr, sizeof(wr), offsetof(DirectPipe::RingCtrl, wrpos));
+}
+
+void DirectPipeWriter::State::fetch_ring() {
+    uint64_t rd[3];
+    _mgate.read(rd, sizeof(rd), offsetof(DirectPipe::RingCtrl, rdpos));
+    _ringrd = rd[0];
+    _rdwait = rd[1] != 0;
+    if(rd[2])
+        _eof |= DirectPipe::READ_EOF;
+}
+
+void DirectPipeWriter::State::drain_ring_replies() {
+    DTU::Message *msg = DTU::get().fetch_msg(_rgate.ep());
+    if(msg) {
+        GateIStream is(_rgate, msg);
+        _notified = false;
+    }
+}
+
+bool DirectPipeWriter::State::wait_ring_reply() {
+    drain_ring_replies();
+    if(!_notified)
+        return true;
+
+    // the reader might be gone without having seen our notification. it sets rdeof before it
+    // replies to all notifications it has received. thus, if rdeof is not set yet, it will still
+    // reply to ours, which has been delivered already.
+    fetch_ring();
+    if(_eof & DirectPipe::READ_EOF) {
+        _notified = false;
+        return false;
+    }
+    receive_msg(_rgate);
+    _notified = false;
+    return true;
+}
+
+void DirectPipeWriter::State::notify_ring() {
+    // we have at most one notification in flight. if the reader has not answered the previous
+    // one yet, it will do so now that it waits.
+    if(_notified && !wait_ring_reply())
+        return;
+    DBG_PIPE("[write] sending notify\n");
+    send_vmsg(_sgate, static_cast<size_t>(0));
+    _notified = true;
+}
+
 ssize_t DirectPipeWriter::State::find_spot(size_t *len) {
     if(_free == 0)
         return -1;
@@ -56,6 +123,50 @@ ssize_t DirectPipeWriter::State::find_spot(size_t *len) {
     return -1;
 }
 
+void DirectPipeWriter::State::got_reply(size_t len) {
+    DBG_PIPE("[write] got len=" << len << "\n");
+    len = Math::round_up(len, DTU_PKG_SIZE);
+    _rdpos = (_rdpos + len) % _size;
+    _free += len;
+    _capacity++;
+    if(len == 0)
+        _eof |= DirectPipe::READ_EOF;
+}
+
+bool DirectPipeWriter::State::fits(size_t count) {
+    // collect the replies we already got, without waiting for more
+    _rgate.activate();
+    DTU::Message *msg;
+    while((msg = DTU::get().fetch_msg(_rgate.ep())) != nullptr) {
+        GateIStream is(_rgate, msg);
+        size_t len;
+        is.vpull(len);
+        got_reply(len);
+        if(_eof & DirectPipe::READ_EOF)
+            return true;
+    }
+
+    // check whether all pieces can be written now, but leave the state untouched
+    size_t wrpos = _wrpos;
+    size_t free = _free;
+    int capacity = _capacity;
+    size_t rem = count;
+    while(rem > 0) {
+        size_t amount = rem;
+        ssize_t off = find_spot(&amount);
+        if(_capacity == 0 || off == -1)
+            break;
+        _wrpos = (static_cast<size_t>(off) + amount) % _size;
+        _free -= amount;
+        _capacity--;
+        rem -= amount;
+    }
+    _wrpos = wrpos;
+    _free = free;
+    _capacity = capacity;
+    return rem == 0;
+}
+
 void DirectPipeWriter::State::read_replies() {
     // read all expected responses
     if(~_eof & DirectPipe::READ_EOF) {
@@ -70,13 +181,23 @@ void DirectPipeWriter::State::read_replies() {
 }
 
 DirectPipeWriter::DirectPipeWriter(capsel_t caps, size_t size, State *state)
-    : File(FILE_W), _caps(caps), _size(size), _state(state), _noeof() {
+    : DirectPipeWriter(caps, size, 0, state) {
+}
+
+DirectPipeWriter::DirectPipeWriter(capsel_t caps, size_t size, uint flags, State *state)
+    : File(FILE_W), _caps(caps), _size(size), _flags(flags), _state(state), _noeof() {
 }
 
 DirectPipeWriter::~DirectPipeWriter() {
     send_eof();
-    if(_state)
-        _state->read_replies();
+    if(_state) {
+        if(_flags & DirectPipe::RING) {
+            // wait for the reply to our last notification, unless the reader is gone
+            _state->wait_ring_reply();
+        }
+        else
+            _state->read_replies();
+    }
     delete _state;
 }
 
@@ -85,16 +206,82 @@ void DirectPipeWriter::send_eof() {
         return;
 
     if(!_state)
-        _state = new State(_caps, _size);
+        _state = new State(_caps, _size, _flags);
     if(!_state->_eof) {
-        write(nullptr, 0);
+        if(_flags & DirectPipe::RING) {
+            _state->publish_ring(true);
+            _state->fetch_ring();
+            if(_state->_rdwait && (~_state->_eof & DirectPipe::READ_EOF))
+                _state->notify_ring();
+        }
+        else
+            write(nullptr, 0);
         _state->_eof |= DirectPipe::WRITE_EOF;
     }
 }
 
-ssize_t DirectPipeWriter::write(const void *buffer, size_t count, bool blocking) {
+ssize_t DirectPipeWriter::write_ring(const void *buffer, MemGate *mem, goff_t memoff,
+                                     size_t count, bool blocking) {
+    size_t rem = count;
+    const char *buf = reinterpret_cast<const char*>(buffer);
+    while(rem > 0) {
+        if(_state->_notified)
+            _state->drain_ring_replies();
+
+        size_t avail = _state->_size - static_cast<size_t>(_state->_ringwr - _state->_ringrd);
+        if(avail == 0) {
+            // make our data visible and check whether the reader made progress
+            _state->publish_ring(false);
+            _state->fetch_ring();
+            if(_state->_eof & DirectPipe::READ_EOF)
+                return 0;
+            if(_state->_ringwr - _state->_ringrd < _state->_size)
+                continue;
+
+            if(!blocking) {
+                if(rem < count)
+                    break;
+                return -1;
+            }
+            // the reader replies to the notification as soon as it has consumed something. check
+            // again afterwards, because it might have done so before it saw the notification.
+            if(!_state->_notified)
+                _state->notify_ring();
+            else
+                _state->wait_ring_reply();
+            continue;
+        }
+
+        size_t off = static_cast<size_t>(_state->_ringwr % _state->_size);
+        size_t amount = Math::min(rem, Math::min(avail, _state->_size - off));
+        DBG_PIPE("[write] write to pos=" << off << ", len=" << amount << "\n");
+        _state->write_data(buf, mem, memoff, amount, DirectPipe::RING_CTRL_SIZE + off);
+        _state->_ringwr += amount;
+        rem -= amount;
+        buf += amount;
+        memoff += amount;
+    }
+
+    // publish all data at once and only notify the reader if it waits for us
+    _state->publish_ring(false);
+    _state->fetch_ring();
+    if(_state->_rdwait && (~_state->_eof & DirectPipe::READ_EOF))
+        _state->notify_ring();
+    return static_cast<ssize_t>(count - rem);
+}
+
+ssize_t DirectPipeWriter::do_write(const void *buffer, MemGate *mem, goff_t memoff,
+                                   size_t count, bool blocking) {
     if(!_state)
-        _state = new State(_caps, _size);
+        _state = new State(_caps, _size, _flags);
+    if(_state->_eof)
+        return 0;
+    if(_flags & DirectPipe::RING)
+        return write_ring(buffer, mem, memoff, count, blocking);
+
+    // in non-blocking mode, write all or nothing, so that the reader never sees a partial message
+    if(!blocking && !_state->fits(count))
+        return -1;
     if(_state->_eof)
         return 0;
 
@@ -118,15 +305,9 @@ ssize_t DirectPipeWriter::write(const void *buffer, size_t count, bool blocking)
                 else
                     return -1;
             }
-            DBG_PIPE("[write] got len=" << len << "\n");
-            len = Math::round_up(len, DTU_PKG_SIZE);
-            _state->_rdpos = (_state->_rdpos + len) % _state->_size;
-            _state->_free += len;
-            _state->_capacity++;
-            if(len == 0) {
-                _state->_eof |= DirectPipe::READ_EOF;
+            _state->got_reply(len);
+            if(_state->_eof & DirectPipe::READ_EOF)
                 return 0;
-            }
             if(_state->_capacity == 0 || off == -1) {
                 off = _state->find_spot(&amount);
                 if(off == -1)
@@ -137,9 +318,7 @@ ssize_t DirectPipeWriter::write(const void *buffer, size_t count, bool blocking)
         DBG_PIPE("[write] send pos=" << off << ", len=" << amount << "\n");
 
         if(amount) {
-            Time::start(0xaaaa);
-            _state->_mgate.write(buf, amount, static_cast<size_t>(off));
-            Time::stop(0xaaaa);
+            _state->write_data(buf, mem, memoff, amount, static_cast<size_t>(off));
             _state->_wrpos = (static_cast<size_t>(off) + amount) % _size;
         }
         _state->_free -= amount;
@@ -147,9 +326,10 @@ ssize_t DirectPipeWriter::write(const void *buffer, size_t count, bool blocking)
         send_vmsg(_state->_sgate, off, amount);
         rem -= amount;
         buf += amount;
+        memoff += amount;
     }
     while(rem > 0);
-    return buf - reinterpret_cast<const char*>(buffer);
+    return static_cast<ssize_t>(count - rem);
 }
 
 Errors::Code DirectPipeWriter::delegate(VPE &vpe) {
@@ -158,14 +338,15 @@ Errors::Code DirectPipeWriter::delegate(VPE &vpe) {
 
 void DirectPipeWriter::serialize(Marshaller &m) {
     // we can't share the writer between two VPEs atm anyway, so don't serialize the current state
-    m << _caps << _size;
+    m << _caps << _size << _flags;
 }
 
 File *DirectPipeWriter::unserialize(Unmarshaller &um) {
     capsel_t caps;
     size_t size;
-    um >> caps >> size;
-    return new DirectPipeWriter(caps, size, new State(caps, size));
+    uint flags;
+    um >> caps >> size >> flags;
+    return new DirectPipeWriter(caps, size, flags, new State(caps, size, flags));
 }
 
 }
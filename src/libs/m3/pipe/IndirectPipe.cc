@@ -20,8 +20,9 @@
 
 namespace m3 {
 
-IndirectPipe::IndirectPipe(MemGate &mem, size_t memsize, const char *service, int flags)
-    : _pipe(service, mem, memsize),
+IndirectPipe::IndirectPipe(MemGate &mem, size_t memsize, const char *service, int flags,
+                           uint pipeflags)
+    : _pipe(service, mem, memsize, pipeflags),
       _rdfd(VPE::self().fds()->alloc(_pipe.create_channel(true, flags))),
       _wrfd(VPE::self().fds()->alloc(_pipe.create_channel(false, flags))) {
 }
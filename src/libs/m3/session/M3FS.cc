@@ -77,6 +77,15 @@ Errors::Code M3FS::unlink(const char *path) {
     return Errors::last;
 }
 
+Errors::Code M3FS::copy_range(const char *srcpath, const char *dstpath, size_t off, size_t *count) {
+    GateIStream reply = send_receive_vmsg(_gate, COPY_RANGE, srcpath, dstpath, off, *count);
+    reply >> Errors::last;
+    if(Errors::last != Errors::NONE)
+        return Errors::last;
+    reply >> *count;
+    return Errors::NONE;
+}
+
 Errors::Code M3FS::delegate(VPE &vpe) {
     if(vpe.delegate_obj(sel()) != Errors::NONE)
         return Errors::last;
@@ -58,8 +58,8 @@ DirectPipeWriter *NetDirectPipe::writer() {
     return _writer;
 }
 
-InetSocket::InetSocket(int sd, NetworkManager &nm)
-    : _sd(sd), _nm(nm), _recv_pipe(nullptr), _send_pipe(nullptr) {
+InetSocket::InetSocket(int sd, NetworkManager &nm, bool stream)
+    : _sd(sd), _stream(stream), _recv_rem(0), _nm(nm), _recv_pipe(nullptr), _send_pipe(nullptr) {
 }
 
 InetSocket::~InetSocket() {
@@ -81,13 +81,16 @@ Errors::Code InetSocket::connect(IpAddr addr, uint16_t port) {
     return _nm.connect(sd(), addr, port);
 }
 
+InetSocket *InetSocket::accept() {
+    return _nm.accept(sd());
+}
+
 ssize_t InetSocket::send(const void *buffer, size_t count, bool blocking) {
     // TODO: Verify socket is in an appropriate state
     // return _send_pipe->writer()->write(buffer, count, blocking);
     return sendto(buffer, count, IpAddr(), 0, blocking);
 }
 
-// TODO: When end of pipe buffer is reached, unblocking mode fails, cause it sends only a part of the message, and then returns -1.
 ssize_t InetSocket::sendto(const void *buffer, size_t count, IpAddr addr, uint16_t port, bool blocking) {
     // The write of header and data needs to be an "atomic" action
     size_t size = MessageHeader::serialize_length() + count;
@@ -111,6 +114,31 @@ ssize_t InetSocket::recv(void* buffer, size_t count, bool blocking) {
 }
 
 ssize_t InetSocket::recvmsg(void *buffer, size_t count, IpAddr *addr, uint16_t *port, bool blocking) {
+    if(_stream) {
+        // streams have no message boundaries; keep the rest of a message for the next call
+        if(_recv_rem == 0) {
+            uint8_t buf[MessageHeader::serialize_length()];
+            MessageHeader hdr;
+            if(_recv_pipe->reader()->read(buf, sizeof(buf), blocking) == -1)
+                return -1;
+            Unmarshaller um(buf, sizeof(buf));
+            hdr.unserialize(um);
+            // an empty message denotes EOF
+            if(hdr.size == 0)
+                return 0;
+            if(addr)
+                *addr = hdr.addr;
+            if(port)
+                *port = hdr.port;
+            _recv_rem = hdr.size;
+        }
+
+        ssize_t read_size = _recv_pipe->reader()->read(buffer, Math::min(count, _recv_rem), blocking);
+        if(read_size > 0)
+            _recv_rem -= static_cast<size_t>(read_size);
+        return read_size;
+    }
+
     uint8_t buf[MessageHeader::serialize_length()];
     MessageHeader hdr;
     if(_recv_pipe->reader()->read(buf, sizeof(buf), blocking) == -1)
@@ -139,22 +167,25 @@ Errors::Code InetSocket::close() {
     return _nm.close(sd());
 }
 
+InetSocket *NetworkManager::open_socket(int sd, bool stream) {
+    KIF::ExchangeArgs args;
+    args.count = 1;
+    args.vals[0] = static_cast<xfer_t>(sd);
+
+    KIF::CapRngDesc caps = obtain(6, &args);
+    InetSocket *socket = new InetSocket(sd, *this, stream);
+    socket->_recv_pipe = new NetDirectPipe(caps.start(), NetDirectPipe::BUFFER_SIZE, false);
+    socket->_send_pipe = new NetDirectPipe(caps.start() + 3, NetDirectPipe::BUFFER_SIZE, false);
+    return socket;
+}
+
 InetSocket* NetworkManager::create(SocketType type, uint8_t protocol) {
     GateIStream reply = send_receive_vmsg(_metagate, CREATE, type, protocol);
     reply >> Errors::last;
     if(Errors::last == Errors::NONE) {
         int sd;
         reply >> sd;
-
-        KIF::ExchangeArgs args;
-        args.count = 1;
-        args.vals[0] = static_cast<xfer_t>(sd);
-
-        KIF::CapRngDesc caps = obtain(6, &args);
-        InetSocket *socket = new InetSocket(sd, *this);
-        socket->_recv_pipe = new NetDirectPipe(caps.start(), NetDirectPipe::BUFFER_SIZE, false);
-        socket->_send_pipe = new NetDirectPipe(caps.start() + 3, NetDirectPipe::BUFFER_SIZE, false);
-        return socket;
+        return open_socket(sd, type == SOCK_STREAM);
     }
     return nullptr;
 }
@@ -177,6 +208,17 @@ Errors::Code NetworkManager::connect(int sd, IpAddr addr, uint16_t port) {
     return Errors::last;
 }
 
+InetSocket *NetworkManager::accept(int sd) {
+    GateIStream reply = send_receive_vmsg(_metagate, ACCEPT, sd);
+    reply >> Errors::last;
+    if(Errors::last == Errors::NONE) {
+        int nsd;
+        reply >> nsd;
+        return open_socket(nsd, true);
+    }
+    return nullptr;
+}
+
 Errors::Code NetworkManager::close(int sd) {
     GateIStream reply = send_receive_vmsg(_metagate, CLOSE, sd);
     reply >> Errors::last;
@@ -14,10 +14,21 @@
  * General Public License version 2 for more details.
  */
 
+#include <base/stream/OStringStream.h>
+
+#include <m3/com/GateStream.h>
+#include <m3/session/M3FS.h>
 #include <m3/vfs/Dir.h>
+#include <m3/vfs/GenericFile.h>
+#include <m3/vfs/VFS.h>
 
 namespace m3 {
 
+Dir::~Dir() {
+    delete[] _batch;
+    delete _mem;
+}
+
 bool Dir::readdir(Entry &e) {
     // read header
     DirEntry fse;
@@ -39,4 +50,69 @@ bool Dir::readdir(Entry &e) {
     return true;
 }
 
+bool Dir::fetch_batch() {
+    // batches are only supported for files with a session at m3fs
+    File *file = _f.file();
+    if(!file || file->type() != 'F' || (file->flags() & FILE_NOSESS))
+        return false;
+    GenericFile *gfile = static_cast<GenericFile*>(file);
+
+    // let the server write the entries into our memory
+    if(!_mem) {
+        _mem = new MemGate(MemGate::create_global(BATCH_SIZE * sizeof(DirEntryInfo), MemGate::RW));
+        KIF::ExchangeArgs args;
+        args.count = 2;
+        args.vals[0] = M3FS::READDIR_PLUS;
+        args.vals[1] = BATCH_SIZE * sizeof(DirEntryInfo);
+        KIF::CapRngDesc crd(KIF::CapRngDesc::OBJ, _mem->sel(), 1);
+        if(gfile->sess().delegate(crd, &args) != Errors::NONE) {
+            delete _mem;
+            _mem = nullptr;
+            return false;
+        }
+        _batch = new DirEntryInfo[BATCH_SIZE];
+    }
+
+    GateIStream reply = send_receive_vmsg(gfile->sgate(), M3FS::READDIR_PLUS, _pos);
+    reply >> Errors::last;
+    if(Errors::last != Errors::NONE)
+        return false;
+    reply >> _batch_count >> _pos;
+
+    if(_batch_count > 0)
+        _mem->read(_batch, _batch_count * sizeof(DirEntryInfo), 0);
+    _batch_pos = 0;
+    return true;
+}
+
+bool Dir::readdir(Entry &e, FileInfo &info) {
+    if(_plus && _batch_pos == _batch_count) {
+        if(!fetch_batch()) {
+            // all entries before <_pos> have been returned already; continue behind them
+            _plus = false;
+            _f.seek(_pos, M3FS_SEEK_SET);
+        }
+        else if(_batch_count == 0)
+            return false;
+    }
+
+    if(_plus) {
+        const DirEntryInfo &de = _batch[_batch_pos++];
+        e.nodeno = de.info.inode;
+        memcpy(e.name, de.name, sizeof(e.name));
+        e.name[Entry::MAX_NAME_LEN - 1] = '\0';
+        info = de.info;
+        return true;
+    }
+
+    // fall back to reading the entry and requesting the information separately
+    if(!readdir(e))
+        return false;
+    char path[256];
+    OStringStream os(path, sizeof(path));
+    os << _path << "/" << e.name;
+    VFS::stat(os.str(), info);
+    return true;
+}
+
 }
@@ -14,6 +14,7 @@
  * General Public License version 2 for more details.
  */
 
+#include <m3/com/MemGate.h>
 #include <m3/vfs/File.h>
 
 namespace m3 {
@@ -61,4 +62,44 @@ Errors::Code File::Buffer::flush(File *file) {
     return res;
 }
 
+ssize_t File::read_mem(MemGate &mem, goff_t off, size_t count) {
+    char *buf = new char[Math::min(count, SPLICE_BUF_SIZE)];
+    ssize_t res = read(buf, Math::min(count, SPLICE_BUF_SIZE));
+    if(res > 0 && mem.write(buf, static_cast<size_t>(res), off) != Errors::NONE)
+        res = -1;
+    delete[] buf;
+    return res;
+}
+
+ssize_t File::write_mem(MemGate &mem, goff_t off, size_t count) {
+    char *buf = new char[Math::min(count, SPLICE_BUF_SIZE)];
+    size_t amount = Math::min(count, SPLICE_BUF_SIZE);
+    ssize_t res = -1;
+    if(mem.read(buf, amount, off) == Errors::NONE)
+        res = write(buf, amount);
+    delete[] buf;
+    return res;
+}
+
+ssize_t File::splice_from(File &in, size_t count) {
+    // neither side has a memory window; go through a buffer
+    char *buf = new char[Math::min(count, SPLICE_BUF_SIZE)];
+    ssize_t res = in.read(buf, Math::min(count, SPLICE_BUF_SIZE));
+    if(res > 0 && write_all(buf, static_cast<size_t>(res)) != Errors::NONE)
+        res = -1;
+    delete[] buf;
+    return res;
+}
+
+ssize_t File::tee(File *const *outs, size_t num, size_t count) {
+    char *buf = new char[Math::min(count, SPLICE_BUF_SIZE)];
+    ssize_t res = read(buf, Math::min(count, SPLICE_BUF_SIZE));
+    for(size_t i = 0; res > 0 && i < num; ++i) {
+        if(outs[i]->write_all(buf, static_cast<size_t>(res)) != Errors::NONE)
+            res = -1;
+    }
+    delete[] buf;
+    return res;
+}
+
 }
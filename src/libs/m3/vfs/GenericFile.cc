@@ -37,7 +37,9 @@ GenericFile::GenericFile(int flags, capsel_t caps, size_t id, epid_t mep, M3FS *
       _off(),
       _pos(),
       _len(),
-      _writing() {
+      _writing(),
+      _inline(),
+      _inline_buf() {
     if(mep != EP_COUNT)
         _mg.ep(mep);
 }
@@ -61,6 +63,7 @@ GenericFile::~GenericFile() {
         }
         delete _sg;
     }
+    delete[] _inline_buf;
 }
 
 Errors::Code GenericFile::stat(FileInfo &info) const {
@@ -137,20 +140,31 @@ size_t GenericFile::received_next_resp(GateIStream &is) {
     if(Errors::last != Errors::NONE)
         return 0;
 
+    set_window(is);
+    return _len;
+}
+
+void GenericFile::set_window(GateIStream &is) {
     _goff += _len;
-    is >> _off >> _len;
+    is >> _off >> _len >> _inline;
     _pos = 0;
-    return _len;
+
+    // m3fs sends the data of files stored in the inode along with the reply
+    if(_inline) {
+        String data;
+        is >> data;
+        assert(_len <= INODE_INLINE_SIZE && data.length() <= _len);
+        if(!_inline_buf)
+            _inline_buf = new char[INODE_INLINE_SIZE];
+        memcpy(_inline_buf, data.c_str(), data.length());
+    }
 }
 
-ssize_t GenericFile::read(void *buffer, size_t count) {
+Errors::Code GenericFile::next_in() {
     if(delegate_ep() != Errors::NONE)
-        return -1;
+        return Errors::last;
     if(_writing && submit() != Errors::NONE)
-        return -1;
-
-    LLOG(FS, "GenFile[" << fd() << "," << _id << "]::read("
-        << count << ", pos=" << (_goff + _pos) << ")");
+        return Errors::last;
 
     if(_pos == _len) {
         Time::start(0xbbbb);
@@ -159,12 +173,42 @@ ssize_t GenericFile::read(void *buffer, size_t count) {
         reply >> Errors::last;
         Time::stop(0xbbbb);
         if(Errors::last != Errors::NONE)
-            return -1;
+            return Errors::last;
+
+        set_window(reply);
+    }
+    return Errors::NONE;
+}
+
+Errors::Code GenericFile::next_out() {
+    if(delegate_ep() != Errors::NONE)
+        return Errors::last;
+
+    if(_pos == _len) {
+        // the server can't fetch the data of inline windows itself
+        if(_inline && _writing && submit() != Errors::NONE)
+            return Errors::last;
+
+        Time::start(0xbbbb);
+        GateIStream reply = !have_sess() ? send_receive_vmsg(*_sg, NEXT_OUT, _id)
+                                         : send_receive_vmsg(*_sg, NEXT_OUT);
+        reply >> Errors::last;
+        Time::stop(0xbbbb);
+        if(Errors::last != Errors::NONE)
+            return Errors::last;
 
-        _goff += _len;
-        reply >> _off >> _len;
-        _pos = 0;
+        set_window(reply);
     }
+    _writing = true;
+    return Errors::NONE;
+}
+
+ssize_t GenericFile::read(void *buffer, size_t count) {
+    LLOG(FS, "GenFile[" << fd() << "," << _id << "]::read("
+        << count << ", pos=" << (_goff + _pos) << ")");
+
+    if(next_in() != Errors::NONE)
+        return -1;
 
     size_t amount = Math::min(count, _len - _pos);
     if(amount > 0) {
@@ -173,6 +217,8 @@ ssize_t GenericFile::read(void *buffer, size_t count) {
             if(count > 2)
                 CPU::compute(count / 2);
         }
+        else if(_inline)
+            memcpy(buffer, _inline_buf + _pos, amount);
         else
             _mg.read(buffer, amount, _memoff + _off + _pos);
         Time::stop(0xaaaa);
@@ -196,25 +242,11 @@ bool GenericFile::send_next_output(label_t reply_label) {
 }
 
 ssize_t GenericFile::write(const void *buffer, size_t count) {
-    if(delegate_ep() != Errors::NONE)
-        return -1;
-
     LLOG(FS, "GenFile[" << fd() << "," << _id << "]::write("
         << count << ", pos=" << (_goff + _pos) << ")");
 
-    if(_pos == _len) {
-        Time::start(0xbbbb);
-        GateIStream reply = !have_sess() ? send_receive_vmsg(*_sg, NEXT_OUT, _id)
-                                         : send_receive_vmsg(*_sg, NEXT_OUT);
-        reply >> Errors::last;
-        Time::stop(0xbbbb);
-        if(Errors::last != Errors::NONE)
-            return -1;
-
-        _goff += _len;
-        reply >> _off >> _len;
-        _pos = 0;
-    }
+    if(next_out() != Errors::NONE)
+        return -1;
 
     size_t amount = Math::min(count, _len - _pos);
     if(amount > 0) {
@@ -223,12 +255,130 @@ ssize_t GenericFile::write(const void *buffer, size_t count) {
             if(count > 4)
                 CPU::compute(count / 4);
         }
+        else if(_inline)
+            memcpy(_inline_buf + _pos, buffer, amount);
         else
             _mg.write(buffer, amount, _memoff + _off + _pos);
         Time::stop(0xaaaa);
         _pos += amount;
     }
-    _writing = true;
+    return static_cast<ssize_t>(amount);
+}
+
+ssize_t GenericFile::read_mem(MemGate &mem, goff_t off, size_t count) {
+    if(flags() & FILE_NODATA)
+        return File::read_mem(mem, off, count);
+
+    LLOG(FS, "GenFile[" << fd() << "," << _id << "]::read_mem("
+        << count << ", pos=" << (_goff + _pos) << ")");
+
+    if(next_in() != Errors::NONE)
+        return -1;
+    if(_inline)
+        return File::read_mem(mem, off, count);
+
+    size_t amount = Math::min(count, _len - _pos);
+    if(amount > 0) {
+        if(mem.copy_from(_mg, _memoff + _off + _pos, amount, off) != Errors::NONE)
+            return -1;
+        _pos += amount;
+    }
+    return static_cast<ssize_t>(amount);
+}
+
+ssize_t GenericFile::write_mem(MemGate &mem, goff_t off, size_t count) {
+    if(flags() & FILE_NODATA)
+        return File::write_mem(mem, off, count);
+
+    LLOG(FS, "GenFile[" << fd() << "," << _id << "]::write_mem("
+        << count << ", pos=" << (_goff + _pos) << ")");
+
+    if(next_out() != Errors::NONE)
+        return -1;
+    if(_inline)
+        return File::write_mem(mem, off, count);
+
+    size_t amount = Math::min(count, _len - _pos);
+    if(amount > 0) {
+        if(_mg.copy_from(mem, off, amount, _memoff + _off + _pos) != Errors::NONE)
+            return -1;
+        _pos += amount;
+    }
+    return static_cast<ssize_t>(amount);
+}
+
+ssize_t GenericFile::splice(File &out, size_t count) {
+    if(flags() & FILE_NODATA)
+        return File::splice(out, count);
+
+    if(next_in() != Errors::NONE)
+        return -1;
+    // inline windows have no memory gate to hand out
+    if(_inline)
+        return File::splice(out, count);
+
+    size_t amount = Math::min(count, _len - _pos);
+    if(amount == 0)
+        return 0;
+
+    // let the other side copy directly from our current window
+    ssize_t res = out.write_mem(_mg, _memoff + _off + _pos, amount);
+    if(res > 0)
+        _pos += static_cast<size_t>(res);
+    return res;
+}
+
+ssize_t GenericFile::splice_from(File &in, size_t count) {
+    if(flags() & FILE_NODATA)
+        return File::splice_from(in, count);
+
+    if(next_out() != Errors::NONE)
+        return -1;
+    if(_inline)
+        return File::splice_from(in, count);
+
+    // let the other side copy directly into our current window
+    ssize_t res = in.read_mem(_mg, _memoff + _off + _pos, Math::min(count, _len - _pos));
+    if(res > 0)
+        _pos += static_cast<size_t>(res);
+    return res;
+}
+
+ssize_t GenericFile::tee(File *const *outs, size_t num, size_t count) {
+    if(flags() & FILE_NODATA)
+        return File::tee(outs, num, count);
+
+    if(next_in() != Errors::NONE)
+        return -1;
+    if(_inline)
+        return File::tee(outs, num, count);
+
+    size_t amount = Math::min(count, _len - _pos);
+    if(amount == 0 || num == 0)
+        return 0;
+
+    // the first file determines how much we move; the others have to take the same amount
+    ssize_t res = outs[0]->write_mem(_mg, _memoff + _off + _pos, amount);
+    if(res <= 0)
+        return res;
+    amount = static_cast<size_t>(res);
+
+    for(size_t i = 1; i < num; ++i) {
+        size_t done = 0;
+        while(done < amount) {
+            res = outs[i]->write_mem(_mg, _memoff + _off + _pos + done, amount - done);
+            if(res <= 0) {
+                // the previous files have the data already. consume it anyway, so that a retry
+                // doesn't hand it to them again.
+                _pos += amount;
+                if(res == 0)
+                    Errors::last = Errors::END_OF_FILE;
+                return -1;
+            }
+            done += static_cast<size_t>(res);
+        }
+    }
+    _pos += amount;
     return static_cast<ssize_t>(amount);
 }
 
@@ -251,8 +401,19 @@ Errors::Code GenericFile::submit() {
         LLOG(FS, "GenFile[" << fd() << "," << _id << "]::submit("
             << (_writing ? "write" : "read") << ", " << _pos << ")");
 
-        GateIStream reply = !have_sess() ? send_receive_vmsg(*_sg, COMMIT, _id, _pos)
-                                         : send_receive_vmsg(*_sg, COMMIT, _pos);
+        StaticGateOStream<ostreamsize<Operation, size_t, size_t, size_t>() + INODE_INLINE_SIZE> os;
+        os << COMMIT;
+        if(!have_sess())
+            os << _id;
+        os << _pos;
+        // the data of inline windows is transferred within the message
+        if(_inline && _writing)
+            os << String(_inline_buf, _pos);
+        Errors::Code res = send_msg(*_sg, os.bytes(), os.total());
+        if(res != Errors::NONE)
+            return Errors::last = res;
+
+        GateIStream reply = receive_reply(*_sg);
         reply >> Errors::last;
         if(Errors::last != Errors::NONE)
             return Errors::last;
@@ -132,6 +132,19 @@ Errors::Code VFS::unlink(const char *path) {
     return fs->unlink(path + pos);
 }
 
+Errors::Code VFS::copy_range(const char *srcpath, const char *dstpath, size_t off, size_t *count) {
+    size_t pos1, pos2;
+    Reference<FileSystem> fs1 = ms()->resolve(srcpath, &pos1);
+    if(!fs1.valid())
+        return Errors::last = Errors::NO_SUCH_FILE;
+    Reference<FileSystem> fs2 = ms()->resolve(dstpath, &pos2);
+    if(!fs2.valid())
+        return Errors::last = Errors::NO_SUCH_FILE;
+    if(fs1.get() != fs2.get())
+        return Errors::last = Errors::XFS_LINK;
+    return fs1->copy_range(srcpath + pos1, dstpath + pos2, off, count);
+}
+
 void VFS::print(OStream &os) {
     VPE::self().mounts()->print(os);
 }
@@ -18,6 +18,7 @@
 
 use core::fmt;
 use col::Vec;
+use io;
 use time;
 use util;
 
@@ -41,6 +42,9 @@ impl Results {
 
     /// Returns the arithmetic mean of the runtimes
     pub fn avg(&self) -> time::Time {
+        if self.times.is_empty() {
+            return 0;
+        }
         let mut sum = 0;
         for t in &self.times {
             sum += t;
@@ -50,6 +54,9 @@ impl Results {
 
     /// Returns the standard deviation of the runtimes
     pub fn stddev(&self) -> f32 {
+        if self.times.is_empty() {
+            return 0.0;
+        }
         let mut sum = 0;
         let average = self.avg();
         for t in &self.times {
@@ -64,6 +71,57 @@ impl Results {
         util::sqrt((sum as f32) / (self.times.len() as f32))
     }
 
+    /// Returns the `p`-th percentile (0..100) of the runtimes (nearest rank)
+    pub fn percentile(&self, p: usize) -> time::Time {
+        if self.times.is_empty() {
+            return 0;
+        }
+        let mut sorted = self.times.clone();
+        sorted.sort_unstable();
+        let rank = (sorted.len() * p + 99) / 100;
+        sorted[if rank > 0 { rank - 1 } else { 0 }]
+    }
+
+    /// Returns the minimum of the runtimes
+    pub fn min(&self) -> time::Time {
+        self.percentile(0)
+    }
+
+    /// Returns the median of the runtimes
+    pub fn median(&self) -> time::Time {
+        self.percentile(50)
+    }
+
+    /// Returns the maximum of the runtimes
+    pub fn max(&self) -> time::Time {
+        self.percentile(100)
+    }
+
+    /// Returns the throughput in units per cycle, given that each run processed `units` units
+    /// (e.g., bytes or operations)
+    pub fn throughput(&self, units: usize) -> f32 {
+        let average = self.avg();
+        if average == 0 {
+            0.0
+        }
+        else {
+            (units as f32) / (average as f32)
+        }
+    }
+
+    /// Returns an object that displays the results as a single JSON line for regression tracking
+    ///
+    /// `param` is the parameter of the benchmark (e.g., the message size; 0 = none) and `units` the
+    /// number of units processed per run to report the throughput (0 = none).
+    pub fn json<'r>(&'r self, name: &'r str, param: usize, units: usize) -> JSONResults<'r> {
+        JSONResults {
+            res: self,
+            name: name,
+            param: param,
+            units: units,
+        }
+    }
+
     fn push(&mut self, time: time::Time) {
         self.times.push(time);
     }
@@ -71,7 +129,40 @@ impl Results {
 
 impl fmt::Display for Results {
     fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
-        write!(f, "{} cycles/iter (+/- {} with {} runs)", self.avg(), self.stddev(), self.runs())
+        write!(
+            f, "{} cycles/iter (+/- {} with {} runs), median {}, p99 {}, max {}",
+            self.avg(), self.stddev(), self.runs(), self.median(), self.percentile(99), self.max()
+        )
+    }
+}
+
+/// Displays `Results` as a JSON object on a single line
+pub struct JSONResults<'r> {
+    res: &'r Results,
+    name: &'r str,
+    param: usize,
+    units: usize,
+}
+
+impl<'r> fmt::Display for JSONResults<'r> {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        let r = self.res;
+        write!(f, "{{\"name\":\"{}\"", self.name)?;
+        if self.param != 0 {
+            write!(f, ",\"param\":{}", self.param)?;
+        }
+        write!(
+            f, ",\"runs\":{},\"avg\":{},\"stddev\":{},\"min\":{},\"median\":{}",
+            r.runs(), r.avg(), r.stddev(), r.min(), r.median()
+        )?;
+        write!(
+            f, ",\"p90\":{},\"p99\":{},\"max\":{}",
+            r.percentile(90), r.percentile(99), r.max()
+        )?;
+        if self.units != 0 {
+            write!(f, ",\"throughput\":{}", r.throughput(self.units))?;
+        }
+        write!(f, "}}")
     }
 }
 
@@ -160,7 +251,7 @@ impl Profiler {
     /// in the gem5 log.
     #[inline(always)]
     pub fn run_with_id<F: FnMut()>(&mut self, mut func: F, id: usize) -> Results {
-        let mut res = Results::new((self.warmup + self.repeats) as usize);
+        let mut res = Results::new(self.repeats as usize);
         for i in 0..self.warmup + self.repeats {
             let start = time::start(id);
             func();
@@ -180,7 +271,7 @@ impl Profiler {
     /// in the gem5 log.
     #[inline(always)]
     pub fn runner_with_id<R: Runner>(&mut self, runner: &mut R, id: usize) -> Results {
-        let mut res = Results::new((self.warmup + self.repeats) as usize);
+        let mut res = Results::new(self.repeats as usize);
         for i in 0..self.warmup + self.repeats {
             runner.pre();
 
@@ -196,4 +287,19 @@ impl Profiler {
         }
         res
     }
+
+    /// Runs `func(param)` as benchmark for all `params` (e.g., message sizes) and writes one JSON
+    /// line per parameter to `out`
+    ///
+    /// The id is used for `time::start` and `time::stop`. If `tput` is true, the parameter is
+    /// treated as the number of processed units to report the throughput.
+    pub fn sweep<W, F>(&mut self, out: &mut W, name: &str, params: &[usize], mut func: F,
+                       id: usize, tput: bool)
+                       where W: io::Write, F: FnMut(usize) {
+        for &param in params {
+            let res = self.run_with_id(|| func(param), id);
+            let units = if tput { param } else { 0 };
+            writeln!(out, "{}", res.json(name, param, units)).unwrap();
+        }
+    }
 }
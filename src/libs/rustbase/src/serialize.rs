@@ -16,7 +16,7 @@
 
 //! Contains the serializing basics, which is used for IPC
 
-use col::String;
+use col::{String, Vec};
 
 /// For types that can be marshalled into a [`Sink`](trait.Sink.html).
 pub trait Marshallable {
@@ -42,6 +42,8 @@ pub trait Sink {
     fn push_word(&mut self, word: u64);
     /// Pushes the given string into this sink
     fn push_str(&mut self, b: &str);
+    /// Pushes the given bytes into this sink
+    fn push_bytes(&mut self, b: &[u8]);
 }
 
 /// A source allows to pop objects from it
@@ -50,6 +52,8 @@ pub trait Source {
     fn pop_word(&mut self) -> u64;
     /// Pops a string from this source
     fn pop_str(&mut self) -> String;
+    /// Pops a byte vector from this source
+    fn pop_bytes(&mut self) -> Vec<u8>;
 }
 
 macro_rules! impl_xfer_prim {
@@ -105,3 +109,14 @@ impl Unmarshallable for String {
         s.pop_str()
     }
 }
+
+impl<'a> Marshallable for &'a [u8] {
+    fn marshall(&self, s: &mut Sink) {
+        s.push_bytes(self);
+    }
+}
+impl Unmarshallable for Vec<u8> {
+    fn unmarshall(s: &mut Source) -> Self {
+        s.pop_bytes()
+    }
+}
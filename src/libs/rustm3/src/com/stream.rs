@@ -62,12 +62,15 @@ impl Sink for GateSink {
         self.pos += 1;
     }
     fn push_str(&mut self, b: &str) {
+        self.push_bytes(b.as_bytes());
+    }
+    fn push_bytes(&mut self, b: &[u8]) {
         self.push_word(b.len() as u64);
 
         unsafe {
             libc::memcpy(
                 (&mut self.arr[self.pos..]).as_mut_ptr() as *mut libc::c_void,
-                b.as_bytes().as_ptr() as *const libc::c_void,
+                b.as_ptr() as *const libc::c_void,
                 b.len(),
             );
         }
@@ -104,6 +107,9 @@ impl Sink for VecSink {
         self.vec.push(word);
     }
     fn push_str(&mut self, b: &str) {
+        self.push_bytes(b.as_bytes());
+    }
+    fn push_bytes(&mut self, b: &[u8]) {
         self.push_word(b.len() as u64);
 
         let elems = (b.len() + 7) / 8;
@@ -114,7 +120,7 @@ impl Sink for VecSink {
             self.vec.set_len(cur + elems);
             libc::memcpy(
                 (&mut self.vec.as_mut_slice()[cur..cur + elems]).as_mut_ptr() as *mut libc::c_void,
-                b.as_bytes().as_ptr() as *const libc::c_void,
+                b.as_ptr() as *const libc::c_void,
                 b.len(),
             );
         }
@@ -152,6 +158,15 @@ fn copy_str_from(s: &[u64], len: usize) -> String {
     }
 }
 
+fn copy_bytes_from(s: &[u64], len: usize) -> Vec<u8> {
+    let mut res = Vec::with_capacity(len);
+    unsafe {
+        libc::memcpy(res.as_mut_ptr() as *mut libc::c_void, s.as_ptr() as *const libc::c_void, len);
+        res.set_len(len);
+    }
+    res
+}
+
 impl Source for GateSource {
     #[inline(always)]
     fn pop_word(&mut self) -> u64 {
@@ -164,6 +179,12 @@ impl Source for GateSource {
         self.pos += (len + 7) / 8;
         res
     }
+    fn pop_bytes(&mut self) -> Vec<u8> {
+        let len = self.pop_word() as usize;
+        let res = copy_bytes_from(&self.data()[self.pos..], len);
+        self.pos += (len + 7) / 8;
+        res
+    }
 }
 
 pub struct SliceSource<'s> {
@@ -195,6 +216,12 @@ impl<'s> Source for SliceSource<'s> {
         self.pos += (len + 7) / 8;
         res
     }
+    fn pop_bytes(&mut self) -> Vec<u8> {
+        let len = self.pop_word() as usize;
+        let res = copy_bytes_from(&self.slice[self.pos..], len);
+        self.pos += (len + 7) / 8;
+        res
+    }
 }
 
 pub struct GateOStream {
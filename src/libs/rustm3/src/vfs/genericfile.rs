@@ -18,7 +18,7 @@ use cap::Selector;
 use cell::RefCell;
 use col::Vec;
 use core::fmt;
-use com::{MemGate, RecvGate, SendGate, SliceSource, VecSink};
+use com::{GateIStream, MemGate, RecvGate, SendGate, SliceSource, VecSink};
 use serialize::Sink;
 use errors::Error;
 use goff;
@@ -51,6 +51,8 @@ pub struct GenericFile {
     pos: usize,
     len: usize,
     writing: bool,
+    // the data of windows that have been transferred within the messages (see m3fs)
+    inline: Option<Vec<u8>>,
 }
 
 impl GenericFile {
@@ -65,6 +67,7 @@ impl GenericFile {
             pos: 0,
             len: 0,
             writing: false,
+            inline: None,
         }
     }
 
@@ -75,10 +78,17 @@ impl GenericFile {
 
     fn submit(&mut self, force: bool) -> Result<(), Error> {
         if self.pos > 0 && (self.writing || force) {
-            let mut reply = send_recv_res!(
-                &self.sgate, RecvGate::def(),
-                Operation::COMMIT, self.pos
-            )?;
+            let mut reply = match self.inline {
+                // the data of inline windows is transferred within the message
+                Some(ref data) if self.writing => send_recv_res!(
+                    &self.sgate, RecvGate::def(),
+                    Operation::COMMIT, self.pos, &data[0..self.pos]
+                ),
+                _ => send_recv_res!(
+                    &self.sgate, RecvGate::def(),
+                    Operation::COMMIT, self.pos
+                ),
+            }?;
             // if we append, the file was truncated
             let filesize = reply.pop();
             if self.goff + self.len > filesize {
@@ -92,6 +102,24 @@ impl GenericFile {
         Ok(())
     }
 
+    fn set_window(&mut self, reply: &mut GateIStream) {
+        self.goff += self.len;
+        self.off = reply.pop();
+        self.len = reply.pop();
+        self.pos = 0;
+
+        // m3fs sends the data of files stored in the inode along with the reply
+        let inline: bool = reply.pop();
+        self.inline = if inline {
+            let mut data: Vec<u8> = reply.pop();
+            data.resize(self.len, 0);
+            Some(data)
+        }
+        else {
+            None
+        };
+    }
+
     fn delegate_ep(&mut self) -> Result<(), Error> {
         if self.mgate.ep().is_none() {
             let ep = VPE::cur().files().request_ep(self.fd)?;
@@ -204,16 +232,16 @@ impl Read for GenericFile {
                 Operation::NEXT_IN
             )?;
             time::stop(0xbbbb);
-            self.goff += self.len;
-            self.off = reply.pop();
-            self.len = reply.pop();
-            self.pos = 0;
+            self.set_window(&mut reply);
         }
 
         let amount = util::min(buf.len(), self.len - self.pos);
         if amount > 0 {
             time::start(0xaaaa);
-            self.mgate.read(&mut buf[0..amount], (self.off + self.pos) as goff)?;
+            match self.inline {
+                Some(ref data) => buf[0..amount].copy_from_slice(&data[self.pos..self.pos + amount]),
+                None           => self.mgate.read(&mut buf[0..amount], (self.off + self.pos) as goff)?,
+            }
             time::stop(0xaaaa);
             self.pos += amount;
         }
@@ -231,22 +259,27 @@ impl Write for GenericFile {
         self.delegate_ep()?;
 
         if self.pos == self.len {
+            // the server can't fetch the data of inline windows itself
+            if self.inline.is_some() {
+                self.submit(false)?;
+            }
+
             time::start(0xbbbb);
             let mut reply = send_recv_res!(
                 &self.sgate, RecvGate::def(),
                 Operation::NEXT_OUT
             )?;
             time::stop(0xbbbb);
-            self.goff += self.len;
-            self.off = reply.pop();
-            self.len = reply.pop();
-            self.pos = 0;
+            self.set_window(&mut reply);
         }
 
         let amount = util::min(buf.len(), self.len - self.pos);
         if amount > 0 {
             time::start(0xaaaa);
-            self.mgate.write(&buf[0..amount], (self.off + self.pos) as goff)?;
+            match self.inline {
+                Some(ref mut data) => data[self.pos..self.pos + amount].copy_from_slice(&buf[0..amount]),
+                None               => self.mgate.write(&buf[0..amount], (self.off + self.pos) as goff)?,
+            }
             time::stop(0xaaaa);
             self.pos += amount;
         }
@@ -60,6 +60,15 @@ static void export_rec(const char *dest, m3::inodeno_t dirno, const char *src) {
             }
         }
     }
+    else if(is_inline(inode)) {
+        FILE *f = fopen(path, "w");
+        if(f == nullptr)
+            err(1, "Unable to open '%s' for writing", path);
+
+        if(fwrite(inode.inline_data(), 1, inode.size, f) != inode.size)
+            err(1, "fwrite to '%s' failed", path);
+        fclose(f);
+    }
     else {
         FILE *f = fopen(path, "w");
         if(f == nullptr)
@@ -46,6 +46,18 @@ static void collect_blocks_and_inodes(m3::inodeno_t ino, m3::Bitmap &blocks, m3:
     if(inode.inode != ino)
         errx(1, "Inode %u says that its inode-number is %u", ino, inode.inode);
 
+    if(is_inline(inode)) {
+        if(!M3FS_ISREG(inode.mode))
+            errx(1, "Inode %u has inline data, but is no regular file", ino);
+        if(inode.size > m3::INODE_INLINE_SIZE) {
+            errx(1, "Inode %u has inline data, but its size is %lu (max is %u)",
+                    ino, static_cast<unsigned long>(inode.size), m3::INODE_INLINE_SIZE);
+        }
+        if(inode.extents != 0)
+            errx(1, "Inode %u has inline data, but %u extents", ino, inode.extents);
+        return;
+    }
+
     uint32_t block_count = (inode.size + sb.blocksize - 1) / sb.blocksize;
     if(M3FS_ISDIR(inode.mode)) {
         char *buffer = new char[sb.blocksize];
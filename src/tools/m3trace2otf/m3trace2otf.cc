@@ -31,6 +31,7 @@
 #define TRACE_FUNCS_TO_STRING
 
 #include <base/arch/t2/TracingEvent.h>
+#include <base/arch/host/TracingEvent.h>
 #include <base/tracing/Event.h>
 
 #include <iostream>
@@ -39,6 +40,7 @@
 #include <set>
 #include <array>
 #include <vector>
+#include <string>
 #include <algorithm>
 
 #ifndef VERBOSE
@@ -48,6 +50,8 @@
 #define M3_TRACE_FILE_NAME "./trace.txt"
 #define TH_CLOCK_MHZ 400
 #define TH_NUM_PES 8
+// default TSC frequency for host traces
+#define HOST_CLOCK_MHZ 1000
 
 #define MEM_TAG 0
 
@@ -62,31 +66,57 @@ struct Event_Pe
     uint64_t timestamp;
 };
 
+// the format-independent representation of an event
+struct Trace_Event
+{
+    uint64_t timestamp;
+    uint32_t process;   // the OTF process that recorded the event
+    uint32_t type;
+    uint32_t remote;    // the OTF process of the communication partner
+    uint32_t size;
+    uint32_t tag;
+    uint32_t id;        // function id or user function name
+};
 
-int read_m3_trace_file( char *path, std::vector<Event_Pe> &buf )
+struct Trace_Process
 {
-    char filename[256];
-    char readbuf[32];
-    if( path )
-        strcpy( filename, path );
-    else
-        strcpy( filename, M3_TRACE_FILE_NAME );
+    uint32_t id;
+    std::string name;
+};
 
-    printf( "reading trace file: %s\n", filename );
+struct Trace
+{
+    uint64_t clock_hz;
+    std::vector<Trace_Process> processes;
+    std::vector<Trace_Event> events;
+    // the processes taking part in memory accesses and message passing, respectively
+    std::vector<uint32_t> mem_group;
+    std::vector<uint32_t> msg_group;
+};
 
-    FILE *fd = fopen( filename, "r" );
-    if( !fd )
+static const char *ufunc_name( uint32_t id )
+{
+    static union
     {
-        perror( "cannot open trace file" );
-        return 1;
-    }
+        char chars[5];
+        uint32_t i;
+    } s;
+    s.chars[4] = 0;
+    s.i = id;
+    return s.chars;
+}
 
+int read_m3_trace_file( FILE *fd, Trace &trace )
+{
+    char readbuf[32];
     unsigned int pe = 0;
     Event_Pe tmp;
     uint64_t timestamp = 0;
+    uint32_t max_timestamp = 0;
 
     // read the trace file into the buffer
     // and extrace pe and timestamp into type Event_Pe
+    std::vector<Event_Pe> buf;
     while( fgets( readbuf, 32, fd ) )
     {
         if( readbuf[0] == 'p' )
@@ -114,38 +144,216 @@ int read_m3_trace_file( char *path, std::vector<Event_Pe> &buf )
                 tmp.timestamp = timestamp;
                 tmp.pe = pe;
                 buf.push_back( tmp );
+                if( max_timestamp < tmp.event.timestamp() ) max_timestamp = tmp.event.timestamp();
             }
         }
     }
 
-    fclose( fd );
+    printf( "max_timestamp delta: %u / %lu  %.1fx\n", max_timestamp, REC_MASK_TIMESTAMP, ( float )REC_MASK_TIMESTAMP / ( float )max_timestamp );
+
+    trace.clock_hz = ( uint64_t )TH_CLOCK_MHZ * 1000 * 1000;
+
+    // Processes.
+    uint32_t pe1 = 4;
+    for( uint32_t i = 0; i < TH_NUM_PES; ++i )
+    {
+        char peName[8];
+        snprintf( peName, 5, "Pe%d", i + 1 );
+        trace.processes.push_back( Trace_Process{ pe1 + i, peName } );
+        trace.mem_group.push_back( pe1 + i );
+        trace.msg_group.push_back( pe1 + i );
+    }
+    uint32_t mem = 2;
+    trace.processes.push_back( Trace_Process{ mem, "Mem" } );
+    trace.mem_group.push_back( mem );
+
+    for( auto &ev : buf )
+    {
+        Trace_Event tev;
+        tev.timestamp = ev.timestamp;
+        tev.process = ev.pe;
+        tev.type = ( uint32_t )ev.event.type();
+        tev.remote = ( uint32_t )ev.event.msg_remote();
+        tev.size = ( uint32_t )ev.event.msg_size();
+        tev.tag = ( uint32_t )ev.event.msg_tag();
+        tev.id = ( uint32_t )ev.event.func_id();
+        trace.events.push_back( tev );
+    }
     return 0;
 }
 
+int read_host_trace_file( FILE *fd, Trace &trace, uint64_t clock_hz )
+{
+    struct Ring
+    {
+        uint32_t pe;
+        uint32_t process;
+        uint64_t first;
+    };
+
+    char readbuf[128];
+    std::vector<Ring> rings;
+    // the events with the PE of the communication partner, which is resolved below
+    std::vector<Trace_Event> buf;
+
+    trace.clock_hz = clock_hz;
+
+    while( fgets( readbuf, sizeof( readbuf ), fd ) )
+    {
+        if( readbuf[0] == 'h' )
+        {
+            unsigned pe, pid;
+            char name[64] = "";
+            sscanf( readbuf + 2, "%u %u %63s", &pe, &pid, name );
+
+            Ring ring;
+            ring.pe = pe;
+            ring.process = ( uint32_t )trace.processes.size() + 1;
+            ring.first = UINT64_MAX;
+            rings.push_back( ring );
+
+            char procName[128];
+            snprintf( procName, sizeof( procName ), "%s (PE%u, pid %u)", name, pe, pid );
+            trace.processes.push_back( Trace_Process{ ring.process, procName } );
+            trace.mem_group.push_back( ring.process );
+            trace.msg_group.push_back( ring.process );
+        }
+        else
+        {
+            if( rings.empty() )
+            {
+                puts( "no ring defined\n" );
+                return 2;
+            }
+
+            uint64_t timestamp;
+            unsigned type, remote, size, payload;
+            if( sscanf( readbuf, "%" SCNx64 " %u %u %u %x", &timestamp, &type, &remote, &size, &payload ) != 5 )
+                continue;
+
+            Ring &ring = rings.back();
+            if( timestamp < ring.first ) ring.first = timestamp;
+
+            Trace_Event tev;
+            tev.timestamp = timestamp;
+            tev.process = ring.process;
+            tev.type = type;
+            tev.remote = remote;
+            tev.size = size;
+            tev.tag = payload;
+            tev.id = payload;
+            buf.push_back( tev );
+        }
+    }
+
+    // a PE runs multiple VPEs over time; the communication partner is the VPE that started last
+    // on the remote PE before the event
+    std::sort( rings.begin(), rings.end(), []( const Ring &a, const Ring &b ) {
+        return a.first < b.first;
+    } );
+    std::map<uint32_t, uint32_t> unknown_pes;
+    for( auto &ev : buf )
+    {
+        if( ev.type == EVENT_MSG_SEND || ev.type == EVENT_MSG_RECV ||
+            ev.type == EVENT_MEM_READ || ev.type == EVENT_MEM_WRITE )
+        {
+            uint32_t proc = 0;
+            for( auto &ring : rings )
+            {
+                if( ring.pe != ev.remote ) continue;
+                if( proc && ring.first > ev.timestamp ) break;
+                proc = ring.process;
+            }
+
+            // we have no trace of that PE (e.g., memory PEs)
+            if( !proc )
+            {
+                auto it = unknown_pes.find( ev.remote );
+                if( it == unknown_pes.end() )
+                {
+                    proc = ( uint32_t )trace.processes.size() + 1;
+                    char procName[16];
+                    snprintf( procName, sizeof( procName ), "PE%u", ev.remote );
+                    trace.processes.push_back( Trace_Process{ proc, procName } );
+                    trace.mem_group.push_back( proc );
+                    unknown_pes[ev.remote] = proc;
+                }
+                else
+                    proc = it->second;
+            }
+            ev.remote = proc;
+        }
+        trace.events.push_back( ev );
+    }
+    return 0;
+}
+
+int read_trace_file( char *path, Trace &trace, uint64_t clock_hz )
+{
+    char filename[256];
+    if( path )
+        strcpy( filename, path );
+    else
+        strcpy( filename, M3_TRACE_FILE_NAME );
+
+    printf( "reading trace file: %s\n", filename );
+
+    FILE *fd = fopen( filename, "r" );
+    if( !fd )
+    {
+        perror( "cannot open trace file" );
+        return 1;
+    }
+
+    // traces from host start with the header of a ring
+    int first = fgetc( fd );
+    ungetc( first, fd );
+
+    int res;
+    if( first == 'h' )
+        res = read_host_trace_file( fd, trace, clock_hz ? clock_hz : ( uint64_t )HOST_CLOCK_MHZ * 1000 * 1000 );
+    else
+    {
+        res = read_m3_trace_file( fd, trace );
+        if( clock_hz ) trace.clock_hz = clock_hz;
+    }
+
+    fclose( fd );
+    return res;
+}
+
 
 int main( int argc, char **argv )
 {
-    if(argc != 2) {
-        fprintf(stderr, "Usage: %s <file>\n", argv[0]);
+    uint64_t clock_hz = 0;
+    int argi = 1;
+    if( argc == 4 && strcmp( argv[1], "-f" ) == 0 )
+    {
+        clock_hz = strtoull( argv[2], NULL, 0 ) * 1000 * 1000;
+        argi = 3;
+    }
+    if( argi != argc - 1 ) {
+        fprintf(stderr, "Usage: %s [-f <clock in MHz>] <file>\n", argv[0]);
         return EXIT_FAILURE;
     }
 
-    std::vector<Event_Pe> trace_buf;
-
-    read_m3_trace_file( argv[1], trace_buf );
+    Trace trace;
+    if( read_trace_file( argv[argi], trace, clock_hz ) != 0 )
+        return EXIT_FAILURE;
 
+    std::vector<Trace_Event> &trace_buf = trace.events;
     unsigned int num_events = ( unsigned int )trace_buf.size();
 
     // now sort the trace buffer according to timestamps
     printf( "sorting %u events\n", num_events );
     struct
     {
-        bool operator()( const Event_Pe &a, const Event_Pe &b )
+        bool operator()( const Trace_Event &a, const Trace_Event &b )
         {
             return a.timestamp < b.timestamp;
         }
     } eventCmpOp;
-    std::sort( trace_buf.begin(), trace_buf.end(), eventCmpOp );
+    std::stable_sort( trace_buf.begin(), trace_buf.end(), eventCmpOp );
 
     // Declare a file manager and a writer.
     OTF_FileManager *manager;
@@ -161,30 +369,21 @@ int main( int argc, char **argv )
 
     // Write some important Definition Records.
     // Timer res. in ticks per second
-    OTF_Writer_writeDefTimerResolution( writer, 0, TH_CLOCK_MHZ * 1000 * 1000 );
+    OTF_Writer_writeDefTimerResolution( writer, 0, trace.clock_hz );
 
     // Processes.
     uint32_t stream = 1;
-    uint32_t pe1 = 4;
-    for( uint32_t i = 0; i < TH_NUM_PES; ++i )
+    for( auto &proc : trace.processes )
     {
-        char peName[8];
-        snprintf( peName, 5, "Pe%d", i + 1 );
-        OTF_Writer_writeDefProcess( writer, 0, pe1 + i, peName, 0 );
-        OTF_Writer_assignProcess( writer, pe1 + i, stream );
+        OTF_Writer_writeDefProcess( writer, 0, proc.id, proc.name.c_str(), 0 );
+        OTF_Writer_assignProcess( writer, proc.id, stream );
     }
-    uint32_t mem = 2;
-    OTF_Writer_writeDefProcess( writer, 0, mem, "Mem", 0 );
-    OTF_Writer_assignProcess( writer, mem, stream );
 
     // Process groups
-    uint32_t allPEs[TH_NUM_PES + 1];
-    for( uint32_t i = 0; i < TH_NUM_PES; ++i ) allPEs[i] = pe1 + i;
-    allPEs[TH_NUM_PES] = mem;
     unsigned grp_mem = ( 1 << 20 ) + 1;
-    OTF_Writer_writeDefProcessGroup( writer, 0, grp_mem, "Remote Memory Read/Write", TH_NUM_PES + 1, allPEs );
+    OTF_Writer_writeDefProcessGroup( writer, 0, grp_mem, "Remote Memory Read/Write", ( uint32_t )trace.mem_group.size(), trace.mem_group.data() );
     unsigned grp_msg = ( 1 << 20 ) + 2;
-    OTF_Writer_writeDefProcessGroup( writer, 0, grp_msg, "Remote Message Send/Receive", TH_NUM_PES, allPEs );
+    OTF_Writer_writeDefProcessGroup( writer, 0, grp_msg, "Remote Message Send/Receive", ( uint32_t )trace.msg_group.size(), trace.msg_group.data() );
 
 
     // Function groups
@@ -200,6 +399,8 @@ int main( int argc, char **argv )
     OTF_Writer_writeDefFunctionGroup( writer, 0, grp_func_mem, "Memory" );
     unsigned grp_func_user = grp_func_count++;
     OTF_Writer_writeDefFunctionGroup( writer, 0, grp_func_user, "User" );
+    unsigned grp_func_time = grp_func_count++;
+    OTF_Writer_writeDefFunctionGroup( writer, 0, grp_func_time, "Time" );
 
 
     // Memory Functions
@@ -213,10 +414,10 @@ int main( int argc, char **argv )
     unsigned processed_events = 0;
     unsigned num_send = 0, num_recv = 0, num_read = 0, num_write = 0, num_finish = 0;
     unsigned num_ufunc_enter = 0, num_ufunc_exit = 0, num_func_enter = 0, num_func_exit = 0;
+    unsigned num_time_start = 0, num_time_stop = 0;
     unsigned warnings = 0;
-    uint32_t max_timestamp = 0;
 
-    std::queue<Event_Pe> mem_event[TH_NUM_PES];
+    std::map<uint32_t, std::queue<Trace_Event>> mem_event;
 
     uint32_t ufunc_max_id = ( 3 << 20 );
     std::map<uint32_t, uint32_t> ufunc_map;
@@ -224,71 +425,73 @@ int main( int argc, char **argv )
     uint32_t func_start_id = ( 4 << 20 );
     std::set<uint32_t> func_set;
 
-    // function call stack per PE
-    std::array<uint, TH_NUM_PES> func_stack;
-    func_stack.fill( 0 );
-    std::array<uint, TH_NUM_PES> ufunc_stack;
-    ufunc_stack.fill( 0 );
+    uint32_t time_max_id = ( 6 << 20 );
+    std::map<uint32_t, uint32_t> time_map;
+
+    // function call stack per process
+    std::map<uint32_t, uint> func_stack;
+    std::map<uint32_t, uint> ufunc_stack;
+    std::map<uint32_t, uint> time_stack;
 
     printf( "writing OTF events\n" );
 
     // finally loop over events and write OTF
     for( unsigned i = 0; i < num_events; ++i )
     {
-        Event event = trace_buf[i].event;
-        uint64_t timestamp = trace_buf[i].timestamp;
-        unsigned int pe = trace_buf[i].pe;
+        const Trace_Event &event = trace_buf[i];
+        uint64_t timestamp = event.timestamp;
+        unsigned int pe = event.process;
 
-        switch( trace_buf[i].event.type() )
+        switch( event.type )
         {
             case EVENT_TIMESTAMP:
                 if( VERBOSE ) std::cout << pe << " EVENT_TIMESTAMP: " << timestamp << "\n";
                 // ignored, we already have absolute timestamps
                 break;
             case EVENT_MSG_SEND:
-                if( VERBOSE ) std::cout << pe << " EVENT_MSG_SEND: " << timestamp << "  receiver: " << event.msg_remote() << "  size: " << event.msg_size() << "  tag: " << event.msg_tag() << "\n";
-                OTF_Writer_writeSendMsg( writer, timestamp, pe, event.msg_remote(), grp_msg, event.msg_tag(), event.msg_size(), 0 );
+                if( VERBOSE ) std::cout << pe << " EVENT_MSG_SEND: " << timestamp << "  receiver: " << event.remote << "  size: " << event.size << "  tag: " << event.tag << "\n";
+                OTF_Writer_writeSendMsg( writer, timestamp, pe, event.remote, grp_msg, event.tag, event.size, 0 );
                 ++num_send;
                 break;
             case EVENT_MSG_RECV:
-                if( VERBOSE ) std::cout << pe << " EVENT_MSG_RECV: " << timestamp << "  sender: " << event.msg_remote() << "  size: " << event.msg_size() << "  tag: " << event.msg_tag() << "\n";
-                OTF_Writer_writeRecvMsg( writer, timestamp, pe, event.msg_remote(), grp_msg, event.msg_tag(), event.msg_size(), 0 );
+                if( VERBOSE ) std::cout << pe << " EVENT_MSG_RECV: " << timestamp << "  sender: " << event.remote << "  size: " << event.size << "  tag: " << event.tag << "\n";
+                OTF_Writer_writeRecvMsg( writer, timestamp, pe, event.remote, grp_msg, event.tag, event.size, 0 );
                 ++num_recv;
                 break;
             case EVENT_MEM_READ:
-                if( VERBOSE ) std::cout << pe << " EVENT_MEM_READ: " << timestamp << "  core: " << event.mem_remote() << "  size: " << event.mem_size() << "\n";
+                if( VERBOSE ) std::cout << pe << " EVENT_MEM_READ: " << timestamp << "  core: " << event.remote << "  size: " << event.size << "\n";
                 OTF_Writer_writeEnter( writer, timestamp, fn_mem_read, pe, 0 );
-                OTF_Writer_writeSendMsg( writer, timestamp, event.msg_remote(), pe, grp_mem, MEM_TAG, event.msg_size(), 0 );
-                mem_event[pe - pe1].push( trace_buf[i] );
+                OTF_Writer_writeSendMsg( writer, timestamp, event.remote, pe, grp_mem, MEM_TAG, event.size, 0 );
+                mem_event[pe].push( event );
                 ++num_read;
                 break;
             case EVENT_MEM_WRITE:
-                if( VERBOSE ) std::cout << pe << " EVENT_MEM_WRITE: " << timestamp << "  core: " << event.mem_remote() << "  size: " << event.mem_size() << "\n";
+                if( VERBOSE ) std::cout << pe << " EVENT_MEM_WRITE: " << timestamp << "  core: " << event.remote << "  size: " << event.size << "\n";
                 OTF_Writer_writeEnter( writer, timestamp, fn_mem_write, pe, 0 );
-                OTF_Writer_writeSendMsg( writer, timestamp, pe, event.msg_remote(), grp_mem, MEM_TAG, event.msg_size(), 0 );
-                mem_event[pe - pe1].push( trace_buf[i] );
+                OTF_Writer_writeSendMsg( writer, timestamp, pe, event.remote, grp_mem, MEM_TAG, event.size, 0 );
+                mem_event[pe].push( event );
                 ++num_write;
                 break;
             case EVENT_MEM_FINISH:
             {
-                Event_Pe me;
-                me.event.record = 0;
-                if( !mem_event[pe - pe1].empty() )
+                Trace_Event me;
+                me.type = 0;
+                if( !mem_event[pe].empty() )
                 {
-                    me = mem_event[pe - pe1].front();
-                    mem_event[pe - pe1].pop();
+                    me = mem_event[pe].front();
+                    mem_event[pe].pop();
                 }
-                if( me.event.type() == EVENT_MEM_READ )
+                if( me.type == EVENT_MEM_READ )
                 {
                     if( VERBOSE ) std::cout << pe << " EVENT_MEM_FINISH: " << timestamp << " (read) \n";
                     OTF_Writer_writeLeave( writer, timestamp, fn_mem_read, pe, 0 );
-                    OTF_Writer_writeRecvMsg( writer, timestamp, pe, me.event.msg_remote(), grp_mem, MEM_TAG, me.event.msg_size(), 0 );
+                    OTF_Writer_writeRecvMsg( writer, timestamp, pe, me.remote, grp_mem, MEM_TAG, me.size, 0 );
                 }
-                else if( me.event.type() == EVENT_MEM_WRITE )
+                else if( me.type == EVENT_MEM_WRITE )
                 {
                     if( VERBOSE ) std::cout << pe << " EVENT_MEM_FINISH: " << timestamp << " (write) \n";
                     OTF_Writer_writeLeave( writer, timestamp, fn_mem_write, pe, 0 );
-                    OTF_Writer_writeRecvMsg( writer, timestamp, me.event.msg_remote(), pe, grp_mem, MEM_TAG, me.event.msg_size(), 0 );
+                    OTF_Writer_writeRecvMsg( writer, timestamp, me.remote, pe, grp_mem, MEM_TAG, me.size, 0 );
                 }
                 else
                 {
@@ -300,20 +503,20 @@ int main( int argc, char **argv )
             break;
             case EVENT_UFUNC_ENTER:
             {
-                if( VERBOSE ) std::cout << pe << " EVENT_UFUNC_ENTER: " << timestamp << "  name: " << event.func_id() << "  " << event.ufunc_name_str() << "\n";
-                std::map<uint32_t, uint32_t>::iterator ufunc_map_iter = ufunc_map.find( event.func_id() );
+                if( VERBOSE ) std::cout << pe << " EVENT_UFUNC_ENTER: " << timestamp << "  name: " << event.id << "  " << ufunc_name( event.id ) << "\n";
+                std::map<uint32_t, uint32_t>::iterator ufunc_map_iter = ufunc_map.find( event.id );
                 uint32_t id = 0;
                 if( ufunc_map_iter == ufunc_map.end() )
                 {
                     id = ( ++ufunc_max_id );
-                    ufunc_map.insert( std::pair<uint32_t, uint32_t>( event.func_id(), id ) );
-                    OTF_Writer_writeDefFunction( writer, 0, id, event.ufunc_name_str(), grp_func_user, 0 );
+                    ufunc_map.insert( std::pair<uint32_t, uint32_t>( event.id, id ) );
+                    OTF_Writer_writeDefFunction( writer, 0, id, ufunc_name( event.id ), grp_func_user, 0 );
                 }
                 else
                 {
                     id = ufunc_map_iter->second;
                 }
-                ++( ufunc_stack[pe - pe1] );
+                ++( ufunc_stack[pe] );
                 OTF_Writer_writeEnter( writer, timestamp, id, pe, 0 );
                 ++num_ufunc_enter;
             }
@@ -321,14 +524,14 @@ int main( int argc, char **argv )
             case EVENT_UFUNC_EXIT:
             {
                 if( VERBOSE ) std::cout << pe << " EVENT_UFUNC_EXIT: " << timestamp << "\n";
-                if( ufunc_stack[pe - pe1] < 1 )
+                if( ufunc_stack[pe] < 1 )
                 {
-                    std::cout << pe << " WARNING: exit at ufunc stack level " << ufunc_stack[pe - pe1] << " dropped.\n";
+                    std::cout << pe << " WARNING: exit at ufunc stack level " << ufunc_stack[pe] << " dropped.\n";
                     ++warnings;
                 }
                 else
                 {
-                    --( ufunc_stack[pe - pe1] );
+                    --( ufunc_stack[pe] );
                     OTF_Writer_writeLeave( writer, timestamp, 0, pe, 0 );
                 }
                 ++num_ufunc_exit;
@@ -336,15 +539,25 @@ int main( int argc, char **argv )
             break;
             case EVENT_FUNC_ENTER:
             {
-                if( VERBOSE ) std::cout << pe << " EVENT_FUNC_ENTER: " << timestamp << "  name: " << event.func_id() << "  " << event_funcs[event.func_id()].name << "\n";
-                uint32_t id = event.func_id();
+                uint32_t id = event.id;
+                if( id >= sizeof( event_funcs ) / sizeof( event_funcs[0] ) )
+                {
+                    std::cout << pe << " WARNING: unknown function id " << id << " dropped.\n";
+                    ++warnings;
+                    // count it nevertheless to drop the corresponding exit
+                    ++( func_stack[pe] );
+                    OTF_Writer_writeEnter( writer, timestamp, func_start_id, pe, 0 );
+                    ++num_func_enter;
+                    break;
+                }
+                if( VERBOSE ) std::cout << pe << " EVENT_FUNC_ENTER: " << timestamp << "  name: " << id << "  " << event_funcs[id].name << "\n";
                 if( func_set.find( id ) == func_set.end() )
                 {
                     func_set.insert( id );
                     unsigned group = grp_func_start + event_funcs[id].group;
                     OTF_Writer_writeDefFunction( writer, 0, func_start_id + id, event_funcs[id].name, group , 0 );
                 }
-                ++( func_stack[pe - pe1] );
+                ++( func_stack[pe] );
                 OTF_Writer_writeEnter( writer, timestamp, func_start_id + id, pe, 0 );
                 ++num_func_enter;
             }
@@ -352,29 +565,62 @@ int main( int argc, char **argv )
             case EVENT_FUNC_EXIT:
             {
                 if( VERBOSE ) std::cout << pe << " EVENT_FUNC_EXIT: " << timestamp << "\n";
-                if( func_stack[pe - pe1] < 1 )
+                if( func_stack[pe] < 1 )
                 {
-                    std::cout << pe << " WARNING: exit at func stack level " << func_stack[pe - pe1] << " dropped.\n";
+                    std::cout << pe << " WARNING: exit at func stack level " << func_stack[pe] << " dropped.\n";
                     ++warnings;
                 }
                 else
                 {
-                    --( func_stack[pe - pe1] );
+                    --( func_stack[pe] );
                     OTF_Writer_writeLeave( writer, timestamp, 0, pe, 0 );
                 }
                 ++num_func_exit;
             }
             break;
+            case EVENT_TIME_START:
+            {
+                if( VERBOSE ) std::cout << pe << " EVENT_TIME_START: " << timestamp << "  id: " << event.id << "\n";
+                std::map<uint32_t, uint32_t>::iterator time_map_iter = time_map.find( event.id );
+                uint32_t id = 0;
+                if( time_map_iter == time_map.end() )
+                {
+                    char name[32];
+                    snprintf( name, sizeof( name ), "time_%#x", event.id );
+                    id = ( ++time_max_id );
+                    time_map.insert( std::pair<uint32_t, uint32_t>( event.id, id ) );
+                    OTF_Writer_writeDefFunction( writer, 0, id, name, grp_func_time, 0 );
+                }
+                else
+                {
+                    id = time_map_iter->second;
+                }
+                ++( time_stack[pe] );
+                OTF_Writer_writeEnter( writer, timestamp, id, pe, 0 );
+                ++num_time_start;
+            }
+            break;
+            case EVENT_TIME_STOP:
+            {
+                if( VERBOSE ) std::cout << pe << " EVENT_TIME_STOP: " << timestamp << "  id: " << event.id << "\n";
+                if( time_stack[pe] < 1 )
+                {
+                    std::cout << pe << " WARNING: stop at time stack level " << time_stack[pe] << " dropped.\n";
+                    ++warnings;
+                }
+                else
+                {
+                    --( time_stack[pe] );
+                    OTF_Writer_writeLeave( writer, timestamp, 0, pe, 0 );
+                }
+                ++num_time_stop;
+            }
+            break;
             default:
-                printf( "WARNING: UNKOWN EVENT TYPE %lu at %d\n", ( long unsigned int )( trace_buf[i].event.type() ), i );
+                printf( "WARNING: UNKOWN EVENT TYPE %u at %d\n", event.type, i );
                 ++warnings;
         }
 
-        if( trace_buf[i].event.type() != EVENT_TIMESTAMP )
-        {
-            if( max_timestamp < event.timestamp() ) max_timestamp = event.timestamp();
-        }
-
         ++processed_events;
     }
 
@@ -398,6 +644,11 @@ int main( int argc, char **argv )
         printf( "WARNING: num_ufunc_enter != num_ufunc_exit\n" );
         ++warnings;
     }
+    if( num_time_start != num_time_stop )
+    {
+        printf( "WARNING: num_time_start != num_time_stop\n" );
+        ++warnings;
+    }
 
     printf( "processed events: %u\n", processed_events );
     printf( "warnings: %u\n", warnings );
@@ -410,7 +661,8 @@ int main( int argc, char **argv )
     printf( "num_func_exit: %u\n", num_func_exit );
     printf( "num_ufunc_enter: %u\n", num_ufunc_enter );
     printf( "num_ufunc_exit: %u\n", num_ufunc_exit );
-    printf( "max_timestamp delta: %u / %lu  %.1fx\n", max_timestamp, REC_MASK_TIMESTAMP, ( float )REC_MASK_TIMESTAMP / ( float )max_timestamp );
+    printf( "num_time_start: %u\n", num_time_start );
+    printf( "num_time_stop: %u\n", num_time_stop );
 
 
     // Clean up before exiting the program.
@@ -197,6 +197,7 @@ static m3::inodeno_t copy(const char *path, m3::inodeno_t parent, int level) {
         errx(1, "Not enough inodes");
 
     m3::INode ino;
+    memset(&ino, 0, sizeof(ino));
     ino.devno = 0;
     ino.inode = next_ino++;
     // TODO don't copy the number of links
@@ -214,7 +215,15 @@ static m3::inodeno_t copy(const char *path, m3::inodeno_t parent, int level) {
     inode_bitmap->set(ino.inode);
     sb.free_inodes--;
 
-    if(S_ISREG(ino.mode)) {
+    if(S_ISREG(ino.mode) && st.st_size <= m3::INODE_INLINE_SIZE) {
+        // small files are stored within the inode
+        ino.flags = m3::INODE_INLINE;
+        if(read(fd, ino.inline_data(), static_cast<size_t>(st.st_size)) != st.st_size)
+            err(1, "read of '%s' failed", path);
+        PRINT("Storing %s inline\n", path);
+        ino.size = static_cast<uint64_t>(st.st_size);
+    }
+    else if(S_ISREG(ino.mode)) {
         ssize_t len;
         for(size_t i = 0; (len = read(fd, buffer, sb.blocksize)) > 0; i++) {
             bool new_ext = blks_per_extent > 0 && (i % blks_per_extent) == 0;
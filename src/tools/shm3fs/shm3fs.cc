@@ -99,9 +99,14 @@ static void print_inode(m3::inodeno_t ino, bool all) {
     printf("  inode: %u\n", inode.inode);
     printf("  mode: %#04o\n", inode.mode);
     printf("  links: %u\n", inode.links);
+    printf("  flags: %#x\n", inode.flags);
     printf("  size: %" PRIu64 "\n", inode.size);
     print_time(inode.lastaccess, "lastaccess");
     print_time(inode.lastmod, "lastmod");
+    if(is_inline(inode)) {
+        printf("  inline data: %" PRIu64 " bytes\n", inode.size);
+        return;
+    }
     printf("  extents: %u\n", inode.extents);
     for(int i = 0; i < m3::INODE_DIR_COUNT; ++i) {
         printf("  direct[%d]: %4u .. %4u (%u)\n", i, inode.direct[i].start,
@@ -190,6 +195,13 @@ static void print_block_text(m3::blockno_t block, size_t count) {
 static void print_ino_bytes(m3::inodeno_t ino) {
     printf("Printing bytes of inode %d:\n", ino);
     m3::INode inode = read_inode(ino);
+    if(is_inline(inode)) {
+        for(size_t i = 0; i < inode.size; ++i)
+            printf("%02x%c", static_cast<uint8_t>(inode.inline_data()[i]), (i % 16) == 15 ? '\n' : ' ');
+        putchar('\n');
+        return;
+    }
+
     size_t blockcount = (inode.size + sb.blocksize - 1) / sb.blocksize;
     for(uint32_t i = 0; i < blockcount; ++i)
         print_block_bytes(i * sb.blocksize, get_block_no(inode, i));
@@ -197,6 +209,13 @@ static void print_ino_bytes(m3::inodeno_t ino) {
 
 static void print_ino_text(m3::inodeno_t ino) {
     m3::INode inode = read_inode(ino);
+    if(is_inline(inode)) {
+        for(size_t i = 0; i < inode.size; ++i)
+            putchar(inode.inline_data()[i]);
+        putchar('\n');
+        return;
+    }
+
     size_t blockcount = (inode.size + sb.blocksize - 1) / sb.blocksize;
     size_t count = 0;
     for(uint32_t i = 0; i < blockcount; ++i) {